@@ -0,0 +1,220 @@
+-- packs base/ into base.pack, see source/qcommon/pack.h for the format
+-- usage: lua pack_assets.lua base release/base.pack
+-- needs the zstd command line tool
+
+local PACK_MAGIC = 0x4b505346
+local PACK_VERSION = 1
+local PACK_PAGE_SIZE = 4096
+local PackedFileFlag_Compressed = 1
+
+-- files that are already compressed, or compress so badly it's not worth it
+local stored_extensions = {
+	bsp = true,
+	jpg = true,
+	ogg = true,
+	png = true,
+}
+
+local max_dict_sample_size = 128 * 1024
+
+local src_dir = assert( arg[ 1 ], "usage: pack_assets.lua base base.pack" )
+local dst_path = assert( arg[ 2 ], "usage: pack_assets.lua base base.pack" )
+
+local windows = package.config:sub( 1, 1 ) == "\\"
+
+local function exec( cmd )
+	local ok = os.execute( cmd )
+	if not ok then
+		error( "command failed: " .. cmd )
+	end
+end
+
+local function read_file( path )
+	local f = assert( io.open( path, "rb" ) )
+	local contents = f:read( "a" )
+	f:close()
+	return contents
+end
+
+local function write_file( path, contents )
+	local f = assert( io.open( path, "wb" ) )
+	f:write( contents )
+	assert( f:close() )
+end
+
+-- same as Hash64 in source/qcommon/hash.cpp, including chars being signed
+local function hash64( str )
+	local hash = -3750763034362895579 -- 14695981039346656037
+	for i = 1, #str do
+		local c = str:byte( i )
+		if c >= 128 then
+			c = c - 256
+		end
+		hash = ( hash ~ c ) * 1099511628211
+	end
+	return hash
+end
+
+local function align( x, alignment )
+	return ( x + alignment - 1 ) // alignment * alignment
+end
+
+local function list_files( dir )
+	local cmd
+	if windows then
+		cmd = "dir /s /b /a-d \"" .. dir .. "\""
+	else
+		cmd = "find \"" .. dir .. "\" -type f"
+	end
+
+	local files = { }
+	local pipe = assert( io.popen( cmd ) )
+	for line in pipe:lines() do
+		local path = line:gsub( "\\", "/" )
+		local name = path:sub( #dir + 2 )
+		-- skip .git etc, same as LoadAssetsRecursive, and the pmovetest
+		-- recordings, which are only for developers
+		if not ( "/" .. name ):find( "/%." ) and not name:find( "^pmovetest/" ) then
+			table.insert( files, { path = path, name = name } )
+		end
+	end
+	pipe:close()
+
+	table.sort( files, function( a, b ) return a.name < b.name end )
+
+	return files
+end
+
+local files = list_files( src_dir:gsub( "\\", "/" ):gsub( "/$", "" ) )
+local tmp = os.tmpname()
+local dict_path = tmp .. ".dict"
+local samples_path = tmp .. ".samples"
+local compressed_path = tmp .. ".zst"
+
+-- train a dictionary on the small compressible files
+local samples = { }
+local samples_size = 0
+for _, file in ipairs( files ) do
+	file.contents = read_file( file.path )
+
+	local ext = file.name:match( "%.([^./]+)$" )
+	file.store = ( ext and stored_extensions[ ext:lower() ] ) or file.contents:sub( 1, 4 ) == "\x28\xb5\x2f\xfd"
+
+	if not file.store and #file.contents > 0 and #file.contents <= max_dict_sample_size then
+		table.insert( samples, file.path )
+		samples_size = samples_size + #file.contents
+	end
+end
+
+local dict = ""
+if #samples >= 8 then
+	-- zstd wants at least 10x as much training data as dictionary
+	local max_dict_size = math.max( 1024, math.min( 112640, samples_size // 20 ) )
+	write_file( samples_path, table.concat( samples, "\n" ) .. "\n" )
+	if os.execute( "zstd -q -f --train --maxdict=" .. max_dict_size .. " --filelist \"" .. samples_path .. "\" -o \"" .. dict_path .. "\"" ) then
+		dict = read_file( dict_path )
+	end
+end
+
+local dict_arg = dict == "" and "" or ( " -D \"" .. dict_path .. "\"" )
+
+local stored_bytes = 0
+
+for _, file in ipairs( files ) do
+	file.data = file.contents
+	file.flags = 0
+
+	if not file.store and #file.contents > 0 then
+		exec( "zstd -q -f -19" .. dict_arg .. " \"" .. file.path .. "\" -o \"" .. compressed_path .. "\"" )
+		local compressed = read_file( compressed_path )
+		if #compressed < #file.contents * 0.9 then
+			file.data = compressed
+			file.flags = PackedFileFlag_Compressed
+		end
+	end
+
+	stored_bytes = stored_bytes + #file.contents
+end
+
+os.remove( tmp )
+os.remove( dict_path )
+os.remove( samples_path )
+os.remove( compressed_path )
+
+-- index
+local index_capacity = 1
+while index_capacity < #files * 2 do
+	index_capacity = index_capacity * 2
+end
+
+local index = { }
+for i = 1, index_capacity do
+	index[ i ] = 0
+end
+
+local names = { }
+local names_size = 0
+for i, file in ipairs( files ) do
+	file.hash = hash64( file.name )
+
+	local slot = file.hash & ( index_capacity - 1 )
+	while index[ slot + 1 ] ~= 0 do
+		if files[ index[ slot + 1 ] ].hash == file.hash then
+			error( "hash collision: " .. file.name .. " and " .. files[ index[ slot + 1 ] ].name )
+		end
+		slot = ( slot + 1 ) & ( index_capacity - 1 )
+	end
+	index[ slot + 1 ] = i
+
+	file.name_offset = names_size
+	table.insert( names, file.name .. "\0" )
+	names_size = names_size + #file.name + 1
+end
+
+-- layout
+local header_size = 64
+local packed_file_size = 40
+
+local files_offset = header_size
+local index_offset = files_offset + #files * packed_file_size
+local names_offset = index_offset + index_capacity * 4
+local dict_offset = names_offset + names_size
+local cursor = align( dict_offset + #dict, PACK_PAGE_SIZE )
+
+for _, file in ipairs( files ) do
+	local alignment = file.flags == 0 and PACK_PAGE_SIZE or 16
+	file.offset = align( cursor, alignment )
+	-- + 1 for the trailing '\0'
+	cursor = file.offset + #file.data + 1
+end
+
+-- write
+local out = { }
+
+table.insert( out, string.pack( "<I4I4I4I4I8I8I8I8I8I8",
+	PACK_MAGIC, PACK_VERSION, #files, index_capacity,
+	files_offset, index_offset, names_offset, names_size, dict_offset, #dict ) )
+
+for _, file in ipairs( files ) do
+	table.insert( out, string.pack( "<i8I8I8I8I4I4", file.hash, file.offset, #file.data, #file.contents, file.name_offset, file.flags ) )
+end
+
+for i = 1, index_capacity do
+	table.insert( out, string.pack( "<I4", index[ i ] ) )
+end
+
+table.insert( out, table.concat( names ) )
+table.insert( out, dict )
+
+local size = dict_offset + #dict
+for _, file in ipairs( files ) do
+	table.insert( out, string.rep( "\0", file.offset - size ) )
+	table.insert( out, file.data )
+	table.insert( out, "\0" )
+	size = file.offset + #file.data + 1
+end
+
+write_file( dst_path, table.concat( out ) )
+
+print( string.format( "%s: %d files, %d bytes of dictionary, %.1f MB -> %.1f MB",
+	dst_path, #files, #dict, stored_bytes / 1e6, size / 1e6 ) )
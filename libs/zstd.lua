@@ -1,3 +1,3 @@
-lib( "zstd", { "libs/zstd/zstddeclib.cpp" } )
-msvc_obj_cxxflags( "libs/zstd/zstddeclib.cpp", "/O2" )
-gcc_obj_cxxflags( "libs/zstd/zstddeclib.cpp", "-O2 -Wno-ignored-qualifiers" )
+lib( "zstd", { "libs/zstd/zstdlib.cpp" } )
+msvc_obj_cxxflags( "libs/zstd/zstdlib.cpp", "/O2" )
+gcc_obj_cxxflags( "libs/zstd/zstdlib.cpp", "-O2 -Wno-ignored-qualifiers" )
@@ -874,7 +874,8 @@ static bool CG_DemoCam_LookAt( int trackEnt, Vec3 vieworg, Vec3 * viewangles ) {
 	Vec3 origin = Lerp( cent->prev.origin, cg.lerpfrac, cent->current.origin );
 
 	// if having a bounding box, look to its center
-	struct cmodel_s *cmodel = CG_CModelForEntity( trackEnt );
+	BoxHull hull;
+	struct cmodel_s *cmodel = CG_CModelForEntity( trackEnt, &hull );
 	if( cmodel != NULL ) {
 		Vec3 mins, maxs;
 		CM_InlineModelBounds( cl.cms, cmodel, &mins, &maxs );
@@ -1158,13 +1159,14 @@ static int CG_Democam_CalcView( void ) {
 				} else {
 					Vec3 center, forward;
 					struct cmodel_s *cmodel;
+					BoxHull hull;
 					const float ft = (float)cls.frametime * 0.001f;
 
 					// find the trackEnt origin
 					center = Lerp( cg_entities[currentcam->trackEnt].prev.origin, cg.lerpfrac, cg_entities[currentcam->trackEnt].current.origin );
 
 					// if having a bounding box, look to its center
-					if( ( cmodel = CG_CModelForEntity( currentcam->trackEnt ) ) != NULL ) {
+					if( ( cmodel = CG_CModelForEntity( currentcam->trackEnt, &hull ) ) != NULL ) {
 						Vec3 mins, maxs;
 						CM_InlineModelBounds( cl.cms, cmodel, &mins, &maxs );
 						center += mins + maxs;
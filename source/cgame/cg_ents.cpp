@@ -322,7 +322,7 @@ bool CG_NewFrameSnap( snapshot_t *frame, snapshot_t *lerpframe ) {
 	CG_UpdateEntities();
 	CG_CheckPredictionError();
 
-	cg.predictFrom = 0; // force the prediction to be restarted from the new snapshot
+	CG_CheckPredictionCache();
 	cg.fireEvents = true;
 
 	for( int i = 0; i < cg.frame.numgamecommands; i++ ) {
@@ -354,7 +354,7 @@ ADD INTERPOLATED ENTITIES TO RENDERING LIST
 * CG_CModelForEntity
 *  get the collision model for the given entity, no matter if box or brush-model.
 */
-struct cmodel_s *CG_CModelForEntity( int entNum ) {
+struct cmodel_s *CG_CModelForEntity( int entNum, BoxHull * hull ) {
 	struct cmodel_s *cmodel = NULL;
 
 	if( entNum < 0 || entNum >= MAX_EDICTS ) {
@@ -379,9 +379,9 @@ struct cmodel_s *CG_CModelForEntity( int entNum ) {
 		Vec3 bmins = Vec3( -x, -x, -zd );
 		Vec3 bmaxs = Vec3( x, x, zu );
 		if( cent->type == ET_PLAYER || cent->type == ET_CORPSE ) {
-			cmodel = CM_OctagonModelForBBox( cl.cms, bmins, bmaxs );
+			cmodel = CM_OctagonModelForBBox( hull, bmins, bmaxs );
 		} else {
-			cmodel = CM_ModelForBBox( cl.cms, bmins, bmaxs );
+			cmodel = CM_ModelForBBox( hull, bmins, bmaxs );
 		}
 	}
 
@@ -334,11 +334,6 @@ typedef struct {
 	SyncPlayerState predictedPlayerState;     // current in use, predicted or interpolated
 	int predictedGroundEntity;
 
-	// prediction optimization (don't run all ucmds in not needed)
-	int64_t predictFrom;
-	SyncEntityState predictFromEntityState;
-	SyncPlayerState predictFromPlayerState;
-
 	float lerpfrac;                     // between oldframe and frame
 	float xerpTime;
 	float oldXerpTime;
@@ -402,7 +397,7 @@ extern centity_t cg_entities[MAX_EDICTS];
 // cg_ents.c
 //
 bool CG_NewFrameSnap( snapshot_t *frame, snapshot_t *lerpframe );
-struct cmodel_s *CG_CModelForEntity( int entNum );
+struct cmodel_s *CG_CModelForEntity( int entNum, struct BoxHull * hull );
 void CG_SoundEntityNewState( centity_t *cent );
 void CG_AddEntities( void );
 void CG_GetEntitySpatilization( int entNum, Vec3 * origin, Vec3 * velocity );
@@ -446,6 +441,8 @@ void CG_PredictedFireWeapon( int entNum, WeaponType weapon );
 void CG_PredictMovement( void );
 void CG_CheckPredictionError( void );
 void CG_BuildSolidList( void );
+void CG_CheckPredictionCache();
+void CG_ClearPredictionCache();
 void CG_Trace( trace_t *t, Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, int ignore, int contentmask );
 int CG_PointContents( Vec3 point );
 void CG_Predict_TouchTriggers( pmove_t *pm, Vec3 previous_origin );
@@ -254,7 +254,7 @@ void CG_Reset( void ) {
 	chaseCam.key_pressed = false;
 
 	// reset prediction optimization
-	cg.predictFrom = 0;
+	CG_ClearPredictionCache();
 
 	memset( cg_entities, 0, sizeof( cg_entities ) );
 }
@@ -1,11 +1,17 @@
+#include "qcommon/array.h"
 #include "qcommon/fs.h"
 #include "qcommon/serialization.h"
+#include "qcommon/threadpool.h"
 #include "client/assets.h"
 #include "client/renderer/renderer.h"
 #include "cgame/cg_local.h"
 
 #include "imgui/imgui.h"
 
+#include <emmintrin.h>
+
+static void ParticleBench_f();
+
 void InitParticles() {
 	constexpr Vec3 gravity = Vec3( 0, 0, -GRAVITY );
 
@@ -15,9 +21,13 @@ void InitParticles() {
 	cgs.sparks = NewParticleSystem( sys_allocator, 8192, FindMaterial( "$particle" ) );
 	cgs.sparks.acceleration = gravity;
 	cgs.sparks.blend_func = BlendFunc_Blend;
+
+	Cmd_AddCommand( "particlebench", ParticleBench_f );
 }
 
 void ShutdownParticles() {
+	Cmd_RemoveCommand( "particlebench" );
+
 	DeleteParticleSystem( sys_allocator, cgs.ions );
 	DeleteParticleSystem( sys_allocator, cgs.bullet_sparks );
 	DeleteParticleSystem( sys_allocator, cgs.sparks );
@@ -33,7 +43,6 @@ ParticleSystem NewParticleSystem( Allocator * a, size_t n, const Material * mate
 	ps.gradient = cgs.white_material;
 
 	ps.vb = NewParticleVertexBuffer( n );
-	ps.vb_memory = ALLOC_MANY( a, GPUParticle, n );
 
 	{
 		constexpr Vec2 verts[] = {
@@ -69,7 +78,6 @@ ParticleSystem NewParticleSystem( Allocator * a, size_t n, const Material * mate
 
 void DeleteParticleSystem( Allocator * a, ParticleSystem ps ) {
 	FREE( a, ps.chunks.ptr );
-	FREE( a, ps.vb_memory );
 	DeleteVertexBuffer( ps.vb );
 	DeleteMesh( ps.mesh );
 }
@@ -78,6 +86,7 @@ static float EvaluateEasingDerivative( EasingFunction func, float t ) {
 	switch( func ) {
 		case EasingFunction_Linear: return 1.0f;
 		case EasingFunction_Quadratic: return t < 0.5f ? 4.0f * t : -4.0f * t + 4.0f;
+		case EasingFunction_Cubic: return t < 0.5f ? 12.0f * t * t : 12.0f * ( 1.0f - t ) * ( 1.0f - t );
 		case EasingFunction_QuadraticEaseIn: return 2.0f * t;
 		case EasingFunction_QuadraticEaseOut: return -2.0f * t + 2.0f;
 	}
@@ -85,7 +94,7 @@ static float EvaluateEasingDerivative( EasingFunction func, float t ) {
 	return 0.0f;
 }
 
-static void UpdateParticleChunk( const ParticleSystem * ps, ParticleChunk * chunk, Vec3 acceleration, float dt ) {
+static void UpdateParticleChunkScalar( const ParticleSystem * ps, ParticleChunk * chunk, Vec3 acceleration, float dt ) {
 	DisableFPEScoped;
 
 	for( int i = 0; i < 4; i++ ) {
@@ -117,17 +126,12 @@ static void UpdateParticleChunk( const ParticleSystem * ps, ParticleChunk * chun
 	}
 }
 
-void UpdateParticleSystem( ParticleSystem * ps, float dt ) {
-	{
-		ZoneScopedN( "Update particles" );
-		size_t active_chunks = AlignPow2( ps->num_particles, size_t( 4 ) ) / 4;
-		for( size_t i = 0; i < active_chunks; i++ ) {
-			UpdateParticleChunk( ps, &ps->chunks[ i ], ps->acceleration, dt );
-		}
+static void UpdateParticleSystemScalar( ParticleSystem * ps, float dt ) {
+	size_t active_chunks = AlignPow2( ps->num_particles, size_t( 4 ) ) / 4;
+	for( size_t i = 0; i < active_chunks; i++ ) {
+		UpdateParticleChunkScalar( ps, &ps->chunks[ i ], ps->acceleration, dt );
 	}
 
-	ZoneScopedN( "Delete expired particles" );
-
 	// delete expired particles
 	for( size_t i = 0; i < ps->num_particles; i++ ) {
 		ParticleChunk & chunk = ps->chunks[ i / 4 ];
@@ -169,39 +173,408 @@ void UpdateParticleSystem( ParticleSystem * ps, float dt ) {
 	}
 }
 
-void DrawParticleSystem( ParticleSystem * ps ) {
+/*
+ * The scalar versions above are kept as a reference for particlebench. The
+ * SSE versions below update a whole chunk at once, and fill the holes left by
+ * dead particles a chunk at a time instead of a field at a time.
+ */
+
+static __m128 EvaluateEasingDerivative( EasingFunction func, __m128 t ) {
+	switch( func ) {
+		case EasingFunction_Linear: return _mm_set1_ps( 1.0f );
+		case EasingFunction_Quadratic: {
+			__m128 rising = _mm_mul_ps( _mm_set1_ps( 4.0f ), t );
+			__m128 falling = _mm_sub_ps( _mm_set1_ps( 4.0f ), rising );
+			__m128 first_half = _mm_cmplt_ps( t, _mm_set1_ps( 0.5f ) );
+			return _mm_or_ps( _mm_and_ps( first_half, rising ), _mm_andnot_ps( first_half, falling ) );
+		}
+		case EasingFunction_Cubic: {
+			__m128 one_minus_t = _mm_sub_ps( _mm_set1_ps( 1.0f ), t );
+			__m128 rising = _mm_mul_ps( _mm_set1_ps( 12.0f ), _mm_mul_ps( t, t ) );
+			__m128 falling = _mm_mul_ps( _mm_set1_ps( 12.0f ), _mm_mul_ps( one_minus_t, one_minus_t ) );
+			__m128 first_half = _mm_cmplt_ps( t, _mm_set1_ps( 0.5f ) );
+			return _mm_or_ps( _mm_and_ps( first_half, rising ), _mm_andnot_ps( first_half, falling ) );
+		}
+		case EasingFunction_QuadraticEaseIn: return _mm_mul_ps( _mm_set1_ps( 2.0f ), t );
+		case EasingFunction_QuadraticEaseOut: return _mm_sub_ps( _mm_set1_ps( 2.0f ), _mm_mul_ps( _mm_set1_ps( 2.0f ), t ) );
+	}
+
+	return _mm_setzero_ps();
+}
+
+static __m128 MulAdd( __m128 a, __m128 b, __m128 c ) {
+	return _mm_add_ps( _mm_mul_ps( a, b ), c );
+}
+
+static void UpdateParticleChunk( const ParticleSystem * ps, ParticleChunk * chunk, Vec3 acceleration, float dt ) {
 	DisableFPEScoped;
 
-	if( ps->num_particles == 0 )
-		return;
+	__m128 dt4 = _mm_set1_ps( dt );
+	__m128 min_speed = _mm_set1_ps( 0.0001f );
+
+	__m128 t = _mm_add_ps( _mm_load_ps( chunk->t ), dt4 );
+	_mm_store_ps( chunk->t, t );
+	__m128 frac = _mm_div_ps( t, _mm_load_ps( chunk->lifetime ) );
+
+	__m128 velocity_x = _mm_add_ps( _mm_load_ps( chunk->velocity_x ), _mm_set1_ps( acceleration.x * dt ) );
+	__m128 velocity_y = _mm_add_ps( _mm_load_ps( chunk->velocity_y ), _mm_set1_ps( acceleration.y * dt ) );
+	__m128 velocity_z = _mm_add_ps( _mm_load_ps( chunk->velocity_z ), _mm_set1_ps( acceleration.z * dt ) );
+
+	__m128 speed_squared = MulAdd( velocity_x, velocity_x, MulAdd( velocity_y, velocity_y, _mm_mul_ps( velocity_z, velocity_z ) ) );
+	__m128 speed = _mm_max_ps( min_speed, _mm_sqrt_ps( speed_squared ) );
+	__m128 new_speed = _mm_max_ps( min_speed, MulAdd( _mm_load_ps( chunk->dvelocity ), dt4, speed ) );
+	__m128 velocity_scale = _mm_div_ps( new_speed, speed );
+
+	velocity_x = _mm_mul_ps( velocity_x, velocity_scale );
+	velocity_y = _mm_mul_ps( velocity_y, velocity_scale );
+	velocity_z = _mm_mul_ps( velocity_z, velocity_scale );
+	_mm_store_ps( chunk->velocity_x, velocity_x );
+	_mm_store_ps( chunk->velocity_y, velocity_y );
+	_mm_store_ps( chunk->velocity_z, velocity_z );
+
+	_mm_store_ps( chunk->position_x, MulAdd( velocity_x, dt4, _mm_load_ps( chunk->position_x ) ) );
+	_mm_store_ps( chunk->position_y, MulAdd( velocity_y, dt4, _mm_load_ps( chunk->position_y ) ) );
+	_mm_store_ps( chunk->position_z, MulAdd( velocity_z, dt4, _mm_load_ps( chunk->position_z ) ) );
+
+	__m128 color_step = _mm_mul_ps( EvaluateEasingDerivative( ps->color_easing, frac ), dt4 );
+	_mm_store_ps( chunk->color_r, MulAdd( color_step, _mm_load_ps( chunk->dcolor_r ), _mm_load_ps( chunk->color_r ) ) );
+	_mm_store_ps( chunk->color_g, MulAdd( color_step, _mm_load_ps( chunk->dcolor_g ), _mm_load_ps( chunk->color_g ) ) );
+	_mm_store_ps( chunk->color_b, MulAdd( color_step, _mm_load_ps( chunk->dcolor_b ), _mm_load_ps( chunk->color_b ) ) );
+	_mm_store_ps( chunk->color_a, MulAdd( color_step, _mm_load_ps( chunk->dcolor_a ), _mm_load_ps( chunk->color_a ) ) );
+
+	__m128 size_step = _mm_mul_ps( EvaluateEasingDerivative( ps->size_easing, frac ), dt4 );
+	_mm_store_ps( chunk->size, MulAdd( size_step, _mm_load_ps( chunk->dsize ), _mm_load_ps( chunk->size ) ) );
+}
 
-	ZoneScoped;
+constexpr size_t PARTICLE_CHUNK_FIELDS = sizeof( ParticleChunk ) / sizeof( __m128 );
+STATIC_ASSERT( sizeof( ParticleChunk ) == PARTICLE_CHUNK_FIELDS * sizeof( __m128 ) );
+STATIC_ASSERT( offsetof( ParticleChunk, t ) == 0 && offsetof( ParticleChunk, lifetime ) == sizeof( __m128 ) );
+
+// live particles taken off the end, plus room for another chunk's worth
+typedef float ParticleStaging[ PARTICLE_CHUNK_FIELDS ][ 8 ];
+
+// shuffle that moves the lanes set in mask to the front, in order
+constexpr int LeftPackShuffle( int mask, int lane = 0, int out = 0 ) {
+	return lane == 4 ? 0 :
+		( ( mask >> lane ) & 1 ) != 0 ? ( lane << ( out * 2 ) ) | LeftPackShuffle( mask, lane + 1, out + 1 ) :
+		LeftPackShuffle( mask, lane + 1, out );
+}
+
+// the opposite, spreads the first lanes out over the lanes set in mask
+constexpr int ExpandShuffle( int mask, int lane = 0, int in = 0 ) {
+	return lane == 4 ? 0 :
+		( ( mask >> lane ) & 1 ) != 0 ? ( in << ( lane * 2 ) ) | ExpandShuffle( mask, lane + 1, in + 1 ) :
+		ExpandShuffle( mask, lane + 1, in );
+}
+
+template< int live >
+static void StageParticles( const ParticleChunk * chunk, ParticleStaging & staging, int staged ) {
+	const __m128 * fields = ( const __m128 * ) chunk;
+	for( size_t i = 0; i < PARTICLE_CHUNK_FIELDS; i++ ) {
+		_mm_storeu_ps( &staging[ i ][ staged ], _mm_shuffle_ps( fields[ i ], fields[ i ], LeftPackShuffle( live ) ) );
+	}
+}
+
+template< int dead >
+static void FillDeadParticles( ParticleChunk * chunk, const ParticleStaging & staging ) {
+	alignas( 16 ) static const u32 lanes[] = {
+		dead & 1 ? 0xffffffffu : 0u,
+		dead & 2 ? 0xffffffffu : 0u,
+		dead & 4 ? 0xffffffffu : 0u,
+		dead & 8 ? 0xffffffffu : 0u,
+	};
+	__m128 mask = _mm_load_ps( ( const float * ) lanes );
+
+	__m128 * fields = ( __m128 * ) chunk;
+	for( size_t i = 0; i < PARTICLE_CHUNK_FIELDS; i++ ) {
+		__m128 staged = _mm_load_ps( staging[ i ] );
+		staged = _mm_shuffle_ps( staged, staged, ExpandShuffle( dead ) );
+		fields[ i ] = _mm_or_ps( _mm_andnot_ps( mask, fields[ i ] ), _mm_and_ps( mask, staged ) );
+	}
+}
+
+typedef void ( *StageParticlesFunction )( const ParticleChunk * chunk, ParticleStaging & staging, int staged );
+typedef void ( *FillDeadParticlesFunction )( ParticleChunk * chunk, const ParticleStaging & staging );
+
+static const StageParticlesFunction stage_particles[] = {
+	NULL,
+	StageParticles< 1 >, StageParticles< 2 >, StageParticles< 3 >,
+	StageParticles< 4 >, StageParticles< 5 >, StageParticles< 6 >,
+	StageParticles< 7 >, StageParticles< 8 >, StageParticles< 9 >,
+	StageParticles< 10 >, StageParticles< 11 >, StageParticles< 12 >,
+	StageParticles< 13 >, StageParticles< 14 >, StageParticles< 15 >,
+};
+
+static const FillDeadParticlesFunction fill_dead_particles[] = {
+	NULL,
+	FillDeadParticles< 1 >, FillDeadParticles< 2 >, FillDeadParticles< 3 >,
+	FillDeadParticles< 4 >, FillDeadParticles< 5 >, FillDeadParticles< 6 >,
+	FillDeadParticles< 7 >, FillDeadParticles< 8 >, FillDeadParticles< 9 >,
+	FillDeadParticles< 10 >, FillDeadParticles< 11 >, FillDeadParticles< 12 >,
+	FillDeadParticles< 13 >, FillDeadParticles< 14 >, FillDeadParticles< 15 >,
+};
+
+static const int lanes_in_mask[] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+static int LiveParticlesMask( const ParticleSystem * ps, size_t chunk_idx ) {
+	const ParticleChunk * chunk = &ps->chunks[ chunk_idx ];
+	size_t lanes = Min2( ps->num_particles - chunk_idx * 4, size_t( 4 ) );
+	// cmpngt so NaNs count as alive, same as the scalar version
+	int alive = _mm_movemask_ps( _mm_cmpngt_ps( _mm_load_ps( chunk->t ), _mm_load_ps( chunk->lifetime ) ) );
+	return alive & ( ( 1 << lanes ) - 1 );
+}
+
+static void ShiftStaging( ParticleStaging & staging, int n ) {
+	for( size_t i = 0; i < PARTICLE_CHUNK_FIELDS; i++ ) {
+		_mm_store_ps( staging[ i ], _mm_loadu_ps( &staging[ i ][ n ] ) );
+	}
+}
+
+static void StoreStaging( ParticleChunk * chunk, const ParticleStaging & staging ) {
+	__m128 * fields = ( __m128 * ) chunk;
+	for( size_t i = 0; i < PARTICLE_CHUNK_FIELDS; i++ ) {
+		fields[ i ] = _mm_load_ps( staging[ i ] );
+	}
+}
+
+/*
+ * DeleteExpiredParticles
+ *
+ * Same idea as swapping dead particles with the last one, but a chunk at a
+ * time. Live particles get packed off the end into staging, and then
+ * shuffled into the holes in the chunks at the front. Only the chunks with
+ * dead particles and the ones at the end we take particles from get touched.
+ */
+static void DeleteExpiredParticles( ParticleSystem * ps ) {
+	alignas( 16 ) ParticleStaging staging;
+	int staged = 0;
+
+	size_t front = 0;
+	size_t back = AlignPow2( ps->num_particles, size_t( 4 ) ) / 4; // chunks from here on have been staged
+
+	while( front < back ) {
+		int live = LiveParticlesMask( ps, front );
+		int dead = ~live & 15;
+		if( dead == 0 ) {
+			front++;
+			continue;
+		}
+
+		int need = lanes_in_mask[ dead ];
+		while( staged < need && back - 1 > front ) {
+			back--;
+			int back_live = LiveParticlesMask( ps, back );
+			if( back_live != 0 ) {
+				stage_particles[ back_live ]( &ps->chunks[ back ], staging, staged );
+				staged += lanes_in_mask[ back_live ];
+			}
+		}
+
+		if( staged < need ) {
+			// we ran out of particles to fill this chunk with, so it's the
+			// last one. everything left fits in it
+			if( live != 0 ) {
+				stage_particles[ live ]( &ps->chunks[ front ], staging, staged );
+				staged += lanes_in_mask[ live ];
+			}
+			back = front;
+			break;
+		}
+
+		fill_dead_particles[ dead ]( &ps->chunks[ front ], staging );
+		ShiftStaging( staging, need );
+		staged -= need;
+		front++;
+	}
+
+	// whatever's left in staging goes in the chunk after the full ones
+	if( staged > 0 ) {
+		StoreStaging( &ps->chunks[ back ], staging );
+	}
+
+	ps->num_particles = back * 4 + staged;
+}
+
+/*
+ * Updating particles and filling vertex buffers are split into jobs of a few
+ * hundred chunks and run on the thread pool. Chunks don't depend on each
+ * other so the only serial part left is deleting the dead particles, and
+ * that can run one job per system.
+ *
+ * Vertices get written straight into the mapped vertex buffer, so there's
+ * no copy through the CPU side buffer and glBufferSubData. Mapping and
+ * unmapping has to happen on the main thread.
+ */
+constexpr size_t PARTICLE_JOB_CHUNKS = 256;
+
+struct ParticleJob {
+	ParticleSystem * ps;
+	size_t begin, end;
+	float dt;
+	GPUParticle * vertices;
+};
+
+static void AddParticleJobs( DynamicArray< ParticleJob > * jobs, ParticleSystem * ps, float dt, GPUParticle * vertices ) {
+	size_t active_chunks = AlignPow2( ps->num_particles, size_t( 4 ) ) / 4;
+	for( size_t i = 0; i < active_chunks; i += PARTICLE_JOB_CHUNKS ) {
+		ParticleJob job;
+		job.ps = ps;
+		job.begin = i;
+		job.end = Min2( i + PARTICLE_JOB_CHUNKS, active_chunks );
+		job.dt = dt;
+		job.vertices = vertices;
+		jobs->add( job );
+	}
+}
+
+static void UpdateParticleSystems( Span< ParticleSystem * > systems, float dt ) {
+	TempAllocator temp = cls.frame_arena.temp();
+
+	{
+		ZoneScopedN( "Update particles" );
+
+		DynamicArray< ParticleJob > jobs( &temp );
+		for( ParticleSystem * ps : systems ) {
+			AddParticleJobs( &jobs, ps, dt, NULL );
+		}
+
+		ParallelFor( jobs.span(), []( TempAllocator * temp, void * data ) {
+			const ParticleJob * job = ( const ParticleJob * ) data;
+			for( size_t i = job->begin; i < job->end; i++ ) {
+				UpdateParticleChunk( job->ps, &job->ps->chunks[ i ], job->ps->acceleration, job->dt );
+			}
+		} );
+	}
+
+	ZoneScopedN( "Delete expired particles" );
+
+	ParallelFor( systems, []( TempAllocator * temp, void * data ) {
+		DeleteExpiredParticles( *( ParticleSystem ** ) data );
+	} );
+}
+
+void UpdateParticleSystem( ParticleSystem * ps, float dt ) {
+	UpdateParticleSystems( Span< ParticleSystem * >( &ps, 1 ), dt );
+}
+
+STATIC_ASSERT( offsetof( GPUParticle, scale ) == sizeof( Vec3 ) && sizeof( GPUParticle ) == 6 * sizeof( float ) );
+
+static void FillParticleVerticesScalar( const ParticleSystem * ps, GPUParticle * vertices ) {
+	DisableFPEScoped;
 
 	size_t active_chunks = AlignPow2( ps->num_particles, size_t( 4 ) ) / 4;
 	for( size_t i = 0; i < active_chunks; i++ ) {
 		const ParticleChunk & chunk = ps->chunks[ i ];
-		for( int j = 0; j < 4; j++ ) {
-			ps->vb_memory[ i * 4 + j ].position = Vec3( chunk.position_x[ j ], chunk.position_y[ j ], chunk.position_z[ j ] );
-			ps->vb_memory[ i * 4 + j ].scale = chunk.size[ j ];
-			ps->vb_memory[ i * 4 + j ].t = chunk.t[ j ] / chunk.lifetime[ j ];
+		size_t lanes = Min2( ps->num_particles - i * 4, size_t( 4 ) );
+		for( size_t j = 0; j < lanes; j++ ) {
+			vertices[ i * 4 + j ].position = Vec3( chunk.position_x[ j ], chunk.position_y[ j ], chunk.position_z[ j ] );
+			vertices[ i * 4 + j ].scale = chunk.size[ j ];
+			vertices[ i * 4 + j ].t = chunk.t[ j ] / chunk.lifetime[ j ];
 			Vec4 color = Vec4( chunk.color_r[ j ], chunk.color_g[ j ], chunk.color_b[ j ], chunk.color_a[ j ] );
-			ps->vb_memory[ i * 4 + j ].color = RGBA8( color );
+			vertices[ i * 4 + j ].color = RGBA8( color );
 		}
 	}
+}
 
-	WriteVertexBuffer( ps->vb, ps->vb_memory, ps->num_particles * sizeof( GPUParticle ) );
+// same as RGBA8( Vec4 ), which truncates and keeps the low byte
+static __m128i PackColors( __m128 r, __m128 g, __m128 b, __m128 a ) {
+	__m128 scale = _mm_set1_ps( 255.0f );
+	__m128i low_byte = _mm_set1_epi32( 0xff );
 
-	DrawInstancedParticles( ps->mesh, ps->vb, ps->material, ps->gradient, ps->blend_func, ps->num_particles );
+	__m128i ir = _mm_and_si128( _mm_cvttps_epi32( _mm_mul_ps( r, scale ) ), low_byte );
+	__m128i ig = _mm_and_si128( _mm_cvttps_epi32( _mm_mul_ps( g, scale ) ), low_byte );
+	__m128i ib = _mm_and_si128( _mm_cvttps_epi32( _mm_mul_ps( b, scale ) ), low_byte );
+	__m128i ia = _mm_cvttps_epi32( _mm_mul_ps( a, scale ) );
+
+	__m128i rg = _mm_or_si128( ir, _mm_slli_epi32( ig, 8 ) );
+	__m128i ba = _mm_or_si128( _mm_slli_epi32( ib, 16 ), _mm_slli_epi32( ia, 24 ) );
+	return _mm_or_si128( rg, ba );
+}
+
+/*
+ * FillParticleVertices
+ *
+ * Transposes a chunk at a time so position and scale go out as one 16 byte
+ * store per particle. Vertices are written in order, which is what you want
+ * for write combined memory
+ */
+static void FillParticleVertices( const ParticleSystem * ps, GPUParticle * vertices, size_t begin, size_t end ) {
+	DisableFPEScoped;
+
+	for( size_t i = begin; i < end; i++ ) {
+		const ParticleChunk * chunk = &ps->chunks[ i ];
+
+		__m128 rows[ 4 ] = {
+			_mm_load_ps( chunk->position_x ),
+			_mm_load_ps( chunk->position_y ),
+			_mm_load_ps( chunk->position_z ),
+			_mm_load_ps( chunk->size ),
+		};
+		_MM_TRANSPOSE4_PS( rows[ 0 ], rows[ 1 ], rows[ 2 ], rows[ 3 ] );
+
+		alignas( 16 ) float t[ 4 ];
+		alignas( 16 ) u32 colors[ 4 ];
+		_mm_store_ps( t, _mm_div_ps( _mm_load_ps( chunk->t ), _mm_load_ps( chunk->lifetime ) ) );
+		_mm_store_si128( ( __m128i * ) colors, PackColors( _mm_load_ps( chunk->color_r ), _mm_load_ps( chunk->color_g ), _mm_load_ps( chunk->color_b ), _mm_load_ps( chunk->color_a ) ) );
+
+		size_t lanes = Min2( ps->num_particles - i * 4, size_t( 4 ) );
+		for( size_t j = 0; j < lanes; j++ ) {
+			GPUParticle * vertex = &vertices[ i * 4 + j ];
+			_mm_storeu_ps( &vertex->position.x, rows[ j ] );
+			vertex->t = t[ j ];
+			memcpy( &vertex->color, &colors[ j ], sizeof( vertex->color ) );
+		}
+	}
+}
+
+static void DrawParticleSystems( Span< ParticleSystem * > systems ) {
+	ZoneScoped;
+
+	TempAllocator temp = cls.frame_arena.temp();
+
+	GPUParticle ** mapped = ALLOC_MANY( &temp, GPUParticle *, systems.n );
+	DynamicArray< ParticleJob > jobs( &temp );
+
+	for( size_t i = 0; i < systems.n; i++ ) {
+		ParticleSystem * ps = systems[ i ];
+		mapped[ i ] = NULL;
+		if( ps->num_particles == 0 )
+			continue;
+
+		mapped[ i ] = ( GPUParticle * ) MapVertexBuffer( ps->vb, checked_cast< u32 >( ps->num_particles * sizeof( GPUParticle ) ) );
+		if( mapped[ i ] != NULL ) {
+			AddParticleJobs( &jobs, ps, 0.0f, mapped[ i ] );
+		}
+	}
+
+	ParallelFor( jobs.span(), []( TempAllocator * temp, void * data ) {
+		const ParticleJob * job = ( const ParticleJob * ) data;
+		FillParticleVertices( job->ps, job->vertices, job->begin, job->end );
+	} );
+
+	for( size_t i = 0; i < systems.n; i++ ) {
+		ParticleSystem * ps = systems[ i ];
+		if( mapped[ i ] == NULL )
+			continue;
+
+		// the buffer can get trashed while it's mapped, skip it for a frame
+		if( !UnmapVertexBuffer( ps->vb ) )
+			continue;
+
+		DrawInstancedParticles( ps->mesh, ps->vb, ps->material, ps->gradient, ps->blend_func, ps->num_particles );
+	}
+}
+
+void DrawParticleSystem( ParticleSystem * ps ) {
+	DrawParticleSystems( Span< ParticleSystem * >( &ps, 1 ) );
 }
 
 void DrawParticles() {
+	ParticleSystem * systems[] = { &cgs.ions, &cgs.bullet_sparks, &cgs.sparks };
+
 	float dt = cls.frametime / 1000.0f;
-	UpdateParticleSystem( &cgs.ions, dt );
-	UpdateParticleSystem( &cgs.bullet_sparks, dt );
-	UpdateParticleSystem( &cgs.sparks, dt );
-	DrawParticleSystem( &cgs.ions );
-	DrawParticleSystem( &cgs.bullet_sparks );
-	DrawParticleSystem( &cgs.sparks );
+	UpdateParticleSystems( Span< ParticleSystem * >( systems, ARRAY_COUNT( systems ) ), dt );
+	DrawParticleSystems( Span< ParticleSystem * >( systems, ARRAY_COUNT( systems ) ) );
 }
 
 static void EmitParticle( ParticleSystem * ps, float lifetime, Vec3 position, Vec3 velocity, float dvelocity, Vec4 color, Vec4 dcolor, float size, float dsize ) {
@@ -318,6 +691,99 @@ void EmitParticles( ParticleSystem * ps, const ParticleEmitter & emitter ) {
 	EmitParticles( ps, emitter, cls.frametime / 1000.0f );
 }
 
+static void TopUpBenchParticles( ParticleSystem * ps, RNG * rng ) {
+	while( ps->num_particles < ps->chunks.n * 4 ) {
+		float lifetime = random_uniform_float( rng, 0.05f, 2.0f );
+		Vec3 position = Vec3( random_float11( rng ), random_float11( rng ), random_float11( rng ) ) * 1000.0f;
+		Vec3 velocity = Vec3( random_float11( rng ), random_float11( rng ), random_float11( rng ) ) * 500.0f;
+		Vec4 color = Vec4( random_float01( rng ), random_float01( rng ), random_float01( rng ), 1.0f );
+		EmitParticle( ps, lifetime, position, velocity, -100.0f, color, -color / lifetime, 4.0f, 8.0f / lifetime );
+	}
+}
+
+static double ParticleChecksum( const ParticleSystem * ps ) {
+	double sum = 0.0;
+	for( size_t i = 0; i < ps->num_particles; i++ ) {
+		const ParticleChunk & chunk = ps->chunks[ i / 4 ];
+		size_t j = i % 4;
+		sum += chunk.t[ j ] + chunk.position_x[ j ] + chunk.position_y[ j ] + chunk.position_z[ j ] + chunk.color_a[ j ] + chunk.size[ j ];
+	}
+	return sum;
+}
+
+/*
+ * particlebench [particles] [frames]
+ *
+ * Runs the same particles through the scalar and SSE versions of the update
+ * and vertex fill, topping them back up every frame, and checks they agree.
+ * The SSE version keeps the particles in a different order so compare sums
+ */
+static void ParticleBench_f() {
+	size_t n = Cmd_Argc() > 1 ? Max2( atoi( Cmd_Argv( 1 ) ), 4 ) : 131072;
+	int frames = Cmd_Argc() > 2 ? Max2( atoi( Cmd_Argv( 2 ) ), 1 ) : 200;
+	float dt = 1.0f / 60.0f;
+
+	ParticleSystem scalar = { };
+	ParticleSystem simd = { };
+	scalar.chunks = ALLOC_SPAN( sys_allocator, ParticleChunk, AlignPow2( n, size_t( 4 ) ) / 4 );
+	simd.chunks = ALLOC_SPAN( sys_allocator, ParticleChunk, AlignPow2( n, size_t( 4 ) ) / 4 );
+	defer { FREE( sys_allocator, scalar.chunks.ptr ); };
+	defer { FREE( sys_allocator, simd.chunks.ptr ); };
+
+	scalar.acceleration = simd.acceleration = Vec3( 0, 0, -GRAVITY );
+	scalar.color_easing = simd.color_easing = EasingFunction_Quadratic;
+	scalar.size_easing = simd.size_easing = EasingFunction_QuadraticEaseOut;
+
+	RNG scalar_rng = new_rng( 1, 1 );
+	RNG simd_rng = new_rng( 1, 1 );
+
+	GPUParticle * vertices = ALLOC_MANY( sys_allocator, GPUParticle, n );
+	defer { FREE( sys_allocator, vertices ); };
+
+	s64 scalar_time = 0;
+	s64 simd_time = 0;
+	s64 scalar_fill_time = 0;
+	s64 simd_fill_time = 0;
+	size_t mismatched_counts = 0;
+	size_t updated = 0;
+
+	for( int i = 0; i < frames; i++ ) {
+		TopUpBenchParticles( &scalar, &scalar_rng );
+		TopUpBenchParticles( &simd, &simd_rng );
+		updated += scalar.num_particles;
+
+		s64 t0 = Sys_Microseconds();
+		UpdateParticleSystemScalar( &scalar, dt );
+		s64 t1 = Sys_Microseconds();
+		UpdateParticleSystem( &simd, dt );
+		s64 t2 = Sys_Microseconds();
+
+		FillParticleVerticesScalar( &scalar, vertices );
+		s64 t3 = Sys_Microseconds();
+		FillParticleVertices( &simd, vertices, 0, AlignPow2( simd.num_particles, size_t( 4 ) ) / 4 );
+		s64 t4 = Sys_Microseconds();
+
+		scalar_time += t1 - t0;
+		simd_time += t2 - t1;
+		scalar_fill_time += t3 - t2;
+		simd_fill_time += t4 - t3;
+
+		if( scalar.num_particles != simd.num_particles ) {
+			mismatched_counts++;
+		}
+	}
+
+	double scalar_checksum = ParticleChecksum( &scalar );
+	double simd_checksum = ParticleChecksum( &simd );
+	double error = Abs( scalar_checksum - simd_checksum ) / Max2( 1.0, Abs( scalar_checksum ) );
+
+	Com_Printf( "%zu particle updates over %d frames\n", updated, frames );
+	Com_Printf( "scalar: %.2fms, %.2fns/particle\n", scalar_time / 1000.0, scalar_time * 1000.0 / updated );
+	Com_Printf( "SSE + thread pool: %.2fms, %.2fns/particle\n", simd_time / 1000.0, simd_time * 1000.0 / updated );
+	Com_Printf( "scalar vertex fill: %.2fms, SSE vertex fill: %.2fms\n", scalar_fill_time / 1000.0, simd_fill_time / 1000.0 );
+	Com_Printf( "%zu frames with different particle counts, relative checksum difference %g\n", mismatched_counts, error );
+}
+
 enum ParticleEmitterVersion : u32 {
 	ParticleEmitterVersion_First,
 };
@@ -44,7 +44,6 @@ struct ParticleSystem {
 	size_t num_particles;
 
 	VertexBuffer vb;
-	GPUParticle * vb_memory;
 	Mesh mesh;
 
 	EasingFunction color_easing;
@@ -23,6 +23,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 static int cg_numSolids;
 static SyncEntityState *cg_solidList[MAX_PARSE_ENTITIES];
+static MinMax3 cg_solidBounds[MAX_PARSE_ENTITIES];
 
 static int cg_numTriggers;
 static SyncEntityState *cg_triggersList[MAX_PARSE_ENTITIES];
@@ -30,6 +31,53 @@ static bool cg_triggersListTriggered[MAX_PARSE_ENTITIES];
 
 static bool ucmdReady = false;
 
+/*
+ * Every usercmd we predict keeps the playerstate it ended in and the area
+ * its traces looked at, so we don't have to run the same commands again
+ * every frame. Nothing changes within a snapshot so we only have to run the
+ * commands that weren't finished last frame. When a new snapshot arrives the
+ * cached commands are still good as long as the server ended up where we
+ * predicted for the last command it ran, and nothing we could have collided
+ * with moved near the later ones, so we only have to run the commands after
+ * the first one that isn't.
+ */
+
+struct PredictedCommand {
+	int64_t ucmdNum;
+	usercmd_t cmd;
+	SyncPlayerState ps;
+	WeaponType weapon; // the player entity's, which GS_ThinkPlayerWeapon updates
+	int groundentity;
+	bool touchedTrigger;
+	MinMax3 bounds;
+};
+
+static PredictedCommand predictedCommands[ CMD_BACKUP ];
+static int64_t lastValidPredictedCommand; // 0 if there are none
+static PredictedCommand * predictingCommand;
+static SyncGameState predictedGameState;
+
+/*
+ * What we know about each solid and trigger for prediction, so we can tell
+ * which parts of the world changed between snapshots
+ */
+struct PredictionSolid {
+	int number;
+	int type;
+	int team;
+	int solid;
+	StringHash model;
+	Vec3 angles;
+	MinMax3 bounds;
+};
+
+static PredictionSolid predictionSolids[ 2 ][ MAX_PARSE_ENTITIES ];
+static int numPredictionSolids[ 2 ];
+static int currentPredictionSolids;
+
+static const PredictionSolid * changedSolids[ MAX_PARSE_ENTITIES * 2 ];
+static int numChangedSolids;
+
 /*
 * CG_PredictedEvent - shared code can fire events during prediction
 */
@@ -100,10 +148,277 @@ void CG_CheckPredictionError( void ) {
 /*
 * CG_BuildSolidList
 */
+static const PredictionSolid * CG_AddPredictionSolid( const SyncEntityState * ent ) {
+	PredictionSolid * solid = &predictionSolids[ currentPredictionSolids ][ numPredictionSolids[ currentPredictionSolids ]++ ];
+	memset( solid, 0, sizeof( *solid ) );
+
+	solid->number = ent->number;
+	solid->type = ent->type;
+	solid->team = ent->team;
+	solid->solid = ent->solid;
+	solid->model = ent->model;
+	solid->angles = ent->angles;
+	ClearBounds( &solid->bounds.mins, &solid->bounds.maxs );
+
+	if( ent->solid == SOLID_BMODEL ) {
+		Vec3 mins = Vec3( 0.0f );
+		Vec3 maxs = Vec3( 0.0f );
+		struct cmodel_s * cmodel = CM_TryFindCModel( CM_Client, ent->model );
+		if( cmodel != NULL ) {
+			CM_InlineModelBounds( cl.cms, cmodel, &mins, &maxs );
+		}
+
+		if( ent->angles != Vec3( 0.0f ) ) {
+			float radius = RadiusFromBounds( mins, maxs );
+			mins = Vec3( -radius );
+			maxs = Vec3( radius );
+		}
+
+		// traces move it along its path but CG_PointContents doesn't
+		Vec3 origin = ent->origin;
+		if( ent->linearMovement ) {
+			GS_LinearMovement( ent, cg.frame.serverTime, &origin );
+		}
+
+		AddPointToBounds( origin + mins, &solid->bounds.mins, &solid->bounds.maxs );
+		AddPointToBounds( origin + maxs, &solid->bounds.mins, &solid->bounds.maxs );
+		AddPointToBounds( ent->origin + mins, &solid->bounds.mins, &solid->bounds.maxs );
+		AddPointToBounds( ent->origin + maxs, &solid->bounds.mins, &solid->bounds.maxs );
+	} else {
+		int x = 8 * ( ent->solid & 31 );
+		int zd = 8 * ( ( ent->solid >> 5 ) & 31 );
+		int zu = 8 * ( ( ent->solid >> 10 ) & 63 ) - 32;
+
+		solid->bounds.mins = ent->origin + Vec3( -x, -x, -zd );
+		solid->bounds.maxs = ent->origin + Vec3( x, x, zu );
+	}
+
+	return solid;
+}
+
+/*
+* CG_FindChangedSolids
+*
+* Both lists are in entity order, so walk them together and keep everything
+* that moved, changed or came and went. The player we're predicting is
+* ignored by its own traces so it doesn't count
+*/
+static void CG_FindChangedSolids() {
+	const PredictionSolid * prev = predictionSolids[ currentPredictionSolids ^ 1 ];
+	const PredictionSolid * current = predictionSolids[ currentPredictionSolids ];
+	int numPrev = numPredictionSolids[ currentPredictionSolids ^ 1 ];
+	int numCurrent = numPredictionSolids[ currentPredictionSolids ];
+	int ignore = cgs.playerNum + 1;
+
+	numChangedSolids = 0;
+
+	int i = 0;
+	int j = 0;
+	while( i < numPrev || j < numCurrent ) {
+		if( j == numCurrent || ( i < numPrev && prev[ i ].number < current[ j ].number ) ) {
+			if( prev[ i ].number != ignore ) {
+				changedSolids[ numChangedSolids++ ] = &prev[ i ];
+			}
+			i++;
+		} else if( i == numPrev || current[ j ].number < prev[ i ].number ) {
+			if( current[ j ].number != ignore ) {
+				changedSolids[ numChangedSolids++ ] = &current[ j ];
+			}
+			j++;
+		} else {
+			if( current[ j ].number != ignore && memcmp( &prev[ i ], &current[ j ], sizeof( PredictionSolid ) ) != 0 ) {
+				changedSolids[ numChangedSolids++ ] = &prev[ i ];
+				changedSolids[ numChangedSolids++ ] = &current[ j ];
+			}
+			i++;
+			j++;
+		}
+	}
+}
+
+/*
+ * A uniform grid over the solids in the snapshot, so traces and contents
+ * checks only look at the solids near them instead of all of them. It gets
+ * rebuilt with the solid list and sized to fit whatever's in the snapshot.
+ * Solids that would cover lots of cells go in a list that's always checked.
+ */
+
+constexpr int SOLID_GRID_SIZE = 32;
+constexpr float SOLID_GRID_MIN_CELL_SIZE = 128.0f;
+constexpr int SOLID_GRID_MAX_CELLS_PER_SOLID = 16;
+constexpr size_t SOLID_SET_WORDS = MAX_PARSE_ENTITIES / 64;
+
+struct SolidGrid {
+	Vec2 mins;
+	float inv_cell_size;
+	int cols, rows;
+
+	u16 cell_offsets[ SOLID_GRID_SIZE * SOLID_GRID_SIZE + 1 ];
+	u16 cells[ MAX_PARSE_ENTITIES * SOLID_GRID_MAX_CELLS_PER_SOLID ];
+
+	u16 big[ MAX_PARSE_ENTITIES ];
+	int num_big;
+};
+
+// a set of indices into cg_solidList, iterated in order so we hit solids in
+// the same order as checking them all would
+struct SolidSet {
+	u64 bits[ SOLID_SET_WORDS ];
+};
+
+static SolidGrid cg_solidGrid;
+
+struct SolidGridRect {
+	int x0, y0, x1, y1;
+};
+
+static SolidGridRect CG_SolidGridRect( Vec3 mins, Vec3 maxs ) {
+	const SolidGrid * grid = &cg_solidGrid;
+
+	SolidGridRect rect;
+	rect.x0 = Clamp( 0, int( floorf( ( mins.x - grid->mins.x ) * grid->inv_cell_size ) ), grid->cols - 1 );
+	rect.y0 = Clamp( 0, int( floorf( ( mins.y - grid->mins.y ) * grid->inv_cell_size ) ), grid->rows - 1 );
+	rect.x1 = Clamp( 0, int( floorf( ( maxs.x - grid->mins.x ) * grid->inv_cell_size ) ), grid->cols - 1 );
+	rect.y1 = Clamp( 0, int( floorf( ( maxs.y - grid->mins.y ) * grid->inv_cell_size ) ), grid->rows - 1 );
+	return rect;
+}
+
+static int CG_SolidGridRectCells( SolidGridRect rect ) {
+	return ( rect.x1 - rect.x0 + 1 ) * ( rect.y1 - rect.y0 + 1 );
+}
+
+static void CG_BuildSolidGrid() {
+	SolidGrid * grid = &cg_solidGrid;
+	grid->num_big = 0;
+
+	MinMax3 bounds = MinMax3::Empty();
+	for( int i = 0; i < cg_numSolids; i++ ) {
+		AddPointToBounds( cg_solidBounds[ i ].mins, &bounds.mins, &bounds.maxs );
+		AddPointToBounds( cg_solidBounds[ i ].maxs, &bounds.mins, &bounds.maxs );
+	}
+
+	if( cg_numSolids == 0 ) {
+		bounds = MinMax3( Vec3( 0.0f ), Vec3( 0.0f ) );
+	}
+
+	float cell_size = Max2( SOLID_GRID_MIN_CELL_SIZE, Max2( bounds.maxs.x - bounds.mins.x, bounds.maxs.y - bounds.mins.y ) / SOLID_GRID_SIZE );
+	grid->mins = Vec2( bounds.mins.x, bounds.mins.y );
+	grid->inv_cell_size = 1.0f / cell_size;
+	grid->cols = Clamp( 1, int( ( bounds.maxs.x - bounds.mins.x ) * grid->inv_cell_size ) + 1, SOLID_GRID_SIZE );
+	grid->rows = Clamp( 1, int( ( bounds.maxs.y - bounds.mins.y ) * grid->inv_cell_size ) + 1, SOLID_GRID_SIZE );
+
+	int num_cells = grid->cols * grid->rows;
+	memset( grid->cell_offsets, 0, sizeof( grid->cell_offsets ) );
+
+	// count how many solids go in each cell, then turn the counts into
+	// offsets and fill the cells in a second pass
+	for( int i = 0; i < cg_numSolids; i++ ) {
+		SolidGridRect rect = CG_SolidGridRect( cg_solidBounds[ i ].mins, cg_solidBounds[ i ].maxs );
+		if( CG_SolidGridRectCells( rect ) > SOLID_GRID_MAX_CELLS_PER_SOLID ) {
+			grid->big[ grid->num_big++ ] = u16( i );
+			continue;
+		}
+
+		for( int y = rect.y0; y <= rect.y1; y++ ) {
+			for( int x = rect.x0; x <= rect.x1; x++ ) {
+				grid->cell_offsets[ y * grid->cols + x + 1 ]++;
+			}
+		}
+	}
+
+	for( int i = 0; i < num_cells; i++ ) {
+		grid->cell_offsets[ i + 1 ] += grid->cell_offsets[ i ];
+	}
+
+	u16 cursors[ SOLID_GRID_SIZE * SOLID_GRID_SIZE ];
+	memcpy( cursors, grid->cell_offsets, num_cells * sizeof( u16 ) );
+
+	for( int i = 0; i < cg_numSolids; i++ ) {
+		SolidGridRect rect = CG_SolidGridRect( cg_solidBounds[ i ].mins, cg_solidBounds[ i ].maxs );
+		if( CG_SolidGridRectCells( rect ) > SOLID_GRID_MAX_CELLS_PER_SOLID )
+			continue;
+
+		for( int y = rect.y0; y <= rect.y1; y++ ) {
+			for( int x = rect.x0; x <= rect.x1; x++ ) {
+				grid->cells[ cursors[ y * grid->cols + x ]++ ] = u16( i );
+			}
+		}
+	}
+}
+
+static void AddToSolidSet( SolidSet * set, int i ) {
+	set->bits[ i / 64 ] |= u64( 1 ) << ( i % 64 );
+}
+
+/*
+* CG_SolidsInBox
+*
+* Finds every solid that might touch the box, which is everything if the box
+* is big enough that checking them all is cheaper
+*/
+static void CG_SolidsInBox( Vec3 mins, Vec3 maxs, SolidSet * set ) {
+	const SolidGrid * grid = &cg_solidGrid;
+	memset( set, 0, sizeof( *set ) );
+
+	// traces stop a little short of what they hit
+	mins -= Vec3( 1.0f );
+	maxs += Vec3( 1.0f );
+
+	SolidGridRect rect = CG_SolidGridRect( mins, maxs );
+	if( CG_SolidGridRectCells( rect ) * 4 > cg_numSolids ) {
+		for( int i = 0; i < cg_numSolids; i++ ) {
+			AddToSolidSet( set, i );
+		}
+		return;
+	}
+
+	for( int i = 0; i < grid->num_big; i++ ) {
+		AddToSolidSet( set, grid->big[ i ] );
+	}
+
+	for( int y = rect.y0; y <= rect.y1; y++ ) {
+		for( int x = rect.x0; x <= rect.x1; x++ ) {
+			int cell = y * grid->cols + x;
+			for( int i = grid->cell_offsets[ cell ]; i < grid->cell_offsets[ cell + 1 ]; i++ ) {
+				int solid = grid->cells[ i ];
+				if( BoundsOverlap( mins, maxs, cg_solidBounds[ solid ].mins, cg_solidBounds[ solid ].maxs ) ) {
+					AddToSolidSet( set, solid );
+				}
+			}
+		}
+	}
+}
+
+/*
+* NextInSolidSet
+*
+* Returns the first solid in the set starting from i, or -1
+*/
+static int NextInSolidSet( const SolidSet * set, int i ) {
+	while( i < cg_numSolids ) {
+		u64 word = set->bits[ i / 64 ] >> ( i % 64 );
+		if( word == 0 ) {
+			i = ( i / 64 + 1 ) * 64;
+			continue;
+		}
+
+		while( ( word & 1 ) == 0 ) {
+			word >>= 1;
+			i++;
+		}
+		return i;
+	}
+
+	return -1;
+}
+
 void CG_BuildSolidList( void ) {
 	cg_numSolids = 0;
 	cg_numTriggers = 0;
 
+	currentPredictionSolids ^= 1;
+	numPredictionSolids[ currentPredictionSolids ] = 0;
+
 	for( int i = 0; i < cg.frame.numEntities; i++ ) {
 		const SyncEntityState * ent = &cg.frame.parsedEntities[ i ];
 		if( ISEVENTENTITY( ent ) ) {
@@ -126,14 +441,20 @@ void CG_BuildSolidList( void ) {
 				case ET_JUMPPAD:
 				case ET_PAINKILLER_JUMPPAD:
 					cg_triggersList[cg_numTriggers++] = &cg_entities[ ent->number ].current;
+					CG_AddPredictionSolid( ent );
 					break;
 
 				default:
-					cg_solidList[cg_numSolids++] = &cg_entities[ ent->number ].current;
+					cg_solidList[cg_numSolids] = &cg_entities[ ent->number ].current;
+					cg_solidBounds[cg_numSolids] = CG_AddPredictionSolid( ent )->bounds;
+					cg_numSolids++;
 					break;
 			}
 		}
 	}
+
+	CG_FindChangedSolids();
+	CG_BuildSolidGrid();
 }
 
 /*
@@ -144,7 +465,8 @@ static bool CG_ClipEntityContact( Vec3 origin, Vec3 mins, Vec3 maxs, int entNum
 	int64_t serverTime = cg.frame.serverTime;
 
 	// find the cmodel
-	struct cmodel_s * cmodel = CG_CModelForEntity( entNum );
+	BoxHull hull;
+	struct cmodel_s * cmodel = CG_CModelForEntity( entNum, &hull );
 	if( !cmodel ) {
 		return false;
 	}
@@ -180,6 +502,11 @@ void CG_Predict_TouchTriggers( pmove_t *pm, Vec3 previous_origin ) {
 		return;
 	}
 
+	if( predictingCommand != NULL ) {
+		AddPointToBounds( pm->playerState->pmove.origin + pm->mins, &predictingCommand->bounds.mins, &predictingCommand->bounds.maxs );
+		AddPointToBounds( pm->playerState->pmove.origin + pm->maxs, &predictingCommand->bounds.mins, &predictingCommand->bounds.maxs );
+	}
+
 	for( int i = 0; i < cg_numTriggers; i++ ) {
 		const SyncEntityState * state = cg_triggersList[i];
 
@@ -188,6 +515,9 @@ void CG_Predict_TouchTriggers( pmove_t *pm, Vec3 previous_origin ) {
 				if( CG_ClipEntityContact( pm->playerState->pmove.origin, pm->mins, pm->maxs, state->number ) ) {
 					GS_TouchPushTrigger( &client_gs, pm->playerState, state );
 					cg_triggersListTriggered[i] = true;
+					if( predictingCommand != NULL ) {
+						predictingCommand->touchedTrigger = true;
+					}
 				}
 			}
 		}
@@ -203,9 +533,20 @@ static void CG_ClipMoveToEntities( Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, i
 	Vec3 origin, angles;
 	SyncEntityState *ent;
 	struct cmodel_s *cmodel;
+	BoxHull hull;
 	int64_t serverTime = cg.frame.serverTime;
 
-	for( i = 0; i < cg_numSolids; i++ ) {
+	Vec3 boxmins, boxmaxs;
+	ClearBounds( &boxmins, &boxmaxs );
+	AddPointToBounds( start + mins, &boxmins, &boxmaxs );
+	AddPointToBounds( start + maxs, &boxmins, &boxmaxs );
+	AddPointToBounds( end + mins, &boxmins, &boxmaxs );
+	AddPointToBounds( end + maxs, &boxmins, &boxmaxs );
+
+	SolidSet solids;
+	CG_SolidsInBox( boxmins, boxmaxs, &solids );
+
+	for( i = NextInSolidSet( &solids, 0 ); i != -1; i = NextInSolidSet( &solids, i + 1 ) ) {
 		ent = cg_solidList[i];
 
 		if( ent->number == ignore ) {
@@ -247,9 +588,9 @@ static void CG_ClipMoveToEntities( Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, i
 			angles = Vec3( 0.0f ); // boxes don't rotate
 
 			if( ent->type == ET_PLAYER || ent->type == ET_CORPSE ) {
-				cmodel = CM_OctagonModelForBBox( cl.cms, bmins, bmaxs );
+				cmodel = CM_OctagonModelForBBox( &hull, bmins, bmaxs );
 			} else {
-				cmodel = CM_ModelForBBox( cl.cms, bmins, bmaxs );
+				cmodel = CM_ModelForBBox( &hull, bmins, bmaxs );
 			}
 		}
 
@@ -273,6 +614,13 @@ static void CG_ClipMoveToEntities( Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, i
 void CG_Trace( trace_t *t, Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, int ignore, int contentmask ) {
 	ZoneScoped;
 
+	if( predictingCommand != NULL ) {
+		AddPointToBounds( start + mins, &predictingCommand->bounds.mins, &predictingCommand->bounds.maxs );
+		AddPointToBounds( start + maxs, &predictingCommand->bounds.mins, &predictingCommand->bounds.maxs );
+		AddPointToBounds( end + mins, &predictingCommand->bounds.mins, &predictingCommand->bounds.maxs );
+		AddPointToBounds( end + maxs, &predictingCommand->bounds.mins, &predictingCommand->bounds.maxs );
+	}
+
 	// check against world
 	CM_TransformedBoxTrace( CM_Client, cl.cms, t, start, end, mins, maxs, NULL, contentmask, Vec3( 0.0f ), Vec3( 0.0f ) );
 	t->ent = t->fraction < 1.0 ? 0 : -1; // world entity is 0
@@ -290,9 +638,16 @@ void CG_Trace( trace_t *t, Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, int ignor
 int CG_PointContents( Vec3 point ) {
 	ZoneScoped;
 
+	if( predictingCommand != NULL ) {
+		AddPointToBounds( point, &predictingCommand->bounds.mins, &predictingCommand->bounds.maxs );
+	}
+
 	int contents = CM_TransformedPointContents( CM_Client, cl.cms, point, NULL, Vec3( 0.0f ), Vec3( 0.0f ) );
 
-	for( int i = 0; i < cg_numSolids; i++ ) {
+	SolidSet solids;
+	CG_SolidsInBox( point, point, &solids );
+
+	for( int i = NextInSolidSet( &solids, 0 ); i != -1; i = NextInSolidSet( &solids, i + 1 ) ) {
 		const SyncEntityState * ent = cg_solidList[i];
 		if( ent->solid != SOLID_BMODEL ) { // special value for bmodel
 			continue;
@@ -368,6 +723,105 @@ static void CG_PredictSmoothSteps( void ) {
 	}
 }
 
+/*
+* CG_PredictedStateMatches
+*
+* Compares everything Pmove and GS_ThinkPlayerWeapon read or write
+*/
+static bool CG_PredictedStateMatches( const SyncPlayerState * a, const SyncPlayerState * b ) {
+	const pmove_state_t * pa = &a->pmove;
+	const pmove_state_t * pb = &b->pmove;
+
+	bool pmove_matches = pa->pm_type == pb->pm_type &&
+		pa->origin == pb->origin &&
+		pa->velocity == pb->velocity &&
+		memcmp( pa->delta_angles, pb->delta_angles, sizeof( pa->delta_angles ) ) == 0 &&
+		pa->pm_flags == pb->pm_flags &&
+		pa->pm_time == pb->pm_time &&
+		pa->features == pb->features &&
+		pa->no_control_time == pb->no_control_time &&
+		pa->knockback_time == pb->knockback_time &&
+		pa->crouch_time == pb->crouch_time &&
+		pa->tbag_time == pb->tbag_time &&
+		pa->dash_time == pb->dash_time &&
+		pa->walljump_time == pb->walljump_time &&
+		pa->max_speed == pb->max_speed &&
+		pa->jump_speed == pb->jump_speed &&
+		pa->dash_speed == pb->dash_speed &&
+		pa->gravity == pb->gravity;
+
+	if( !pmove_matches )
+		return false;
+
+	for( size_t i = 0; i < ARRAY_COUNT( a->weapons ); i++ ) {
+		if( a->weapons[ i ].weapon != b->weapons[ i ].weapon || a->weapons[ i ].ammo != b->weapons[ i ].ammo ) {
+			return false;
+		}
+	}
+
+	return a->viewangles == b->viewangles &&
+		a->viewheight == b->viewheight &&
+		a->weapon_state == b->weapon_state &&
+		a->weapon == b->weapon &&
+		a->pending_weapon == b->pending_weapon &&
+		a->weapon_time == b->weapon_time &&
+		a->zoom_time == b->zoom_time;
+}
+
+/*
+* CG_CopyPredictedState
+*
+* Copies the fields CG_PredictedStateMatches compares, the rest always come
+* from the latest snapshot
+*/
+static void CG_CopyPredictedState( SyncPlayerState * dst, const SyncPlayerState * src ) {
+	dst->pmove = src->pmove;
+	memcpy( dst->weapons, src->weapons, sizeof( dst->weapons ) );
+	dst->viewangles = src->viewangles;
+	dst->viewheight = src->viewheight;
+	dst->weapon_state = src->weapon_state;
+	dst->weapon = src->weapon;
+	dst->pending_weapon = src->pending_weapon;
+	dst->weapon_time = src->weapon_time;
+	dst->zoom_time = src->zoom_time;
+}
+
+void CG_ClearPredictionCache() {
+	lastValidPredictedCommand = 0;
+}
+
+/*
+* CG_CheckPredictionCache
+*
+* Called when a new snapshot arrives, after CG_BuildSolidList
+*/
+void CG_CheckPredictionCache() {
+	int64_t ucmdExecuted = cg.frame.ucmdExecuted;
+	const PredictedCommand * executed = &predictedCommands[ ucmdExecuted & CMD_MASK ];
+
+	bool server_agrees = ucmdExecuted <= lastValidPredictedCommand &&
+		executed->ucmdNum == ucmdExecuted &&
+		CG_PredictedStateMatches( &executed->ps, &cg.frame.playerState ) &&
+		predictedGameState.flags == cg.frame.gameState.flags &&
+		predictedGameState.match_state == cg.frame.gameState.match_state;
+
+	if( !server_agrees ) {
+		CG_ClearPredictionCache();
+		return;
+	}
+
+	for( int64_t i = ucmdExecuted + 1; i <= lastValidPredictedCommand; i++ ) {
+		const PredictedCommand * cmd = &predictedCommands[ i & CMD_MASK ];
+		for( int j = 0; j < numChangedSolids; j++ ) {
+			const MinMax3 & bounds = changedSolids[ j ]->bounds;
+			if( BoundsOverlap( cmd->bounds.mins, cmd->bounds.maxs, bounds.mins, bounds.maxs ) ) {
+				lastValidPredictedCommand = i - 1;
+				return;
+			}
+		}
+	}
+}
+
 /*
 * CG_PredictMovement
 *
@@ -383,19 +837,7 @@ void CG_PredictMovement( void ) {
 	trap_NET_GetCurrentState( NULL, &ucmdHead, NULL );
 	ucmdExecuted = cg.frame.ucmdExecuted;
 
-	if( ucmdHead - cg.predictFrom >= CMD_BACKUP ) {
-		cg.predictFrom = 0;
-	}
-
-	if( cg.predictFrom > 0 ) {
-		ucmdExecuted = cg.predictFrom;
-		cg.predictedPlayerState = cg.predictFromPlayerState;
-		cg_entities[cg.frame.playerState.POVnum].current = cg.predictFromEntityState;
-	} else {
-		cg.predictedPlayerState = cg.frame.playerState; // start from the final position
-	}
-
-	cg.predictedPlayerState.POVnum = cgs.playerNum + 1;
+	cg.predictedPlayerState = cg.frame.playerState; // start from the final position
 
 	// if we are too far out of date, just freeze
 	if( ucmdHead - ucmdExecuted >= CMD_BACKUP ) {
@@ -403,19 +845,51 @@ void CG_PredictMovement( void ) {
 			Com_Printf( "exceeded CMD_BACKUP\n" );
 		}
 
+		cg.predictedPlayerState.POVnum = cgs.playerNum + 1;
 		cg.predictingTimeStamp = cl.serverTime;
+		CG_ClearPredictionCache();
 		return;
 	}
 
-	// copy current state to pmove
+	// skip everything we already predicted. the last command isn't finished
+	// so it always gets run again
+	int64_t resumeFrom = ucmdExecuted;
+	for( int64_t i = ucmdExecuted + 1; i < ucmdHead && i <= lastValidPredictedCommand; i++ ) {
+		const PredictedCommand * cmd = &predictedCommands[ i & CMD_MASK ];
+
+		usercmd_t ucmd;
+		trap_NET_GetUserCmd( i & CMD_MASK, &ucmd );
+		if( cmd->ucmdNum != i || memcmp( &cmd->cmd, &ucmd, sizeof( ucmd ) ) != 0 ) {
+			break;
+		}
+
+		// the triggered toggles below only last for one round of prediction
+		if( cmd->touchedTrigger ) {
+			break;
+		}
+
+		resumeFrom = i;
+	}
+
 	memset( &pm, 0, sizeof( pm ) );
 	pm.playerState = &cg.predictedPlayerState;
 
+	if( resumeFrom > ucmdExecuted ) {
+		const PredictedCommand * cmd = &predictedCommands[ resumeFrom & CMD_MASK ];
+		CG_CopyPredictedState( &cg.predictedPlayerState, &cmd->ps );
+		cg_entities[cgs.playerNum + 1].current.weapon = cmd->weapon;
+		pm.groundentity = cmd->groundentity;
+	}
+
+	cg.predictedPlayerState.POVnum = cgs.playerNum + 1;
+
 	// clear the triggered toggles for this prediction round
 	memset( &cg_triggersListTriggered, false, sizeof( cg_triggersListTriggered ) );
 
+	predictedGameState = cg.frame.gameState;
+
 	// run frames
-	while( ++ucmdExecuted <= ucmdHead ) {
+	for( ucmdExecuted = resumeFrom + 1; ucmdExecuted <= ucmdHead; ucmdExecuted++ ) {
 		frame = ucmdExecuted & CMD_MASK;
 		trap_NET_GetUserCmd( frame, &pm.cmd );
 
@@ -424,7 +898,15 @@ void CG_PredictMovement( void ) {
 			cg.predictingTimeStamp = pm.cmd.serverTimeStamp;
 		}
 
+		PredictedCommand * cmd = &predictedCommands[ frame ];
+		cmd->ucmdNum = ucmdExecuted;
+		cmd->cmd = pm.cmd;
+		cmd->touchedTrigger = false;
+		ClearBounds( &cmd->bounds.mins, &cmd->bounds.maxs );
+
+		predictingCommand = cmd;
 		Pmove( &client_gs, &pm );
+		predictingCommand = NULL;
 
 		// copy for stair smoothing
 		predictedSteps[frame] = pm.step;
@@ -436,18 +918,14 @@ void CG_PredictMovement( void ) {
 		// save for debug checking
 		cg.predictedOrigins[frame] = cg.predictedPlayerState.pmove.origin; // store for prediction error checks
 
-		// backup the last predicted ucmd which has a timestamp (it's closed)
-		if( ucmdExecuted == ucmdHead - 1 ) {
-			if( ucmdExecuted != cg.predictFrom ) {
-				cg.predictFrom = ucmdExecuted;
-				cg.predictFromPlayerState = cg.predictedPlayerState;
-				cg.predictFromEntityState = cg_entities[cg.frame.playerState.POVnum].current;
-			}
-		}
+		cmd->ps = cg.predictedPlayerState;
+		cmd->weapon = cg_entities[cg.predictedPlayerState.POVnum].current.weapon;
+		cmd->groundentity = pm.groundentity;
 	}
 
-	cg.predictedGroundEntity = pm.groundentity;
+	lastValidPredictedCommand = ucmdHead;
 
+	cg.predictedGroundEntity = pm.groundentity;
 	// compensate for ground entity movement
 	if( pm.groundentity != -1 ) {
 		SyncEntityState *ent = &cg_entities[pm.groundentity].current;
@@ -572,7 +572,7 @@ static void CG_SetupViewDef( cg_viewdef_t *view, int type ) {
 			CG_ViewSmoothPredictedSteps( &view->origin ); // smooth out stair climbing
 		} else {
 			cg.predictingTimeStamp = cl.serverTime;
-			cg.predictFrom = 0;
+			CG_ClearPredictionCache();
 
 			// we don't run prediction, but we still set cg.predictedPlayerState with the interpolation
 			CG_InterpolatePlayerState( &cg.predictedPlayerState );
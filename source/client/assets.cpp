@@ -5,26 +5,121 @@
 #include "qcommon/base.h"
 #include "qcommon/fs.h"
 #include "qcommon/hash.h"
-#include "qcommon/hashtable.h"
+#include "qcommon/array.h"
+#include "qcommon/pack.h"
 #include "qcommon/string.h"
+#include "qcommon/threads.h"
 #include "client/assets.h"
 
+/*
+ * Files in base.pack get registered up front and decompressed the first time
+ * they're used, or used straight out of the pack's mapping if they're stored
+ * uncompressed. Loose files in base/ take priority so they can be hotloaded,
+ * so they get read onto the heap rather than mapped: editors that save in
+ * place would change or truncate them under us.
+ */
+
+enum AssetStorage {
+	AssetStorage_Heap,
+	AssetStorage_Packed, // owned by the pack
+};
+
 struct Asset {
 	char * path;
-	Span< char > data;
+	u64 hash;
+	Span< const char > data; // includes the trailing '\0', NULL if packed and not loaded yet
+	AssetStorage storage;
+	const PackedFile * packed;
 	s64 modified_time;
 };
 
-static constexpr u32 MAX_ASSETS = 4096;
+static DynamicArray< Asset > assets( NO_INIT );
+static DynamicArray< const char * > asset_paths( NO_INIT );
+static DynamicArray< const char * > modified_asset_paths( NO_INIT );
+
+// open addressing, stores index + 1 so 0 can mean empty
+static u32 * assets_index;
+static size_t assets_index_capacity;
+
+static Mutex * packed_assets_mutex;
+
+static bool FindAsset( u64 hash, size_t * idx ) {
+	if( assets_index_capacity == 0 )
+		return false;
+
+	size_t mask = assets_index_capacity - 1;
+	for( size_t i = hash & mask; assets_index[ i ] != 0; i = ( i + 1 ) & mask ) {
+		size_t candidate = assets_index[ i ] - 1;
+		if( assets[ candidate ].hash == hash ) {
+			*idx = candidate;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void AddToAssetsIndex( size_t idx ) {
+	size_t mask = assets_index_capacity - 1;
+	size_t i = assets[ idx ].hash & mask;
+	while( assets_index[ i ] != 0 ) {
+		i = ( i + 1 ) & mask;
+	}
+	assets_index[ i ] = checked_cast< u32 >( idx + 1 );
+}
+
+static void GrowAssetsIndex() {
+	if( ( assets.size() + 1 ) * 2 <= assets_index_capacity )
+		return;
+
+	FREE( sys_allocator, assets_index );
+	assets_index_capacity = Max2( size_t( 1024 ), assets_index_capacity * 2 );
+	assets_index = ALLOC_MANY( sys_allocator, u32, assets_index_capacity );
+	memset( assets_index, 0, assets_index_capacity * sizeof( u32 ) );
+
+	for( size_t i = 0; i < assets.size(); i++ ) {
+		AddToAssetsIndex( i );
+	}
+}
+
+static void FreeAssetData( Asset * a ) {
+	if( a->storage == AssetStorage_Heap ) {
+		FREE( sys_allocator, const_cast< char * >( a->data.ptr ) );
+	}
+}
+
+static bool LoadAssetData( const char * full_path, Asset * a ) {
+	Span< char > contents = ReadFileString( sys_allocator, full_path );
+	if( contents.ptr == NULL )
+		return false;
+
+	a->data = contents;
+	a->storage = AssetStorage_Heap;
+	return true;
+}
+
+static size_t AddAsset( const char * path, u64 hash ) {
+	GrowAssetsIndex();
 
-static Asset assets[ MAX_ASSETS ];
-static const char * asset_paths[ MAX_ASSETS ];
-static u32 num_assets;
+	size_t idx = assets.add( Asset() );
+	Asset * a = &assets[ idx ];
+	a->path = ALLOC_MANY( sys_allocator, char, strlen( path ) + 1 );
+	Q_strncpyz( a->path, path, strlen( path ) + 1 );
+	a->hash = hash;
+	asset_paths.add( a->path );
 
-static const char * modified_asset_paths[ MAX_ASSETS ];
-static u32 num_modified_assets;
+	AddToAssetsIndex( idx );
 
-static Hashtable< MAX_ASSETS * 2 > assets_hashtable;
+	return idx;
+}
+
+static void AddPackedAssets() {
+	for( const PackedFile & file : PackedFiles() ) {
+		size_t idx = AddAsset( PackedFileName( &file ), file.hash );
+		assets[ idx ].storage = AssetStorage_Packed;
+		assets[ idx ].packed = &file;
+	}
+}
 
 static void LoadAsset( const char * full_path, size_t skip ) {
 	ZoneScoped;
@@ -34,44 +129,36 @@ static void LoadAsset( const char * full_path, size_t skip ) {
 
 	s64 modified_time = FileLastModifiedTime( full_path );
 
-	u64 idx;
-	bool exists = assets_hashtable.get( hash, &idx );
+	size_t idx;
+	bool exists = FindAsset( hash, &idx );
 	if( exists ) {
-		if( assets[ idx ].modified_time == modified_time ) {
+		if( strcmp( assets[ idx ].path, path ) != 0 ) {
+			Com_Error( ERR_FATAL, "Asset hash name collision %s", path );
+		}
+
+		if( assets[ idx ].packed == NULL && assets[ idx ].modified_time == modified_time ) {
 			return;
 		}
 	}
 
-	Span< char > contents = ReadFileString( sys_allocator, full_path );
-	if( contents.ptr == NULL )
+	Asset loaded;
+	if( !LoadAssetData( full_path, &loaded ) )
 		return;
 
-	Asset * a;
 	if( exists ) {
-		a = &assets[ idx ];
-		FREE( sys_allocator, a->data.ptr );
+		FreeAssetData( &assets[ idx ] );
 	}
 	else {
-		a = &assets[ num_assets ];
-		a->path = ALLOC_MANY( sys_allocator, char, strlen( path ) + 1 );
-		Q_strncpyz( a->path, path, strlen( path ) + 1 );
-		asset_paths[ num_assets ] = a->path;
+		idx = AddAsset( path, hash );
 	}
 
-	a->data = contents;
+	Asset * a = &assets[ idx ];
+	a->data = loaded.data;
+	a->storage = loaded.storage;
+	a->packed = NULL;
 	a->modified_time = modified_time;
 
-	modified_asset_paths[ num_modified_assets ] = a->path;
-	num_modified_assets++;
-
-	if( !exists ) {
-		bool ok = assets_hashtable.add( hash, num_assets );
-		num_assets++;
-
-		if( !ok ) {
-			Com_Error( ERR_FATAL, "Asset hash name collision %s", path );
-		}
-	}
+	modified_asset_paths.add( a->path );
 }
 
 static void LoadAssetsRecursive( DynamicString * path, size_t skip ) {
@@ -80,11 +167,6 @@ static void LoadAssetsRecursive( DynamicString * path, size_t skip ) {
 	const char * name;
 	bool dir;
 	while( ListDirNext( &scan, &name, &dir ) ) {
-		if( num_assets == MAX_ASSETS ) {
-			Com_Printf( S_COLOR_YELLOW "Too many assets\n" );
-			return;
-		}
-
 		// skip ., .., .git, etc
 		if( name[ 0 ] == '.' )
 			continue;
@@ -104,27 +186,32 @@ static void LoadAssetsRecursive( DynamicString * path, size_t skip ) {
 void InitAssets( TempAllocator * temp ) {
 	ZoneScoped;
 
-	num_assets = 0;
-	num_modified_assets = 0;
-	assets_hashtable.clear();
+	assets.init( sys_allocator );
+	asset_paths.init( sys_allocator );
+	modified_asset_paths.init( sys_allocator );
+	assets_index = NULL;
+	assets_index_capacity = 0;
+	packed_assets_mutex = NewMutex();
+
+	AddPackedAssets();
 
 	const char * root = FS_RootPath( temp );
 	DynamicString base( temp, "{}/base", root );
 	LoadAssetsRecursive( &base, base.length() + 1 );
 
-	num_modified_assets = 0;
+	modified_asset_paths.clear();
 }
 
 void HotloadAssets( TempAllocator * temp ) {
 	ZoneScoped;
 
-	num_modified_assets = 0;
+	modified_asset_paths.clear();
 
 	const char * root = FS_RootPath( temp );
 	DynamicString base( temp, "{}/base", root );
 	LoadAssetsRecursive( &base, base.length() + 1 );
 
-	if( num_modified_assets > 0 ) {
+	if( modified_asset_paths.size() > 0 ) {
 		Com_Printf( "Hotloading:\n" );
 		for( const char * path : ModifiedAssetPaths() ) {
 			Com_Printf( "    %s\n", path );
@@ -133,21 +220,53 @@ void HotloadAssets( TempAllocator * temp ) {
 }
 
 void DoneHotloadingAssets() {
-	num_modified_assets = 0;
+	modified_asset_paths.clear();
 }
 
 void ShutdownAssets() {
-	for( u32 i = 0; i < num_assets; i++ ) {
-		FREE( sys_allocator, assets[ i ].path );
-		FREE( sys_allocator, assets[ i ].data.ptr );
+	for( Asset & a : assets ) {
+		FREE( sys_allocator, a.path );
+		FreeAssetData( &a );
+	}
+
+	FREE( sys_allocator, assets_index );
+	DeleteMutex( packed_assets_mutex );
+
+	assets.shutdown();
+	asset_paths.shutdown();
+	modified_asset_paths.shutdown();
+}
+
+static const Asset * GetAsset( u64 hash ) {
+	size_t idx;
+	if( !FindAsset( hash, &idx ) )
+		return NULL;
+
+	Asset * a = &assets[ idx ];
+	if( a->packed == NULL )
+		return a;
+
+	Lock( packed_assets_mutex );
+	defer { Unlock( packed_assets_mutex ); };
+
+	if( a->data.ptr == NULL ) {
+		Span< const u8 > data;
+		bool allocated;
+		if( !ReadPackedFile( a->packed, sys_allocator, &data, &allocated ) )
+			return NULL;
+
+		a->data = Span< const char >( ( const char * ) data.ptr, data.n + 1 );
+		a->storage = allocated ? AssetStorage_Heap : AssetStorage_Packed;
 	}
+
+	return a;
 }
 
 Span< const char > AssetString( StringHash path ) {
-	size_t i;
-	if( !assets_hashtable.get( path.hash, &i ) )
+	const Asset * a = GetAsset( path.hash );
+	if( a == NULL )
 		return Span< const char >();
-	return assets[ i ].data;
+	return a->data;
 }
 
 Span< const char > AssetString( const char * path ) {
@@ -155,10 +274,10 @@ Span< const char > AssetString( const char * path ) {
 }
 
 Span< const u8 > AssetBinary( StringHash path ) {
-	size_t i;
-	if( !assets_hashtable.get( path.hash, &i ) )
+	const Asset * a = GetAsset( path.hash );
+	if( a == NULL )
 		return Span< const u8 >();
-	return Span< const char >( assets[ i ].data.ptr, assets[ i ].data.n - 1 ).cast< const u8 >();
+	return Span< const char >( a->data.ptr, a->data.n - 1 ).cast< const u8 >();
 }
 
 Span< const u8 > AssetBinary( const char * path ) {
@@ -166,9 +285,9 @@ Span< const u8 > AssetBinary( const char * path ) {
 }
 
 Span< const char * > AssetPaths() {
-	return Span< const char * >( asset_paths, num_assets );
+	return asset_paths.span();
 }
 
 Span< const char * > ModifiedAssetPaths() {
-	return Span< const char * >( modified_asset_paths, num_modified_assets );
+	return modified_asset_paths.span();
 }
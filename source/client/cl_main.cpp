@@ -21,7 +21,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "qcommon/base.h"
 #include "client/client.h"
 #include "client/assets.h"
-#include "client/threadpool.h"
+#include "qcommon/threadpool.h"
 #include "client/renderer/renderer.h"
 #include "qcommon/asyncstream.h"
 #include "qcommon/version.h"
@@ -196,8 +196,9 @@ static void CL_Quit_f( void ) {
 static void CL_SendConnectPacket( void ) {
 	userinfo_modified = false;
 
-	Netchan_OutOfBandPrint( cls.socket, &cls.serveraddress, "connect %i %i %i \"%s\"\n",
-							APP_PROTOCOL_VERSION, Netchan_GamePort(), cls.challenge, Cvar_Userinfo() );
+	Netchan_OutOfBandPrint( cls.socket, &cls.serveraddress, "connect %i %i %i \"%s\" %i %u\n",
+							APP_PROTOCOL_VERSION, Netchan_GamePort(), cls.challenge, Cvar_Userinfo(),
+							Netchan_LocalCompression(), Netchan_ZstdDictID() );
 }
 
 /*
@@ -849,6 +850,11 @@ static void CL_ConnectionlessPacket( const socket_t *socket, const netadr_t *add
 		Q_strncpyz( cls.session, MSG_ReadStringLine( msg ), sizeof( cls.session ) );
 
 		Netchan_Setup( &cls.netchan, socket, address, Netchan_GamePort() );
+
+		// servers that don't know about zstd don't send this and use zlib
+		if( atoi( MSG_ReadStringLine( msg ) ) == NETCHAN_COMPRESSION_ZSTD && Netchan_LocalCompression() == NETCHAN_COMPRESSION_ZSTD ) {
+			cls.netchan.compression = NETCHAN_COMPRESSION_ZSTD;
+		}
 		memset( cl.configstrings, 0, sizeof( cl.configstrings ) );
 		CL_SetClientState( CA_HANDSHAKE );
 		CL_AddReliableCommand( "new" );
@@ -989,7 +995,7 @@ static bool CL_ProcessPacket( netchan_t *netchan, msg_t *msg ) {
 	MSG_ReadInt32( msg ); // sequence
 	MSG_ReadInt32( msg ); // sequence_ack
 	if( msg->compressed ) {
-		zerror = Netchan_DecompressMessage( msg );
+		zerror = Netchan_DecompressMessage( msg, cls.netchan.compression );
 		if( zerror < 0 ) {
 			// compression error. Drop the packet
 			Com_Printf( "CL_ProcessPacket: Compression error %i. Dropping packet\n", zerror );
@@ -1301,6 +1307,9 @@ static void CL_InitLocal( void ) {
 
 	Cvar_Get( "hand", "0", CVAR_USERINFO | CVAR_ARCHIVE );
 
+	// bytes per snapshot, for bad connections where fragmented snapshots get lost
+	Cvar_Get( "snapbudget", "0", CVAR_USERINFO | CVAR_ARCHIVE );
+
 	Cvar_Get( "cl_download_name", "", CVAR_READONLY );
 	Cvar_Get( "cl_download_percent", "0", CVAR_READONLY );
 
@@ -1505,7 +1514,7 @@ void CL_Netchan_Transmit( msg_t *msg ) {
 	Netchan_PushAllFragments( &cls.netchan );
 
 	if( msg->cursize > 60 ) {
-		int zerror = Netchan_CompressMessage( msg );
+		int zerror = Netchan_CompressMessage( msg, cls.netchan.compression );
 		if( zerror < 0 ) { // it's compression error, just send uncompressed
 			Com_DPrintf( "CL_Netchan_Transmit (ignoring compression): Compression error %i\n", zerror );
 		}
@@ -1871,8 +1880,6 @@ void CL_Init( void ) {
 
 	Con_Init();
 
-	InitThreadPool();
-
 	ThreadPoolDo( []( TempAllocator * temp, void * data ) {
 		InitAssets( temp );
 	} );
@@ -1960,8 +1967,6 @@ void CL_Shutdown( void ) {
 
 	CL_ShutdownLocal();
 
-	ShutdownThreadPool();
-
 	Con_Shutdown();
 
 	ShutdownAssets();
@@ -3,13 +3,39 @@
 #include "qcommon/cmodel.h"
 #include "qcommon/compression.h"
 #include "qcommon/hashtable.h"
+#include "qcommon/threadpool.h"
+#include "client/client.h"
 #include "client/assets.h"
 #include "client/maps.h"
 #include "client/renderer/model.h"
 
 constexpr u32 MAX_MAPS = 128;
 
-static Map maps[ MAX_MAPS ];
+/*
+ * Maps are only registered at startup and get loaded the first time they're
+ * used. Decompression doesn't touch any shared state, so that part can be
+ * started early on the thread pool with PrefetchMap. Render data and collision
+ * need the main thread.
+ */
+
+enum MapState {
+	MapState_Unloaded,
+	MapState_Loaded,
+	MapState_Failed,
+};
+
+struct MapEntry {
+	Map map;
+	MapState state;
+
+	JobCounter prefetch;
+	bool prefetched;
+	bool prefetch_ok;
+	Span< const u8 > compressed;
+	Span< u8 > decompressed;
+};
+
+static MapEntry maps[ MAX_MAPS ];
 static u32 num_maps;
 static Hashtable< MAX_MAPS * 2 > maps_hashtable;
 
@@ -23,52 +49,167 @@ void InitMaps() {
 		if( ext != ".bsp" )
 			continue;
 
-		ZoneScopedN( "Load map" );
-		ZoneText( path, strlen( path ) );
-
-		Span< const u8 > compressed = AssetBinary( path );
-		if( compressed.n < 4 ) {
-			Com_Printf( S_COLOR_RED "BSP too small %s\n", path );
+		if( num_maps == ARRAY_COUNT( maps ) ) {
+			Com_Printf( S_COLOR_YELLOW "Too many maps, ignoring %s\n", path );
 			continue;
 		}
 
-		Span< u8 > decompressed;
-		defer { FREE( sys_allocator, decompressed.ptr ); };
-		bool ok = Decompress( path, sys_allocator, compressed, &decompressed );
-		if( !ok )
-			continue;
+		MapEntry * entry = &maps[ num_maps ];
+		entry->map = { };
+		entry->map.name = CopyString( sys_allocator, path );
+		entry->map.base_hash = Hash64( path, strlen( path ) - ext.n );
+		entry->state = MapState_Unloaded;
+		entry->prefetched = false;
 
-		Span< const u8 > data = decompressed.ptr == NULL ? compressed : decompressed;
+		maps_hashtable.add( entry->map.base_hash, num_maps );
+		num_maps++;
+	}
+}
 
-		maps[ num_maps ].name = CopyString( sys_allocator, path );
-		u64 base_hash = Hash64( path, strlen( path ) - ext.n );
+static void FreeDecompressedMap( MapEntry * entry ) {
+	ThreadPoolWait( &entry->prefetch );
+	FREE( sys_allocator, entry->decompressed.ptr );
+	entry->decompressed = Span< u8 >();
+	entry->prefetched = false;
+}
 
-		if( !LoadBSPRenderData( &maps[ num_maps ], base_hash, data ) )
-			continue;
+void ShutdownMaps() {
+	for( u32 i = 0; i < num_maps; i++ ) {
+		FreeDecompressedMap( &maps[ i ] );
+		FREE( sys_allocator, const_cast< char * >( maps[ i ].map.name ) );
+		if( maps[ i ].state == MapState_Loaded ) {
+			CM_Free( CM_Client, maps[ i ].map.cms );
+		}
+	}
+
+	num_maps = 0;
+	maps_hashtable.clear();
+}
+
+static void DecompressMapJob( TempAllocator * temp, void * data ) {
+	ZoneScopedN( "Prefetch map" );
+
+	MapEntry * entry = ( MapEntry * ) data;
+	entry->prefetch_ok = Decompress( entry->map.name, sys_allocator, entry->compressed, &entry->decompressed );
+}
 
-		maps[ num_maps ].cms = CM_LoadMap( CM_Client, data, base_hash );
-		if( maps[ num_maps ].cms == NULL )
-			// TODO: free render data
+static void PrefetchMap( MapEntry * entry ) {
+	if( entry->state != MapState_Unloaded || entry->prefetched )
+		return;
+
+	entry->compressed = AssetBinary( entry->map.name );
+	if( entry->compressed.n < 4 )
+		return;
+
+	entry->prefetched = true;
+	entry->decompressed = Span< u8 >();
+	ThreadPoolDo( DecompressMapJob, entry, &entry->prefetch );
+}
+
+static MapEntry * FindMapEntry( Span< const char > name ) {
+	TempAllocator temp = cls.frame_arena.temp();
+
+	u64 idx;
+	if( !maps_hashtable.get( StringHash( temp( "maps/{}", name ) ).hash, &idx ) )
+		return NULL;
+	return &maps[ idx ];
+}
+
+void PrefetchMap( const char * name ) {
+	MapEntry * entry = FindMapEntry( MakeSpan( name ) );
+	if( entry != NULL ) {
+		PrefetchMap( entry );
+	}
+}
+
+/*
+ * PrefetchNextMapInRotation
+ *
+ * With a local server we can see its rotation and get a head start on the
+ * next map
+ */
+static void PrefetchNextMapInRotation( MapEntry * current ) {
+	const char * rotation = Cvar_String( "g_maplist" );
+	if( Cvar_Value( "g_maprotation" ) == 0 )
+		return;
+
+	// same separators as G_UpdateMapRotation
+	const char * seps = " ,\n\r";
+
+	MapEntry * first = NULL;
+	bool found_current = false;
+
+	const char * cursor = rotation + strspn( rotation, seps );
+	while( *cursor != '\0' ) {
+		size_t len = strcspn( cursor, seps );
+		MapEntry * entry = FindMapEntry( Span< const char >( cursor, len ) );
+		cursor += len;
+		cursor += strspn( cursor, seps );
+
+		if( entry == NULL )
 			continue;
 
-		maps_hashtable.add( base_hash, num_maps );
-		num_maps++;
+		if( found_current ) {
+			PrefetchMap( entry );
+			return;
+		}
+
+		if( first == NULL ) {
+			first = entry;
+		}
+
+		found_current = entry == current;
 	}
 
+	// wrap around
+	if( found_current && first != NULL ) {
+		PrefetchMap( first );
+	}
 }
 
-void ShutdownMaps() {
-	for( u32 i = 0; i < num_maps; i++ ) {
-		FREE( sys_allocator, const_cast< char * >( maps[ i ].name ) );
-		CM_Free( CM_Client, maps[ i ].cms );
+static bool LoadMap( MapEntry * entry ) {
+	ZoneScoped;
+	ZoneText( entry->map.name, strlen( entry->map.name ) );
+
+	PrefetchMap( entry );
+	if( !entry->prefetched ) {
+		Com_Printf( S_COLOR_RED "BSP too small %s\n", entry->map.name );
+		return false;
 	}
+
+	defer { FreeDecompressedMap( entry ); };
+
+	ThreadPoolWait( &entry->prefetch );
+	if( !entry->prefetch_ok )
+		return false;
+
+	Span< const u8 > data = entry->decompressed.ptr == NULL ? entry->compressed : entry->decompressed;
+
+	if( !LoadBSPRenderData( &entry->map, entry->map.base_hash, data ) )
+		return false;
+
+	entry->map.cms = CM_LoadMap( CM_Client, data, entry->map.base_hash );
+	if( entry->map.cms == NULL )
+		// TODO: free render data
+		return false;
+
+	return true;
 }
 
 const Map * FindMap( StringHash name ) {
 	u64 idx;
 	if( !maps_hashtable.get( name.hash, &idx ) )
 		return NULL;
-	return &maps[ idx ];
+
+	MapEntry * entry = &maps[ idx ];
+	if( entry->state == MapState_Unloaded ) {
+		entry->state = LoadMap( entry ) ? MapState_Loaded : MapState_Failed;
+		if( entry->state == MapState_Loaded ) {
+			PrefetchNextMapInRotation( entry );
+		}
+	}
+
+	return entry->state == MapState_Loaded ? &entry->map : NULL;
 }
 
 const Map * FindMap( const char * name ) {
@@ -602,6 +602,10 @@ static void ServerBrowser() {
 		if( strstr( name, server_filter ) != NULL ) {
 			if( ImGui::Selectable( name, i == selected_server, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowDoubleClick ) ) {
 				if( ImGui::IsMouseDoubleClicked( 0 ) ) {
+					// the handshake takes a few round trips, decompress the map meanwhile
+					if( servers[ i ].map != NULL ) {
+						PrefetchMap( servers[ i ].map );
+					}
 					Cbuf_AddText( temp( "connect \"{}\"\n", servers[ i ].address ) );
 				}
 				selected_server = i;
@@ -8,7 +8,7 @@
 #include "client/client.h"
 #include "client/assets.h"
 #include "client/sound.h"
-#include "client/threadpool.h"
+#include "qcommon/threadpool.h"
 #include "gameshared/gs_public.h"
 
 #define AL_LIBTYPE_STATIC
@@ -19,6 +19,9 @@ struct Map {
 void InitMaps();
 void ShutdownMaps();
 
+// maps are loaded on first use, this starts decompressing one in the background
+void PrefetchMap( const char * name );
+
 const Map * FindMap( StringHash name );
 const Map * FindMap( const char * name );
 
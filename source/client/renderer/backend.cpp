@@ -745,6 +745,22 @@ void WriteVertexBuffer( VertexBuffer vb, const void * data, u32 len, u32 offset
 	glBufferSubData( GL_ARRAY_BUFFER, offset, len, data );
 }
 
+/*
+ * MapVertexBuffer
+ *
+ * Orphans the buffer and maps the first len bytes for writing, so we don't
+ * stall on draws that still use the old contents. Returns NULL on failure
+ */
+void * MapVertexBuffer( VertexBuffer vb, u32 len ) {
+	glBindBuffer( GL_ARRAY_BUFFER, vb.vbo );
+	return glMapBufferRange( GL_ARRAY_BUFFER, 0, len, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT );
+}
+
+bool UnmapVertexBuffer( VertexBuffer vb ) {
+	glBindBuffer( GL_ARRAY_BUFFER, vb.vbo );
+	return glUnmapBuffer( GL_ARRAY_BUFFER ) == GL_TRUE;
+}
+
 void DeleteVertexBuffer( VertexBuffer vb ) {
 	glDeleteBuffers( 1, &vb.vbo );
 }
@@ -298,6 +298,8 @@ UniformBlock UploadUniforms( const void * data, size_t size );
 VertexBuffer NewVertexBuffer( const void * data, u32 len );
 VertexBuffer NewVertexBuffer( u32 len );
 void WriteVertexBuffer( VertexBuffer vb, const void * data, u32 size, u32 offset = 0 );
+void * MapVertexBuffer( VertexBuffer vb, u32 len );
+bool UnmapVertexBuffer( VertexBuffer vb );
 void DeleteVertexBuffer( VertexBuffer vb );
 
 template< typename T >
@@ -29,7 +29,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "gameshared/q_shared.h"
 #include "client/client.h"
 #include "client/assets.h"
-#include "client/threadpool.h"
+#include "qcommon/threadpool.h"
 #include "client/renderer/renderer.h"
 
 #include "stb/stb_image.h"
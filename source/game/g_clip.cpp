@@ -20,6 +20,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include "game/g_local.h"
 #include "qcommon/cmodel.h"
+#include "qcommon/threadpool.h"
 
 //===============================================================================
 //
@@ -45,16 +46,11 @@ typedef struct
 	Vec3 mins;
 	Vec3 maxs;
 	Vec3 size;
-	int marknumber;
-
-	// since the areagrid can have multiple references to one entity,
-	// we should avoid extensive checking on entities already encountered
-	int entmarknumber[MAX_EDICTS];
 } areagrid_t;
 
 static areagrid_t g_areagrid;
 
-#define CFRAME_UPDATE_BACKUP    64  // copies of SyncEntityState to keep buffered (1 second of backup at 62 fps).
+#define CFRAME_UPDATE_BACKUP    64  // frames of collision history to keep buffered (1 second of backup at 62 fps).
 #define CFRAME_UPDATE_MASK  ( CFRAME_UPDATE_BACKUP - 1 )
 
 typedef struct c4clipedict_s {
@@ -62,154 +58,200 @@ typedef struct c4clipedict_s {
 	entity_shared_t r;
 } c4clipedict_t;
 
-//backups of all server frames areas and edicts
-typedef struct c4frame_s {
-	c4clipedict_t clipEdicts[MAX_EDICTS];
+// the collision relevant parts of every edict for the last CFRAME_UPDATE_BACKUP
+// server frames. anything else comes from the current edict
+typedef struct {
+	int64_t timestamps[CFRAME_UPDATE_BACKUP];
+
+	Vec3 origin[CFRAME_UPDATE_BACKUP][MAX_EDICTS];
+	Vec3 angles[CFRAME_UPDATE_BACKUP][MAX_EDICTS];
+	Vec3 mins[CFRAME_UPDATE_BACKUP][MAX_EDICTS];
+	Vec3 maxs[CFRAME_UPDATE_BACKUP][MAX_EDICTS];
+	Vec3 absmin[CFRAME_UPDATE_BACKUP][MAX_EDICTS];
+	Vec3 absmax[CFRAME_UPDATE_BACKUP][MAX_EDICTS];
+	edict_t *owner[CFRAME_UPDATE_BACKUP][MAX_EDICTS];
+	u8 solid[CFRAME_UPDATE_BACKUP][MAX_EDICTS];
+	bool inuse[CFRAME_UPDATE_BACKUP][MAX_EDICTS];
+
+	// first frame with the same solid/inuse as the latest, we can't move back past it
+	int64_t unchanged_since[MAX_EDICTS];
 	int numedicts;
+} c4history_t;
 
-	int64_t timestamp;
-	int64_t framenum;
-} c4frame_t;
-
-c4frame_t sv_collisionframes[CFRAME_UPDATE_BACKUP];
+static c4history_t sv_collisionHistory;
 static int64_t sv_collisionFrameNum = 0;
 
+static bool GClip_HasCollisionHistory( const edict_t *ent, int entNum ) {
+	if( !ent->r.inuse || ent->r.solid == SOLID_NOT ) {
+		return false;
+	}
+	return ent->r.solid != SOLID_TRIGGER || ( entNum >= 1 && entNum <= server_gs.maxclients );
+}
+
 void GClip_BackUpCollisionFrame( void ) {
-	c4frame_t *cframe;
-	edict_t *svedict;
-	int i;
+	ZoneScoped;
 
-	// fixme: should check for any validation here?
+	// lookups can happen off the main thread, so fix the cvar up here
+	if( g_antilag_maxtimedelta->integer < 0 ) {
+		Cvar_SetValue( "g_antilag_maxtimedelta", Abs( g_antilag_maxtimedelta->integer ) );
+	}
 
-	cframe = &sv_collisionframes[sv_collisionFrameNum & CFRAME_UPDATE_MASK];
-	cframe->timestamp = svs.gametime;
-	cframe->framenum = sv_collisionFrameNum;
+	c4history_t *history = &sv_collisionHistory;
+	int64_t framenum = sv_collisionFrameNum;
+	int slot = framenum & CFRAME_UPDATE_MASK;
+	int prev = ( framenum - 1 ) & CFRAME_UPDATE_MASK;
+
+	history->timestamps[slot] = svs.gametime;
 	sv_collisionFrameNum++;
 
-	//memset( cframe->clipEdicts, 0, sizeof(cframe->clipEdicts) );
+	// keep tracking edicts past numentities so we notice them coming back
+	int numedicts = Max2( game.numentities, history->numedicts );
+
+	for( int i = 0; i < numedicts; i++ ) {
+		const edict_t *svedict = &game.edicts[i];
+		u8 solid = svedict->r.solid;
+		bool inuse = svedict->r.inuse;
+
+		if( framenum == 0 || i >= history->numedicts
+			|| solid != history->solid[prev][i] || inuse != history->inuse[prev][i] ) {
+			history->unchanged_since[i] = framenum;
+		}
 
-	//backup edicts
-	for( i = 0; i < game.numentities; i++ ) {
-		svedict = &game.edicts[i];
+		history->solid[slot][i] = solid;
+		history->inuse[slot][i] = inuse;
 
-		cframe->clipEdicts[i].r.inuse = svedict->r.inuse;
-		cframe->clipEdicts[i].r.solid = svedict->r.solid;
-		if( !svedict->r.inuse || svedict->r.solid == SOLID_NOT
-			|| ( svedict->r.solid == SOLID_TRIGGER && !( i >= 1 && i <= server_gs.maxclients ) ) ) {
+		if( !GClip_HasCollisionHistory( svedict, i ) ) {
 			continue;
 		}
 
-		cframe->clipEdicts[i].r = svedict->r;
-		cframe->clipEdicts[i].s = svedict->s;
+		history->origin[slot][i] = svedict->s.origin;
+		history->angles[slot][i] = svedict->s.angles;
+		history->mins[slot][i] = svedict->r.mins;
+		history->maxs[slot][i] = svedict->r.maxs;
+		history->absmin[slot][i] = svedict->r.absmin;
+		history->absmax[slot][i] = svedict->r.absmax;
+		history->owner[slot][i] = svedict->r.owner;
 	}
-	cframe->numedicts = game.numentities;
+
+	history->numedicts = numedicts;
 }
 
-static c4clipedict_t *GClip_GetClipEdictForDeltaTime( int entNum, int deltaTime ) {
-	static int index = 0;
-	static c4clipedict_t clipEnts[8];
-	static c4clipedict_t *clipent;
-	static c4clipedict_t clipentNewer; // for interpolation
-	c4frame_t *cframe = NULL;
-	int64_t backTime, cframenum;
-	unsigned bf;
-	edict_t *ent = game.edicts + entNum;
+/*
+* GClip_FindCollisionFrame
+*
+* Returns the latest backed up frame no newer than target, or the oldest usable
+* frame if they are all newer
+*/
+static int64_t GClip_FindCollisionFrame( int64_t oldest, int64_t newest, int64_t target ) {
+	const c4history_t *history = &sv_collisionHistory;
 
-	// pick one of the 8 slots to prevent overwritings
-	clipent = &clipEnts[index];
-	index = ( index + 1 ) & 7;
+	if( history->timestamps[oldest & CFRAME_UPDATE_MASK] > target ) {
+		return oldest;
+	}
+
+	// timestamps only go up, so binary search for it
+	int64_t lo = oldest;
+	int64_t hi = newest + 1;
+	while( hi - lo > 1 ) {
+		int64_t mid = lo + ( hi - lo ) / 2;
+		if( history->timestamps[mid & CFRAME_UPDATE_MASK] <= target ) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+/*
+* GClip_GetClipEdictForDeltaTime
+*
+* Fills clipent with where entNum was deltaTime ms ago. Only reads shared
+* state, so it's safe to call from multiple threads while the game isn't
+* modifying edicts
+*/
+static void GClip_GetClipEdictForDeltaTime( int entNum, int deltaTime, c4clipedict_t *clipent ) {
+	const c4history_t *history = &sv_collisionHistory;
+	int64_t backTime;
+	const edict_t *ent = game.edicts + entNum;
+
+	clipent->r = ent->r;
+	clipent->s = ent->s;
 
 	if( !entNum || deltaTime >= 0 ) { // current time entity
-		clipent->r = ent->r;
-		clipent->s = ent->s;
-		return clipent;
+		return;
 	}
 
-	if( !ent->r.inuse || ent->r.solid == SOLID_NOT
-		|| ( ent->r.solid == SOLID_TRIGGER && !( entNum >= 1 && entNum <= server_gs.maxclients ) ) ) {
-		clipent->r = ent->r;
-		clipent->s = ent->s;
-		return clipent;
+	if( !GClip_HasCollisionHistory( ent, entNum ) ) {
+		return;
 	}
 
 	// always use the latest information about moving world brushes
 	if( ent->movetype == MOVETYPE_PUSH ) {
-		clipent->r = ent->r;
-		clipent->s = ent->s;
-		return clipent;
+		return;
 	}
 
 	// clamp delta time inside the backed up limits
 	backTime = Abs( deltaTime );
 	if( g_antilag_maxtimedelta->integer ) {
-		if( g_antilag_maxtimedelta->integer < 0 ) {
-			Cvar_SetValue( "g_antilag_maxtimedelta", Abs( g_antilag_maxtimedelta->integer ) );
-		}
-		if( backTime > (int64_t)g_antilag_maxtimedelta->integer ) {
-			backTime = (int64_t)g_antilag_maxtimedelta->integer;
-		}
+		backTime = Min2( backTime, (int64_t)Abs( g_antilag_maxtimedelta->integer ) );
 	}
 
-	// find the first snap with timestamp < than realtime - backtime
-	cframenum = sv_collisionFrameNum;
-	for( bf = 1; bf < CFRAME_UPDATE_BACKUP && bf < sv_collisionFrameNum; bf++ ) { // never overpass limits
-		cframe = &sv_collisionframes[( cframenum - bf ) & CFRAME_UPDATE_MASK];
+	// never overpass limits, and if solid has changed we can't keep moving backwards
+	int64_t newest = sv_collisionFrameNum - 1;
+	int64_t oldest = Max2( sv_collisionFrameNum - ( CFRAME_UPDATE_BACKUP - 1 ), int64_t( 1 ) );
+	oldest = Max2( oldest, history->unchanged_since[entNum] );
 
-		// if solid has changed, we can't keep moving backwards
-		if( ent->r.solid != cframe->clipEdicts[entNum].r.solid
-			|| ent->r.inuse != cframe->clipEdicts[entNum].r.inuse ) {
-			bf--;
-			if( bf == 0 ) {
-				// we can't step back from first
-				cframe = NULL;
-			} else {
-				cframe = &sv_collisionframes[( cframenum - bf ) & CFRAME_UPDATE_MASK];
-			}
-			break;
-		}
-
-		if( svs.gametime >= cframe->timestamp + backTime ) {
-			break;
-		}
-	}
-
-	if( !cframe ) {
+	if( newest < oldest || entNum >= history->numedicts
+		|| ent->r.solid != history->solid[newest & CFRAME_UPDATE_MASK][entNum]
+		|| ent->r.inuse != history->inuse[newest & CFRAME_UPDATE_MASK][entNum] ) {
 		// current time entity
-		clipent->r = ent->r;
-		clipent->s = ent->s;
-		return clipent;
+		return;
 	}
 
-	// setup with older for the data that is not interpolated
-	*clipent = cframe->clipEdicts[entNum];
+	int64_t target = svs.gametime - backTime;
+	int64_t frame = GClip_FindCollisionFrame( oldest, newest, target );
+	int slot = frame & CFRAME_UPDATE_MASK;
+
+	clipent->s.origin = history->origin[slot][entNum];
+	clipent->s.angles = history->angles[slot][entNum];
+	clipent->r.mins = history->mins[slot][entNum];
+	clipent->r.maxs = history->maxs[slot][entNum];
+	clipent->r.absmin = history->absmin[slot][entNum];
+	clipent->r.absmax = history->absmax[slot][entNum];
+	clipent->r.owner = history->owner[slot][entNum];
 
 	// if we found an older than desired backtime frame, interpolate to find a more precise position.
-	if( svs.gametime > cframe->timestamp + backTime ) {
-		float lerpFrac;
+	if( history->timestamps[slot] < target ) {
+		int64_t newerTimestamp;
+		Vec3 newerOrigin, newerAngles, newerMins, newerMaxs;
 
-		if( bf == 1 ) {
+		if( frame == newest ) {
 			// interpolate from 1st backed up to current
-			lerpFrac = (float)( ( svs.gametime - backTime ) - cframe->timestamp )
-					   / (float)( svs.gametime - cframe->timestamp );
-			clipentNewer.r = ent->r;
-			clipentNewer.s = ent->s;
+			newerTimestamp = svs.gametime;
+			newerOrigin = ent->s.origin;
+			newerAngles = ent->s.angles;
+			newerMins = ent->r.mins;
+			newerMaxs = ent->r.maxs;
 		} else {
 			// interpolate between 2 backed up
-			c4frame_t *cframeNewer = &sv_collisionframes[( cframenum - ( bf - 1 ) ) & CFRAME_UPDATE_MASK];
-			lerpFrac = (float)( ( svs.gametime - backTime ) - cframe->timestamp )
-					   / (float)( cframeNewer->timestamp - cframe->timestamp );
-			clipentNewer = cframeNewer->clipEdicts[entNum];
+			int newer = ( frame + 1 ) & CFRAME_UPDATE_MASK;
+			newerTimestamp = history->timestamps[newer];
+			newerOrigin = history->origin[newer][entNum];
+			newerAngles = history->angles[newer][entNum];
+			newerMins = history->mins[newer][entNum];
+			newerMaxs = history->maxs[newer][entNum];
 		}
 
-		// interpolate
-		clipent->s.origin = Lerp( clipent->s.origin, lerpFrac, clipentNewer.s.origin );
-		clipent->r.mins = Lerp( clipent->r.mins, lerpFrac, clipentNewer.r.mins );
-		clipent->r.maxs = Lerp( clipent->r.maxs, lerpFrac, clipentNewer.r.maxs );
-		clipent->s.angles = LerpAngles( clipent->s.angles, lerpFrac, clipentNewer.s.angles );
-	}
+		float lerpFrac = (float)( target - history->timestamps[slot] )
+						 / (float)( newerTimestamp - history->timestamps[slot] );
 
-	// back time entity
-	return clipent;
+		clipent->s.origin = Lerp( clipent->s.origin, lerpFrac, newerOrigin );
+		clipent->r.mins = Lerp( clipent->r.mins, lerpFrac, newerMins );
+		clipent->r.maxs = Lerp( clipent->r.maxs, lerpFrac, newerMaxs );
+		clipent->s.angles = LerpAngles( clipent->s.angles, lerpFrac, newerAngles );
+	}
 }
 
 // ClearLink is used for new headnodes
@@ -236,11 +278,6 @@ static void GClip_InsertLinkBefore( link_t *l, link_t *before, int entNum ) {
 * GClip_Init_AreaGrid
 */
 static void GClip_Init_AreaGrid( areagrid_t *areagrid, Vec3 world_mins, Vec3 world_maxs ) {
-	// the areagrid_marknumber is not allowed to be 0
-	if( areagrid->marknumber < 1 ) {
-		areagrid->marknumber = 1;
-	}
-
 	// choose either the world box size, or a larger box to ensure the grid isn't too fine
 	areagrid->size.x = Max2( world_maxs.x - world_mins.x, AREA_GRID * AREA_GRIDMINSIZE );
 	areagrid->size.y = Max2( world_maxs.y - world_mins.y, AREA_GRID * AREA_GRIDMINSIZE );
@@ -263,8 +300,6 @@ static void GClip_Init_AreaGrid( areagrid_t *areagrid, Vec3 world_mins, Vec3 wor
 		GClip_ClearLink( &areagrid->grid[i] );
 	}
 
-	memset( areagrid->entmarknumber, 0, sizeof( areagrid->entmarknumber ) );
-
 	if( developer->integer ) {
 		Com_Printf( "areagrid settings: divisions %ix%ix1 : box %f %f %f "
 					": %f %f %f size %f %f %f grid %f %f %f (mingrid %f)\n",
@@ -336,17 +371,18 @@ static int GClip_EntitiesInBox_AreaGrid( areagrid_t *areagrid, Vec3 mins, Vec3 m
 	int numlist;
 	link_t *grid;
 	link_t *l;
-	c4clipedict_t *clipEnt;
+	c4clipedict_t clipEnt;
 	Vec3 paddedmins, paddedmaxs;
 	int igrid[3], igridmins[3], igridmaxs[3];
 
+	// since the areagrid can have multiple references to one entity,
+	// we should avoid extensive checking on entities already encountered.
+	// kept on the stack so concurrent queries don't stomp on each other
+	u64 seen[MAX_EDICTS / 64] = { };
+
 	paddedmins = mins;
 	paddedmaxs = maxs;
 
-	// FIXME: if areagrid_marknumber wraps, all entities need their
-	// ent->priv.server->areagridmarknumber reset
-	areagrid->marknumber++;
-
 	igridmins[0] = (int) floorf( ( paddedmins.x + areagrid->bias.x ) * areagrid->scale.x );
 	igridmins[1] = (int) floorf( ( paddedmins.y + areagrid->bias.y ) * areagrid->scale.y );
 
@@ -374,25 +410,26 @@ static int GClip_EntitiesInBox_AreaGrid( areagrid_t *areagrid, Vec3 mins, Vec3 m
 	if( areagrid->outside.next ) {
 		grid = &areagrid->outside;
 		for( l = grid->next; l != grid; l = l->next ) {
-			clipEnt = GClip_GetClipEdictForDeltaTime( l->entNum, timeDelta );
-
-			if( areagrid->entmarknumber[l->entNum] == areagrid->marknumber ) {
+			u64 bit = u64( 1 ) << ( l->entNum % 64 );
+			if( seen[l->entNum / 64] & bit ) {
 				continue;
 			}
-			areagrid->entmarknumber[l->entNum] = areagrid->marknumber;
+			seen[l->entNum / 64] |= bit;
 
-			if( !clipEnt->r.inuse ) {
+			GClip_GetClipEdictForDeltaTime( l->entNum, timeDelta, &clipEnt );
+
+			if( !clipEnt.r.inuse ) {
 				continue; // deactivated
 			}
-			if( areatype == AREA_TRIGGERS && clipEnt->r.solid != SOLID_TRIGGER ) {
+			if( areatype == AREA_TRIGGERS && clipEnt.r.solid != SOLID_TRIGGER ) {
 				continue;
 			}
 			if( areatype == AREA_SOLID &&
-				( clipEnt->r.solid == SOLID_TRIGGER || clipEnt->r.solid == SOLID_NOT ) ) {
+				( clipEnt.r.solid == SOLID_TRIGGER || clipEnt.r.solid == SOLID_NOT ) ) {
 				continue;
 			}
 
-			if( BoundsOverlap( paddedmins, paddedmaxs, clipEnt->r.absmin, clipEnt->r.absmax ) ) {
+			if( BoundsOverlap( paddedmins, paddedmaxs, clipEnt.r.absmin, clipEnt.r.absmax ) ) {
 				if( numlist < maxcount ) {
 					list[numlist] = l->entNum;
 				}
@@ -411,25 +448,26 @@ static int GClip_EntitiesInBox_AreaGrid( areagrid_t *areagrid, Vec3 mins, Vec3 m
 			}
 
 			for( l = grid->next; l != grid; l = l->next ) {
-				clipEnt = GClip_GetClipEdictForDeltaTime( l->entNum, timeDelta );
-
-				if( areagrid->entmarknumber[l->entNum] == areagrid->marknumber ) {
+				u64 bit = u64( 1 ) << ( l->entNum % 64 );
+				if( seen[l->entNum / 64] & bit ) {
 					continue;
 				}
-				areagrid->entmarknumber[l->entNum] = areagrid->marknumber;
+				seen[l->entNum / 64] |= bit;
 
-				if( !clipEnt->r.inuse ) {
+				GClip_GetClipEdictForDeltaTime( l->entNum, timeDelta, &clipEnt );
+
+				if( !clipEnt.r.inuse ) {
 					continue; // deactivated
 				}
-				if( areatype == AREA_TRIGGERS && clipEnt->r.solid != SOLID_TRIGGER ) {
+				if( areatype == AREA_TRIGGERS && clipEnt.r.solid != SOLID_TRIGGER ) {
 					continue;
 				}
 				if( areatype == AREA_SOLID &&
-					( clipEnt->r.solid == SOLID_TRIGGER || clipEnt->r.solid == SOLID_NOT ) ) {
+					( clipEnt.r.solid == SOLID_TRIGGER || clipEnt.r.solid == SOLID_NOT ) ) {
 					continue;
 				}
 
-				if( BoundsOverlap( paddedmins, paddedmaxs, clipEnt->r.absmin, clipEnt->r.absmax ) ) {
+				if( BoundsOverlap( paddedmins, paddedmaxs, clipEnt.r.absmin, clipEnt.r.absmax ) ) {
 					if( numlist < maxcount ) {
 						list[numlist] = l->entNum;
 					}
@@ -456,6 +494,33 @@ void GClip_ClearWorld( void ) {
 	GClip_Init_AreaGrid( &g_areagrid, world_mins, world_maxs );
 }
 
+struct LinkChange {
+	Vec3 absmin, absmax;
+	int entNum;
+};
+
+static LinkChange link_changes[ 1024 ];
+static size_t num_link_changes;
+static bool link_changes_overflowed;
+static bool tracking_link_changes;
+
+static void GClip_RecordLinkChange( const edict_t *ent ) {
+	if( !tracking_link_changes ) {
+		return;
+	}
+
+	if( num_link_changes == ARRAY_COUNT( link_changes ) ) {
+		link_changes_overflowed = true;
+		return;
+	}
+
+	LinkChange * change = &link_changes[ num_link_changes ];
+	change->absmin = ent->r.absmin;
+	change->absmax = ent->r.absmax;
+	change->entNum = ENTNUM( ent );
+	num_link_changes++;
+}
+
 /*
 * GClip_UnlinkEntity
 * call before removing an entity, and before trying to move one,
@@ -465,6 +530,7 @@ void GClip_UnlinkEntity( edict_t *ent ) {
 	if( !ent->linked ) {
 		return; // not linked in anywhere
 	}
+	GClip_RecordLinkChange( ent );
 	GClip_UnlinkEntity_AreaGrid( ent );
 	ent->linked = false;
 }
@@ -608,6 +674,35 @@ void GClip_LinkEntity( edict_t *ent ) {
 	ent->linked = true;
 
 	GClip_LinkEntity_AreaGrid( &g_areagrid, ent );
+	GClip_RecordLinkChange( ent );
+}
+
+/*
+* GClip_TrackLinkChanges
+*
+* While it's on, every link and unlink remembers the bounds the entity left
+* or moved into, so work done against the world earlier in the frame can
+* check whether anything has moved around it since
+*/
+void GClip_TrackLinkChanges( bool track ) {
+	tracking_link_changes = track;
+	num_link_changes = 0;
+	link_changes_overflowed = false;
+}
+
+bool GClip_LinksChangedInBox( Vec3 mins, Vec3 maxs, int ignore ) {
+	if( link_changes_overflowed ) {
+		return true;
+	}
+
+	for( size_t i = 0; i < num_link_changes; i++ ) {
+		const LinkChange * change = &link_changes[ i ];
+		if( change->entNum != ignore && BoundsOverlap( mins, maxs, change->absmin, change->absmax ) ) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 /*
@@ -648,7 +743,7 @@ int GClip_AreaEdicts( Vec3 mins, Vec3 maxs, int *list, int maxcount, int areatyp
 * Returns a collision model that can be used for testing or clipping an
 * object of mins/maxs size.
 */
-static struct cmodel_s *GClip_CollisionModelForEntity( SyncEntityState *s, entity_shared_t *r ) {
+static struct cmodel_s *GClip_CollisionModelForEntity( const SyncEntityState *s, const entity_shared_t *r, BoxHull * hull ) {
 	cmodel_t * model = CM_TryFindCModel( CM_Server, s->model );
 	if( model != NULL ) {
 		return model;
@@ -656,9 +751,9 @@ static struct cmodel_s *GClip_CollisionModelForEntity( SyncEntityState *s, entit
 
 	// create a temp hull from bounding box sizes
 	if( s->type == ET_PLAYER || s->type == ET_CORPSE ) {
-		return CM_OctagonModelForBBox( svs.cms, r->mins, r->maxs );
+		return CM_OctagonModelForBBox( hull, r->mins, r->maxs );
 	} else {
-		return CM_ModelForBBox( svs.cms, r->mins, r->maxs );
+		return CM_ModelForBBox( hull, r->mins, r->maxs );
 	}
 }
 
@@ -671,7 +766,8 @@ static struct cmodel_s *GClip_CollisionModelForEntity( SyncEntityState *s, entit
 static int GClip_PointContents( Vec3 p, int timeDelta ) {
 	ZoneScoped;
 
-	c4clipedict_t *clipEnt;
+	c4clipedict_t clipEnt;
+	BoxHull hull;
 	int touch[MAX_EDICTS];
 	int i, num;
 	int contents, c2;
@@ -684,12 +780,12 @@ static int GClip_PointContents( Vec3 p, int timeDelta ) {
 	num = GClip_AreaEdicts( p, p, touch, MAX_EDICTS, AREA_SOLID, timeDelta );
 
 	for( i = 0; i < num; i++ ) {
-		clipEnt = GClip_GetClipEdictForDeltaTime( touch[i], timeDelta );
+		GClip_GetClipEdictForDeltaTime( touch[i], timeDelta, &clipEnt );
 
 		// might intersect, so do an exact clip
-		cmodel = GClip_CollisionModelForEntity( &clipEnt->s, &clipEnt->r );
+		cmodel = GClip_CollisionModelForEntity( &clipEnt.s, &clipEnt.r, &hull );
 
-		c2 = CM_TransformedPointContents( CM_Server, svs.cms, p, cmodel, clipEnt->s.origin, clipEnt->s.angles );
+		c2 = CM_TransformedPointContents( CM_Server, svs.cms, p, cmodel, clipEnt.s.origin, clipEnt.s.angles );
 		contents |= c2;
 	}
 
@@ -715,6 +811,69 @@ typedef struct {
 	int contentmask;
 } moveclip_t;
 
+/*
+* GClip_ShouldClipAgainst
+*
+* The filtering G_Trace does on everything the broadphase gives it
+*/
+static bool GClip_ShouldClipAgainst( const c4clipedict_t * touch, int passent, int contentmask ) {
+	if( passent >= 0 ) {
+		// when they are offseted in time, they can be a different pointer but be the same entity
+		if( touch->s.number == passent ) {
+			return false;
+		}
+		if( touch->r.owner && ( touch->r.owner->s.number == passent ) ) {
+			return false;
+		}
+		if( game.edicts[passent].r.owner
+			&& ( game.edicts[passent].r.owner->s.number == touch->s.number ) ) {
+			return false;
+		}
+
+		// wsw : jal : never clipmove against SVF_PROJECTILE entities
+		if( touch->r.svflags & SVF_PROJECTILE ) {
+			return false;
+		}
+	}
+
+	if( ( touch->r.svflags & SVF_CORPSE ) && !( contentmask & CONTENTS_CORPSE ) ) {
+		return false;
+	}
+
+	if( touch->r.client != NULL ) {
+		int teammask = contentmask & ( CONTENTS_TEAMALPHA | CONTENTS_TEAMBETA );
+		if( teammask != 0 ) {
+			int team = teammask == CONTENTS_TEAMALPHA ? TEAM_ALPHA : TEAM_BETA;
+			if( touch->s.team != team )
+				return false;
+		}
+	}
+
+	return true;
+}
+
+static Vec3 GClip_AnglesForEntity( const c4clipedict_t * touch ) {
+	if( CM_IsBrushModel( CM_Server, touch->s.model ) ) {
+		return touch->s.angles;
+	}
+	return Vec3( 0.0f ); // boxes don't rotate
+}
+
+/*
+* GClip_MergeTrace
+*
+* Returns true when there's no point checking any more entities
+*/
+static bool GClip_MergeTrace( trace_t * result, const trace_t * trace, int ent ) {
+	if( trace->allsolid || trace->fraction < result->fraction ) {
+		*result = *trace;
+		result->ent = ent;
+	} else if( trace->startsolid ) {
+		result->startsolid = true;
+	}
+	return result->allsolid;
+}
+
 /*
 * GClip_ClipMoveToEntities
 */
@@ -727,62 +886,23 @@ static void GClip_ClipMoveToEntities( moveclip_t *clip, int timeDelta ) {
 	// be careful, it is possible to have an entity in this
 	// list removed before we get to it (killtriggered)
 	for( int i = 0; i < num; i++ ) {
-		c4clipedict_t * touch = GClip_GetClipEdictForDeltaTime( touchlist[i], timeDelta );
-		if( clip->passent >= 0 ) {
-			// when they are offseted in time, they can be a different pointer but be the same entity
-			if( touch->s.number == clip->passent ) {
-				continue;
-			}
-			if( touch->r.owner && ( touch->r.owner->s.number == clip->passent ) ) {
-				continue;
-			}
-			if( game.edicts[clip->passent].r.owner
-				&& ( game.edicts[clip->passent].r.owner->s.number == touch->s.number ) ) {
-				continue;
-			}
-
-			// wsw : jal : never clipmove against SVF_PROJECTILE entities
-			if( touch->r.svflags & SVF_PROJECTILE ) {
-				continue;
-			}
-		}
-
-		if( ( touch->r.svflags & SVF_CORPSE ) && !( clip->contentmask & CONTENTS_CORPSE ) ) {
+		c4clipedict_t clipEnt;
+		GClip_GetClipEdictForDeltaTime( touchlist[i], timeDelta, &clipEnt );
+		const c4clipedict_t * touch = &clipEnt;
+		if( !GClip_ShouldClipAgainst( touch, clip->passent, clip->contentmask ) ) {
 			continue;
 		}
 
-		if( touch->r.client != NULL ) {
-			int teammask = clip->contentmask & ( CONTENTS_TEAMALPHA | CONTENTS_TEAMBETA );
-			if( teammask != 0 ) {
-				int team = teammask == CONTENTS_TEAMALPHA ? TEAM_ALPHA : TEAM_BETA;
-				if( touch->s.team != team )
-					continue;
-			}
-		}
-
 		// might intersect, so do an exact clip
-		struct cmodel_s * cmodel = GClip_CollisionModelForEntity( &touch->s, &touch->r );
-
-		Vec3 angles;
-		if( CM_IsBrushModel( CM_Server, touch->s.model ) ) {
-			angles = touch->s.angles;
-		} else {
-			angles = Vec3( 0.0f ); // boxes don't rotate
-
-		}
+		BoxHull hull;
+		struct cmodel_s * cmodel = GClip_CollisionModelForEntity( &touch->s, &touch->r, &hull );
 
 		trace_t trace;
 		CM_TransformedBoxTrace( CM_Server, svs.cms, &trace, clip->start, clip->end,
 									 clip->mins, clip->maxs, cmodel, clip->contentmask,
-									 touch->s.origin, angles );
+									 touch->s.origin, GClip_AnglesForEntity( touch ) );
 
-		if( trace.allsolid || trace.fraction < clip->trace->fraction ) {
-			trace.ent = touch->s.number;
-			*( clip->trace ) = trace;
-		} else if( trace.startsolid ) {
-			clip->trace->startsolid = true;
-		}
-		if( clip->trace->allsolid ) {
+		if( GClip_MergeTrace( clip->trace, &trace, touch->s.number ) ) {
 			return;
 		}
 	}
@@ -802,6 +922,24 @@ static void GClip_TraceBounds( Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, Vec3
 	}
 }
 
+/*
+* GClip_ClipMoveToWorld
+*
+* Returns false if the move is completely blocked by the world
+*/
+static bool GClip_ClipMoveToWorld( trace_t * tr, Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, const edict_t * passedict, int contentmask ) {
+	if( passedict == world ) {
+		memset( tr, 0, sizeof( trace_t ) );
+		tr->fraction = 1;
+		tr->ent = -1;
+		return true;
+	}
+
+	CM_TransformedBoxTrace( CM_Server, svs.cms, tr, start, end, mins, maxs, NULL, contentmask, Vec3( 0.0f ), Vec3( 0.0f ) );
+	tr->ent = tr->fraction < 1.0 ? world->s.number : -1;
+	return tr->fraction != 0;
+}
+
 /*
 * G_Trace
 *
@@ -829,17 +967,8 @@ static void GClip_Trace( trace_t *tr, Vec3 start, Vec3 mins, Vec3 maxs,
 		return;
 	}
 
-	if( passedict == world ) {
-		memset( tr, 0, sizeof( trace_t ) );
-		tr->fraction = 1;
-		tr->ent = -1;
-	} else {
-		// clip to world
-		CM_TransformedBoxTrace( CM_Server, svs.cms, tr, start, end, mins, maxs, NULL, contentmask, Vec3( 0.0f ), Vec3( 0.0f ) );
-		tr->ent = tr->fraction < 1.0 ? world->s.number : -1;
-		if( tr->fraction == 0 ) {
-			return; // blocked by the world
-		}
+	if( !GClip_ClipMoveToWorld( tr, start, mins, maxs, end, passedict, contentmask ) ) {
+		return; // blocked by the world
 	}
 
 	memset( &clip, 0, sizeof( moveclip_t ) );
@@ -866,9 +995,216 @@ void G_Trace4D( trace_t *tr, Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, edict_t
 	GClip_Trace( tr, start, mins, maxs, end, passedict, contentmask, timeDelta );
 }
 
+struct TraceBatchCandidate {
+	int ent;
+	Vec3 absmin, absmax;
+	Vec3 origin, angles;
+	struct cmodel_s * cmodel;
+	BoxHull hull;
+};
+
+struct TraceBatch {
+	Span< const TraceBatchCandidate > candidates;
+	const edict_t * passedict;
+	int contentmask;
+};
+
+struct TraceBatchJob {
+	const TraceBatch * batch;
+	BatchedTrace * trace;
+};
+
+// below this it's quicker to do them all on the calling thread
+constexpr size_t MIN_PARALLEL_TRACE_BATCH = 64;
+
+static void GClip_TraceBatchNarrowphase( const TraceBatch * batch, BatchedTrace * t ) {
+	if( !GClip_ClipMoveToWorld( &t->trace, t->start, t->mins, t->maxs, t->end, batch->passedict, batch->contentmask ) ) {
+		return;
+	}
+
+	Vec3 boxmins, boxmaxs;
+	GClip_TraceBounds( t->start, t->mins, t->maxs, t->end, &boxmins, &boxmaxs );
+
+	for( const TraceBatchCandidate & candidate : batch->candidates ) {
+		// same test the broadphase would have done for this trace alone
+		if( !BoundsOverlap( boxmins, boxmaxs, candidate.absmin, candidate.absmax ) ) {
+			continue;
+		}
+
+		trace_t trace;
+		CM_TransformedBoxTrace( CM_Server, svs.cms, &trace, t->start, t->end, t->mins, t->maxs,
+			candidate.cmodel, batch->contentmask, candidate.origin, candidate.angles );
+
+		if( GClip_MergeTrace( &t->trace, &trace, candidate.ent ) ) {
+			return;
+		}
+	}
+}
+
+static void GClip_TraceBatchJob( TempAllocator * temp, void * data ) {
+	const TraceBatchJob * job = ( const TraceBatchJob * ) data;
+	GClip_TraceBatchNarrowphase( job->batch, job->trace );
+}
+
+/*
+* G_TraceBatch
+*
+* Does the same thing as calling G_Trace on every element of traces, but the
+* traces share one broadphase query and one set of entity collision models,
+* and big batches run on the thread pool.
+*
+* The only difference from individual traces is which entity wins when a
+* trace hits two of them at exactly the same fraction.
+*/
+
+void G_TraceBatch4D( Span< BatchedTrace > traces, edict_t * passedict, int contentmask, int timeDelta ) {
+	ZoneScoped;
+
+	if( traces.n == 0 ) {
+		return;
+	}
+
+	Vec3 boxmins, boxmaxs;
+	ClearBounds( &boxmins, &boxmaxs );
+	for( const BatchedTrace & t : traces ) {
+		Vec3 trace_mins, trace_maxs;
+		GClip_TraceBounds( t.start, t.mins, t.maxs, t.end, &trace_mins, &trace_maxs );
+		AddPointToBounds( trace_mins, &boxmins, &boxmaxs );
+		AddPointToBounds( trace_maxs, &boxmins, &boxmaxs );
+	}
+
+	int touchlist[MAX_EDICTS];
+	int num = Min2( GClip_AreaEdicts( boxmins, boxmaxs, touchlist, MAX_EDICTS, AREA_SOLID, timeDelta ), MAX_EDICTS );
+
+	// only ever called from the main thread, so the frame arena is safe here
+	TempAllocator temp = svs.frame_arena.temp();
+	TraceBatchCandidate * candidates = ALLOC_MANY( &temp, TraceBatchCandidate, num );
+
+	int passent = passedict ? ENTNUM( passedict ) : -1;
+	size_t num_candidates = 0;
+	for( int i = 0; i < num; i++ ) {
+		c4clipedict_t clipEnt;
+		GClip_GetClipEdictForDeltaTime( touchlist[i], timeDelta, &clipEnt );
+		if( !GClip_ShouldClipAgainst( &clipEnt, passent, contentmask ) ) {
+			continue;
+		}
+
+		TraceBatchCandidate * candidate = &candidates[ num_candidates ];
+		candidate->ent = clipEnt.s.number;
+		candidate->absmin = clipEnt.r.absmin;
+		candidate->absmax = clipEnt.r.absmax;
+		candidate->origin = clipEnt.s.origin;
+		candidate->angles = GClip_AnglesForEntity( &clipEnt );
+		candidate->cmodel = GClip_CollisionModelForEntity( &clipEnt.s, &clipEnt.r, &candidate->hull );
+		num_candidates++;
+	}
+
+	TraceBatch batch;
+	batch.candidates = Span< const TraceBatchCandidate >( candidates, num_candidates );
+	batch.passedict = passedict;
+	batch.contentmask = contentmask;
+
+	if( traces.n < MIN_PARALLEL_TRACE_BATCH ) {
+		for( BatchedTrace & t : traces ) {
+			GClip_TraceBatchNarrowphase( &batch, &t );
+		}
+		return;
+	}
+
+	TraceBatchJob * jobs = ALLOC_MANY( &temp, TraceBatchJob, traces.n );
+
+	for( size_t i = 0; i < traces.n; i++ ) {
+		jobs[ i ].batch = &batch;
+		jobs[ i ].trace = &traces[ i ];
+	}
+
+	ParallelFor( Span< TraceBatchJob >( jobs, traces.n ), GClip_TraceBatchJob );
+}
+
+void G_TraceBatch( Span< BatchedTrace > traces, edict_t * passedict, int contentmask ) {
+	G_TraceBatch4D( traces, passedict, contentmask, 0 );
+}
+
+/*
+* G_TraceBatchBenchmark_f
+*
+* Usage: tracebatchbench [batches] [traces per batch]
+* Compares G_TraceBatch against the same traces done one at a time with
+* G_Trace, fanned out from random points like shotgun pellets or splash checks
+*/
+void G_TraceBatchBenchmark_f() {
+	if( svs.cms == NULL ) {
+		Com_Printf( "No map loaded\n" );
+		return;
+	}
+
+	int num_batches = Cmd_Argc() > 1 ? Max2( 1, atoi( Cmd_Argv( 1 ) ) ) : 1000;
+	int batch_size = Cmd_Argc() > 2 ? Max2( 1, atoi( Cmd_Argv( 2 ) ) ) : 16;
+	size_t num_traces = size_t( num_batches ) * size_t( batch_size );
+
+	BatchedTrace * traces = ALLOC_MANY( sys_allocator, BatchedTrace, num_traces );
+	trace_t * expected = ALLOC_MANY( sys_allocator, trace_t, num_traces );
+	defer { FREE( sys_allocator, traces ); };
+	defer { FREE( sys_allocator, expected ); };
+
+	RNG rng = new_rng( 1, 1 );
+	Vec3 world_mins = svs.cms->world_mins;
+	Vec3 world_maxs = svs.cms->world_maxs;
+
+	for( int i = 0; i < num_batches; i++ ) {
+		Vec3 start;
+		for( int j = 0; j < 3; j++ ) {
+			start[ j ] = random_uniform_float( &rng, world_mins[ j ], world_maxs[ j ] );
+		}
+
+		bool box = random_p( &rng, 0.25f );
+
+		for( int j = 0; j < batch_size; j++ ) {
+			BatchedTrace * t = &traces[ i * batch_size + j ];
+			t->start = start;
+			t->end = start + Vec3( random_float11( &rng ), random_float11( &rng ), random_float11( &rng ) ) * 1024.0f;
+			t->mins = box ? Vec3( -8.0f ) : Vec3( 0.0f );
+			t->maxs = box ? Vec3( 8.0f ) : Vec3( 0.0f );
+		}
+	}
+
+	u64 single_start = Sys_Microseconds();
+	for( size_t i = 0; i < num_traces; i++ ) {
+		const BatchedTrace * t = &traces[ i ];
+		G_Trace( &expected[ i ], t->start, t->mins, t->maxs, t->end, NULL, MASK_SHOT );
+	}
+	u64 single_time = Sys_Microseconds() - single_start;
+
+	u64 batch_start = Sys_Microseconds();
+	for( int i = 0; i < num_batches; i++ ) {
+		G_TraceBatch( Span< BatchedTrace >( traces + i * batch_size, batch_size ), NULL, MASK_SHOT );
+	}
+	u64 batch_time = Sys_Microseconds() - batch_start;
+
+	u32 mismatches = 0;
+	for( size_t i = 0; i < num_traces; i++ ) {
+		const trace_t * a = &traces[ i ].trace;
+		const trace_t * b = &expected[ i ];
+		if( a->fraction != b->fraction || a->endpos != b->endpos || a->startsolid != b->startsolid || a->allsolid != b->allsolid ) {
+			mismatches++;
+		}
+	}
+
+	Com_Printf( "%d batches of %d traces, single %.2fms, batched %.2fms\n",
+		num_batches, batch_size, single_time / 1000.0, batch_time / 1000.0 );
+
+	if( mismatches == 0 ) {
+		Com_Printf( "All batched traces matched\n" );
+	}
+	else {
+		Com_Printf( S_COLOR_RED "%u batched traces didn't match!\n", mismatches );
+	}
+}
+
 bool IsHeadshot( int entNum, Vec3 hit, int timeDelta ) {
-	const c4clipedict_t * clip = GClip_GetClipEdictForDeltaTime( entNum, timeDelta );
-	return clip->r.absmax.z - hit.z <= 16.0f;
+	c4clipedict_t clip;
+	GClip_GetClipEdictForDeltaTime( entNum, timeDelta, &clip );
+	return clip.r.absmax.z - hit.z <= 16.0f;
 }
 
 //===========================================================================
@@ -889,7 +1225,7 @@ void GClip_SetBrushModel( edict_t * ent ) {
 /*
 * GClip_EntityContact
 */
-bool GClip_EntityContact( Vec3 mins, Vec3 maxs, edict_t *ent ) {
+bool GClip_EntityContact( Vec3 mins, Vec3 maxs, const edict_t *ent ) {
 	cmodel_t * model = CM_TryFindCModel( CM_Server, ent->s.model );
 	if( model != NULL ) {
 		trace_t tr;
@@ -939,6 +1275,31 @@ void GClip_TouchTriggers( edict_t *ent ) {
 	}
 }
 
+// expand the search bounds to include the space between the previous and current origin
+static void GClip_PMoveTriggerBounds( const pmove_t *pm, Vec3 previous_origin, Vec3 * mins, Vec3 * maxs ) {
+	for( int i = 0; i < 3; i++ ) {
+		if( previous_origin[i] < pm->playerState->pmove.origin[i] ) {
+			( *mins )[i] = Min2( previous_origin[i] + pm->maxs[i], pm->playerState->pmove.origin[i] + pm->mins[i] );
+			( *maxs )[i] = pm->playerState->pmove.origin[i] + pm->maxs[i];
+		} else {
+			( *mins )[i] = pm->playerState->pmove.origin[i] + pm->mins[i];
+			( *maxs )[i] = Max2( previous_origin[i] + pm->mins[i], pm->playerState->pmove.origin[i] + pm->maxs[i] );
+		}
+	}
+}
+
+static bool GClip_CanTouchTrigger( const edict_t *hit, Vec3 mins, Vec3 maxs ) {
+	if( !hit->r.inuse ) {
+		return false;
+	}
+
+	if( !hit->touch && !hit->asTouchFunc ) {
+		return false;
+	}
+
+	return hit->item || GClip_EntityContact( mins, maxs, hit );
+}
+
 void G_PMoveTouchTriggers( pmove_t *pm, Vec3 previous_origin ) {
 	if( pm->playerState->POVnum <= 0 || (int)pm->playerState->POVnum > server_gs.maxclients ) {
 		return;
@@ -968,17 +1329,8 @@ void G_PMoveTouchTriggers( pmove_t *pm, Vec3 previous_origin ) {
 
 	GClip_LinkEntity( ent );
 
-	// expand the search bounds to include the space between the previous and current origin
 	Vec3 mins, maxs;
-	for( int i = 0; i < 3; i++ ) {
-		if( previous_origin[i] < pm->playerState->pmove.origin[i] ) {
-			mins[i] = Min2( previous_origin[i] + pm->maxs[i], pm->playerState->pmove.origin[i] + pm->mins[i] );
-			maxs[i] = pm->playerState->pmove.origin[i] + pm->maxs[i];
-		} else {
-			mins[i] = pm->playerState->pmove.origin[i] + pm->mins[i];
-			maxs[i] = Max2( previous_origin[i] + pm->mins[i], pm->playerState->pmove.origin[i] + pm->maxs[i] );
-		}
-	}
+	GClip_PMoveTriggerBounds( pm, previous_origin, &mins, &maxs );
 
 	int touch[MAX_EDICTS];
 	int num = GClip_AreaEdicts( mins, maxs, touch, MAX_EDICTS, AREA_TRIGGERS, 0 );
@@ -987,20 +1339,32 @@ void G_PMoveTouchTriggers( pmove_t *pm, Vec3 previous_origin ) {
 	// list removed before we get to it (killtriggered)
 	for( int i = 0; i < num; i++ ) {
 		edict_t *hit = &game.edicts[touch[i]];
-		if( !hit->r.inuse ) {
-			continue;
+		if( GClip_CanTouchTrigger( hit, mins, maxs ) ) {
+			G_CallTouch( hit, ent, NULL, 0 );
 		}
+	}
+}
 
-		if( !hit->touch && !hit->asTouchFunc ) {
-			continue;
-		}
+/*
+* G_PMoveWouldTouchTriggers
+*
+* Read only version of G_PMoveTouchTriggers that's safe to call from other
+* threads. Returns the bounds it checked so the caller can tell if triggers
+* have been moved into them since
+*/
+bool G_PMoveWouldTouchTriggers( const pmove_t *pm, Vec3 previous_origin, Vec3 * mins, Vec3 * maxs ) {
+	GClip_PMoveTriggerBounds( pm, previous_origin, mins, maxs );
 
-		if( !hit->item && !GClip_EntityContact( mins, maxs, hit ) ) {
-			continue;
-		}
+	int touch[MAX_EDICTS];
+	int num = GClip_AreaEdicts( *mins, *maxs, touch, MAX_EDICTS, AREA_TRIGGERS, 0 );
 
-		G_CallTouch( hit, ent, NULL, 0 );
+	for( int i = 0; i < num; i++ ) {
+		if( GClip_CanTouchTrigger( &game.edicts[touch[i]], *mins, *maxs ) ) {
+			return true;
+		}
 	}
+
+	return false;
 }
 
 /*
@@ -1044,20 +1408,26 @@ int GClip_FindInRadius( Vec3 org, float rad, int *list, int maxcount ) {
 }
 
 void G_SplashFrac4D( const edict_t *ent, Vec3 hitpoint, float maxradius, Vec3 * pushdir, float *frac, int timeDelta, bool selfdamage ) {
-	const c4clipedict_t *clipEnt = GClip_GetClipEdictForDeltaTime( ENTNUM( ent ), timeDelta );
-	G_SplashFrac( &clipEnt->s, &clipEnt->r, hitpoint, maxradius, pushdir, frac, selfdamage );
+	c4clipedict_t clipEnt;
+	GClip_GetClipEdictForDeltaTime( ENTNUM( ent ), timeDelta, &clipEnt );
+	G_SplashFrac( &clipEnt.s, &clipEnt.r, hitpoint, maxradius, pushdir, frac, selfdamage );
 }
 
+/*
+* G_GetEntityStateForDeltaTime
+*
+* This is gs.api.GetEntityState, which Pmove calls from the thread pool, so it
+* can only hand out the present state straight from the edict. Nothing asks
+* for the past here; use GClip_GetClipEdictForDeltaTime with your own storage
+* for that
+*/
 SyncEntityState *G_GetEntityStateForDeltaTime( int entNum, int deltaTime ) {
-	c4clipedict_t *clipEnt;
-
 	if( entNum == -1 ) {
 		return NULL;
 	}
 
 	assert( entNum >= 0 && entNum < MAX_EDICTS );
+	assert( deltaTime >= 0 );
 
-	clipEnt = GClip_GetClipEdictForDeltaTime( entNum, deltaTime );
-
-	return &clipEnt->s;
+	return &game.edicts[entNum].s;
 }
@@ -61,42 +61,34 @@ static bool G_CanSplashDamage( edict_t *targ, edict_t *inflictor, cplane_t *plan
 		origin = inflictor->s.origin + plane->normal * 9;
 	}
 
-	// This is for players
+	// This is for players, check the middle first since it almost always
+	// passes, then the four corners together
 	G_Trace4D( &trace, origin, Vec3( 0.0f ), Vec3( 0.0f ), targ->s.origin, inflictor, solidmask, inflictor->timeDelta );
 	if( trace.fraction >= 1.0 - SPLASH_DAMAGE_TRACE_FRAC_EPSILON || trace.ent == ENTNUM( targ ) ) {
 		return true;
 	}
 
-	dest = targ->s.origin;
-	dest.x += 15.0;
-	dest.y += 15.0;
-	G_Trace4D( &trace, origin, Vec3( 0.0f ), Vec3( 0.0f ), dest, inflictor, solidmask, inflictor->timeDelta );
-	if( trace.fraction >= 1.0 - SPLASH_DAMAGE_TRACE_FRAC_EPSILON || trace.ent == ENTNUM( targ ) ) {
-		return true;
-	}
+	constexpr Vec2 corners[] = {
+		Vec2( 15.0f, 15.0f ),
+		Vec2( 15.0f, -15.0f ),
+		Vec2( -15.0f, 15.0f ),
+		Vec2( -15.0f, -15.0f ),
+	};
 
-	dest = targ->s.origin;
-	dest.x += 15.0;
-	dest.y -= 15.0;
-	G_Trace4D( &trace, origin, Vec3( 0.0f ), Vec3( 0.0f ), dest, inflictor, solidmask, inflictor->timeDelta );
-	if( trace.fraction >= 1.0 - SPLASH_DAMAGE_TRACE_FRAC_EPSILON || trace.ent == ENTNUM( targ ) ) {
-		return true;
+	BatchedTrace traces[ ARRAY_COUNT( corners ) ];
+	for( size_t i = 0; i < ARRAY_COUNT( corners ); i++ ) {
+		traces[ i ].start = origin;
+		traces[ i ].end = targ->s.origin + Vec3( corners[ i ], 0.0f );
+		traces[ i ].mins = Vec3( 0.0f );
+		traces[ i ].maxs = Vec3( 0.0f );
 	}
 
-	dest = targ->s.origin;
-	dest.x -= 15.0;
-	dest.y += 15.0;
-	G_Trace4D( &trace, origin, Vec3( 0.0f ), Vec3( 0.0f ), dest, inflictor, solidmask, inflictor->timeDelta );
-	if( trace.fraction >= 1.0 - SPLASH_DAMAGE_TRACE_FRAC_EPSILON || trace.ent == ENTNUM( targ ) ) {
-		return true;
-	}
+	G_TraceBatch4D( Span< BatchedTrace >( traces, ARRAY_COUNT( traces ) ), inflictor, solidmask, inflictor->timeDelta );
 
-	dest = targ->s.origin;
-	dest.x -= 15.0;
-	dest.y -= 15.0;
-	G_Trace4D( &trace, origin, Vec3( 0.0f ), Vec3( 0.0f ), dest, inflictor, solidmask, inflictor->timeDelta );
-	if( trace.fraction >= 1.0 - SPLASH_DAMAGE_TRACE_FRAC_EPSILON || trace.ent == ENTNUM( targ ) ) {
-		return true;
+	for( const BatchedTrace & t : traces ) {
+		if( t.trace.fraction >= 1.0 - SPLASH_DAMAGE_TRACE_FRAC_EPSILON || t.trace.ent == ENTNUM( targ ) ) {
+			return true;
+		}
 	}
 
 	return false;
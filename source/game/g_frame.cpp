@@ -438,6 +438,10 @@ static void G_RunEntities( void ) {
 static void G_RunClients( void ) {
 	ZoneScoped;
 
+	TempAllocator temp = svs.frame_arena.temp();
+	G_SpeculateClientMoves( &temp );
+	defer { G_ClearSpeculatedClientMoves(); };
+
 	for( int i = 0; i < server_gs.maxclients; i++ ) {
 		edict_t *ent = game.edicts + 1 + i;
 		if( !ent->r.inuse ) {
@@ -217,6 +217,7 @@ extern cvar_t *g_respawn_delay_min;
 extern cvar_t *g_respawn_delay_max;
 extern cvar_t *g_deadbody_followkiller;
 extern cvar_t *g_antilag_timenudge;
+extern cvar_t *g_parallel_clientmoves;
 extern cvar_t *g_antilag_maxtimedelta;
 
 extern cvar_t *g_teams_maxplayers;
@@ -475,8 +476,22 @@ typedef struct link_s {
 
 int G_PointContents( Vec3 p );
 void G_Trace( trace_t *tr, Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, edict_t *passedict, int contentmask );
+
+// the 4D queries only write to their arguments, so they don't clobber each other's results
 int G_PointContents4D( Vec3 p, int timeDelta );
 void G_Trace4D( trace_t *tr, Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, edict_t *passedict, int contentmask, int timeDelta );
+
+struct BatchedTrace {
+	Vec3 start, end;
+	Vec3 mins, maxs;
+	trace_t trace;
+};
+
+// many traces sharing a passedict, contentmask and time offset
+void G_TraceBatch( Span< BatchedTrace > traces, edict_t *passedict, int contentmask );
+void G_TraceBatch4D( Span< BatchedTrace > traces, edict_t *passedict, int contentmask, int timeDelta );
+void G_TraceBatchBenchmark_f();
+
 void GClip_BackUpCollisionFrame( void );
 int GClip_FindInRadius4D( Vec3 org, float rad, int *list, int maxcount, int timeDelta );
 void G_SplashFrac4D( const edict_t *ent, Vec3 hitpoint, float maxradius, Vec3 * pushdir, float *frac, int timeDelta, bool selfdamage );
@@ -484,9 +499,12 @@ void GClip_ClearWorld( void );
 void GClip_SetBrushModel( edict_t * ent );
 void GClip_SetAreaPortalState( edict_t *ent, bool open );
 void GClip_LinkEntity( edict_t *ent );
+void GClip_TrackLinkChanges( bool track );
+bool GClip_LinksChangedInBox( Vec3 mins, Vec3 maxs, int ignore );
 void GClip_UnlinkEntity( edict_t *ent );
 void GClip_TouchTriggers( edict_t *ent );
 void G_PMoveTouchTriggers( pmove_t *pm, Vec3 previous_origin );
+bool G_PMoveWouldTouchTriggers( const pmove_t *pm, Vec3 previous_origin, Vec3 * mins, Vec3 * maxs );
 SyncEntityState *G_GetEntityStateForDeltaTime( int entNum, int deltaTime );
 int GClip_FindInRadius( Vec3 org, float rad, int *list, int maxcount );
 
@@ -498,7 +516,7 @@ bool IsHeadshot( int entNum, Vec3 hit, int timeDelta );
 #define AREA_SOLID      1
 #define AREA_TRIGGERS   2
 int GClip_AreaEdicts( Vec3 mins, Vec3 maxs, int *list, int maxcount, int areatype, int timeDelta );
-bool GClip_EntityContact( Vec3 mins, Vec3 maxs, edict_t *ent );
+bool GClip_EntityContact( Vec3 mins, Vec3 maxs, const edict_t *ent );
 
 //
 // g_combat.c
@@ -554,7 +572,10 @@ void G_ClientClearStats( edict_t *ent );
 void G_GhostClient( edict_t *self );
 void ClientThink( edict_t *ent, usercmd_t *cmd, int timeDelta );
 void G_ClientThink( edict_t *ent );
+void G_SpeculateClientMoves( TempAllocator * temp );
+void G_ClearSpeculatedClientMoves();
 void G_CheckClientRespawnClick( edict_t *ent );
+void G_PmoveDeterminismTest_f();
 bool ClientConnect( edict_t *ent, char *userinfo, bool fakeClient );
 void ClientDisconnect( edict_t *ent, const char *reason );
 void ClientBegin( edict_t *ent );
@@ -806,6 +827,8 @@ struct gclient_s {
 
 	pmove_state_t old_pmove;    // for detecting out-of-pmove changes
 
+	struct ClientMoveSpeculation *move_speculation; // see G_SpeculateClientMoves
+
 	int asRefCount, asFactored;
 };
 
@@ -59,6 +59,7 @@ cvar_t *g_maxtimeouts;
 cvar_t *g_antilag;
 cvar_t *g_antilag_maxtimedelta;
 cvar_t *g_antilag_timenudge;
+cvar_t *g_parallel_clientmoves;
 cvar_t *g_autorecord;
 cvar_t *g_autorecord_maxdemos;
 
@@ -169,6 +170,7 @@ void G_Init( unsigned int framemsec ) {
 	g_antilag_maxtimedelta->modified = true;
 	g_antilag_timenudge = Cvar_Get( "g_antilag_timenudge", "0", CVAR_ARCHIVE );
 	g_antilag_timenudge->modified = true;
+	g_parallel_clientmoves = Cvar_Get( "g_parallel_clientmoves", "1", CVAR_ARCHIVE );
 
 	g_allow_spectator_voting = Cvar_Get( "g_allow_spectator_voting", "1", CVAR_ARCHIVE );
 
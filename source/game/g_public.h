@@ -73,6 +73,7 @@ typedef struct {
 	void ( *DropClient )( struct edict_s *ent, int type, const char *message );
 	int ( *GetClientState )( int numClient );
 	void ( *ExecuteClientThinks )( int clientNum );
+	int ( *PendingClientThinks )( int clientNum, usercmd_t *cmds, int maxcmds );
 
 	// The edict array is allocated in the game dll so it
 	// can vary in size from one game to another.
@@ -21,6 +21,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "qcommon/base.h"
 #include "qcommon/compression.h"
 #include "qcommon/cmodel.h"
+#include "qcommon/pack.h"
 #include "game/g_local.h"
 
 enum EntityFieldType {
@@ -560,11 +561,25 @@ void G_LoadMap( const char * name ) {
 	const char * path = temp( "maps/{}.bsp", name );
 	u8 * buf;
 	int length = FS_LoadFile( path, ( void ** ) &buf, NULL, 0 );
+	defer { FS_FreeFile( buf ); };
+
+	Span< const u8 > compressed = Span< const u8 >( buf, length );
+	Span< const u8 > packed;
+	bool packed_allocated = false;
+	defer {
+		if( packed_allocated ) {
+			FREE( sys_allocator, const_cast< u8 * >( packed.ptr ) );
+		}
+	};
+
 	if( buf == NULL ) {
-		Com_Error( ERR_FATAL, "Couldn't load %s", path );
+		const PackedFile * file = FindPackedFile( Hash64( path ) );
+		if( file == NULL || !ReadPackedFile( file, sys_allocator, &packed, &packed_allocated ) ) {
+			Com_Error( ERR_FATAL, "Couldn't load %s", path );
+		}
+		compressed = packed;
 	}
 
-	Span< const u8 > compressed = Span< const u8 >( buf, length );
 	Span< u8 > decompressed;
 	defer { FREE( sys_allocator, decompressed.ptr ); };
 	bool ok = Decompress( path, sys_allocator, compressed, &decompressed );
@@ -578,8 +593,6 @@ void G_LoadMap( const char * name ) {
 
 	server_gs.gameState.map = StringHash( base_hash );
 	server_gs.gameState.map_checksum = svs.cms->checksum;
-
-	FS_FreeFile( buf );
 }
 
 // TODO: game module init is a mess and I'm not sure how to clean this up
@@ -356,6 +356,9 @@ void G_AddServerCommands( void ) {
 	Cmd_AddCommand( "writeip", Cmd_WriteIP_f );
 
 	Cmd_AddCommand( "dumpASapi", G_asDumpAPI_f );
+
+	Cmd_AddCommand( "tracebatchbench", G_TraceBatchBenchmark_f );
+	Cmd_AddCommand( "pmovetest", G_PmoveDeterminismTest_f );
 }
 
 /*
@@ -377,4 +380,7 @@ void G_RemoveCommands( void ) {
 	Cmd_RemoveCommand( "writeip" );
 
 	Cmd_RemoveCommand( "dumpASapi" );
+
+	Cmd_RemoveCommand( "tracebatchbench" );
+	Cmd_RemoveCommand( "pmovetest" );
 }
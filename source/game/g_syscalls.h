@@ -48,6 +48,10 @@ static inline void trap_ExecuteClientThinks( int clientNum ) {
 	GAME_IMPORT.ExecuteClientThinks( clientNum );
 }
 
+static inline int trap_PendingClientThinks( int clientNum, usercmd_t *cmds, int maxcmds ) {
+	return GAME_IMPORT.PendingClientThinks( clientNum, cmds, maxcmds );
+}
+
 static inline void trap_DropClient( edict_t *ent, int type, const char *message ) {
 	GAME_IMPORT.DropClient( ent, type, message );
 }
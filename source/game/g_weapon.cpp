@@ -238,18 +238,27 @@ static void W_Fire_Blade( edict_t * self, Vec3 start, Vec3 angles, int timeDelta
 		mask = MASK_SOLID;
 	}
 
+	BatchedTrace slashes[ 64 ];
+	Vec3 dirs[ ARRAY_COUNT( slashes ) ];
+	traces = Min2( traces, int( ARRAY_COUNT( slashes ) ) );
+
 	for( int i = 0; i < traces; i++ ) {
 		Vec3 new_angles = angles;
 		angles.y += Lerp( -slash_angle, float( i ) / float( traces - 1 ), slash_angle );
 
-		Vec3 dir;
-		AngleVectors( new_angles, &dir, NULL, NULL );
-		Vec3 end = start + dir * def->range;
+		AngleVectors( new_angles, &dirs[ i ], NULL, NULL );
+		slashes[ i ].start = start;
+		slashes[ i ].end = start + dirs[ i ] * def->range;
+		slashes[ i ].mins = Vec3( 0.0f );
+		slashes[ i ].maxs = Vec3( 0.0f );
+	}
+
+	G_TraceBatch4D( Span< BatchedTrace >( slashes, traces ), self, mask, timeDelta );
 
-		trace_t trace;
-		G_Trace4D( &trace, start, Vec3( 0.0f ), Vec3( 0.0f ), end, self, mask, timeDelta );
-		if( trace.ent != -1 && game.edicts[trace.ent].takedamage ) {
-			G_Damage( &game.edicts[trace.ent], self, self, dir, dir, trace.endpos, def->damage, def->knockback, dmgflags, MOD_GUNBLADE );
+	for( int i = 0; i < traces; i++ ) {
+		const trace_t * trace = &slashes[ i ].trace;
+		if( trace->ent != -1 && game.edicts[trace->ent].takedamage ) {
+			G_Damage( &game.edicts[trace->ent], self, self, dirs[ i ], dirs[ i ], trace->endpos, def->damage, def->knockback, dmgflags, MOD_GUNBLADE );
 			break;
 		}
 	}
@@ -18,6 +18,9 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 
 #include "game/g_local.h"
+#include "qcommon/array.h"
+#include "qcommon/cmodel.h"
+#include "qcommon/threadpool.h"
 
 #define PLAYER_MASS 200
 
@@ -928,6 +931,325 @@ static void ClientMakePlrkeys( gclient_t *client, usercmd_t *ucmd ) {
 	}
 }
 
+static void ClientSetPmoveType( const edict_t *ent, SyncPlayerState *ps ) {
+	ps->pmove.gravity = level.gravity;
+
+	if( GS_MatchState( &server_gs ) >= MATCH_STATE_POSTMATCH || GS_MatchPaused( &server_gs )
+		|| ( ent->movetype != MOVETYPE_PLAYER && ent->movetype != MOVETYPE_NOCLIP ) ) {
+		ps->pmove.pm_type = PM_FREEZE;
+	} else if( ent->movetype == MOVETYPE_NOCLIP ) {
+		ps->pmove.pm_type = PM_SPECTATOR;
+	} else {
+		ps->pmove.pm_type = PM_NORMAL;
+	}
+}
+
+/*
+ * Client move speculation
+ *
+ * Pmove is most of the cost of running a client's usercmds, and only reads
+ * the world and the client's own state until it touches triggers, so before
+ * the clients think one after another we run every client's pending
+ * usercmds through Pmove at the same time on the thread pool.
+ *
+ * ClientThink then takes each speculated result in place of calling Pmove,
+ * as long as it's still the move Pmove would have made: the client has to
+ * be in exactly the state the speculation started from, and nothing can have
+ * been linked or unlinked anywhere its traces looked, so a client that gets
+ * shot, pushed or blocked by someone who moved first just falls back to
+ * running Pmove like before. Speculation for a client stops at the first move
+ * that would touch a trigger, since those can do anything.
+ */
+
+constexpr int MAX_SPECULATED_EVENTS = 8;
+constexpr int MAX_SPECULATED_MOVES = 8; // per client, the rest run serially so this fits in the frame arena
+
+struct SpeculatedEvent {
+	int ev;
+	u64 parm;
+};
+
+struct SpeculatedMove {
+	usercmd_t cmd;
+
+	// what Pmove read
+	pmove_state_t pmove_in;
+	Vec3 viewangles_in;
+	float viewheight_in;
+	WeaponType weapon_in;
+	bool paused;
+
+	// and what it did
+	pmove_t pm;
+	pmove_state_t pmove_out;
+	Vec3 viewangles_out;
+	float viewheight_out;
+
+	SpeculatedEvent events[ MAX_SPECULATED_EVENTS ];
+	int num_events;
+
+	// G_PMoveTouchTriggers links the player and has to run at the same
+	// point in the move, with the state from that point
+	bool touched_triggers;
+	int touch_triggers_event;
+	pmove_t touch_pm;
+	SyncPlayerState touch_ps;
+	Vec3 touch_previous_origin;
+
+	// everywhere its traces and contents checks looked
+	Vec3 mins, maxs;
+	bool usable;
+};
+
+struct ClientMoveSpeculation {
+	edict_t *ent;
+	Span< SpeculatedMove > moves;
+	size_t num_usable;
+	size_t next;
+};
+
+static ClientMoveSpeculation move_speculations[ MAX_CLIENTS ];
+static Span< SpeculatedMove > speculated_moves;
+static gs_state_t speculation_gs;
+static thread_local SpeculatedMove * current_speculated_move;
+
+static void SpeculationTrace( trace_t *tr, Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, int ignore, int contentmask, int timeDelta ) {
+	SpeculatedMove * move = current_speculated_move;
+	AddPointToBounds( start + mins, &move->mins, &move->maxs );
+	AddPointToBounds( start + maxs, &move->mins, &move->maxs );
+	AddPointToBounds( end + mins, &move->mins, &move->maxs );
+	AddPointToBounds( end + maxs, &move->mins, &move->maxs );
+
+	server_gs.api.Trace( tr, start, mins, maxs, end, ignore, contentmask, timeDelta );
+}
+
+static int SpeculationPointContents( Vec3 p, int timeDelta ) {
+	AddPointToBounds( p, &current_speculated_move->mins, &current_speculated_move->maxs );
+	return server_gs.api.PointContents( p, timeDelta );
+}
+
+static void SpeculationPredictedEvent( int entNum, int ev, u64 parm ) {
+	SpeculatedMove * move = current_speculated_move;
+	if( move->num_events == MAX_SPECULATED_EVENTS ) {
+		move->usable = false;
+		return;
+	}
+
+	move->events[ move->num_events ].ev = ev;
+	move->events[ move->num_events ].parm = parm;
+	move->num_events++;
+}
+
+static void SpeculationTouchTriggers( pmove_t *pm, Vec3 previous_origin ) {
+	SpeculatedMove * move = current_speculated_move;
+
+	Vec3 mins, maxs;
+	if( G_PMoveWouldTouchTriggers( pm, previous_origin, &mins, &maxs ) ) {
+		move->usable = false;
+	}
+
+	AddPointToBounds( mins, &move->mins, &move->maxs );
+	AddPointToBounds( maxs, &move->mins, &move->maxs );
+
+	move->touched_triggers = true;
+	move->touch_triggers_event = move->num_events;
+	move->touch_pm = *pm;
+	memcpy( &move->touch_ps, pm->playerState, sizeof( SyncPlayerState ) );
+	move->touch_previous_origin = previous_origin;
+}
+
+static void SpeculateClientMovesJob( TempAllocator *temp, void *data ) {
+	ClientMoveSpeculation * spec = ( ClientMoveSpeculation * ) data;
+	const edict_t * ent = spec->ent;
+
+	// same setup as ClientThink. after the first move the entity would have
+	// been updated from the results of the previous one, which ps already has
+	SyncPlayerState ps;
+	memcpy( &ps, &ent->r.client->ps, sizeof( ps ) );
+	ps.POVnum = ENTNUM( ent );
+	ps.playerNum = PLAYERNUM( ent );
+	ps.pmove.origin = ent->s.origin;
+	ps.pmove.velocity = ent->velocity;
+	ps.viewangles = ent->s.angles;
+
+	for( SpeculatedMove & move : spec->moves ) {
+		ClientSetPmoveType( ent, &ps );
+
+		memcpy( &move.pmove_in, &ps.pmove, sizeof( ps.pmove ) );
+		move.viewangles_in = ps.viewangles;
+		move.viewheight_in = ps.viewheight;
+		move.weapon_in = ps.weapon;
+		move.paused = GS_MatchPaused( &speculation_gs );
+
+		move.num_events = 0;
+		move.touched_triggers = false;
+		move.usable = true;
+		ClearBounds( &move.mins, &move.maxs );
+
+		memset( &move.pm, 0, sizeof( move.pm ) );
+		move.pm.playerState = &ps;
+		move.pm.cmd = move.cmd;
+
+		current_speculated_move = &move;
+		Pmove( &speculation_gs, &move.pm );
+		current_speculated_move = NULL;
+
+		if( !move.usable )
+			break;
+
+		memcpy( &move.pmove_out, &ps.pmove, sizeof( ps.pmove ) );
+		move.viewangles_out = ps.viewangles;
+		move.viewheight_out = ps.viewheight;
+
+		spec->num_usable++;
+	}
+}
+
+/*
+* G_SpeculateClientMoves
+*/
+void G_SpeculateClientMoves( TempAllocator * temp ) {
+	ZoneScoped;
+
+	if( !g_parallel_clientmoves->integer ) {
+		return;
+	}
+
+	int num_clients = 0;
+	size_t num_moves = 0;
+
+	for( int i = 0; i < server_gs.maxclients; i++ ) {
+		edict_t * ent = game.edicts + 1 + i;
+		if( !ent->r.inuse || ent->r.client == NULL || trap_GetClientState( i ) < CS_SPAWNED ) {
+			continue;
+		}
+
+		int n = Min2( trap_PendingClientThinks( i, NULL, 0 ), MAX_SPECULATED_MOVES );
+		if( n == 0 ) {
+			continue;
+		}
+
+		ClientMoveSpeculation * spec = &move_speculations[ num_clients ];
+		spec->ent = ent;
+		spec->moves = Span< SpeculatedMove >( NULL, n );
+		spec->num_usable = 0;
+		spec->next = 0;
+		num_clients++;
+		num_moves += n;
+	}
+
+	// not worth the overhead
+	if( num_clients < 2 ) {
+		return;
+	}
+
+	speculated_moves = ALLOC_SPAN( temp, SpeculatedMove, num_moves );
+
+	size_t cursor = 0;
+	usercmd_t cmds[ MAX_SPECULATED_MOVES ];
+	for( int i = 0; i < num_clients; i++ ) {
+		ClientMoveSpeculation * spec = &move_speculations[ i ];
+		spec->moves = speculated_moves.slice( cursor, cursor + spec->moves.n );
+		cursor += spec->moves.n;
+
+		trap_PendingClientThinks( PLAYERNUM( spec->ent ), cmds, spec->moves.n );
+		for( size_t j = 0; j < spec->moves.n; j++ ) {
+			spec->moves[ j ].cmd = cmds[ j ];
+		}
+	}
+
+	speculation_gs = server_gs;
+	speculation_gs.api.Trace = SpeculationTrace;
+	speculation_gs.api.PointContents = SpeculationPointContents;
+	speculation_gs.api.PredictedEvent = SpeculationPredictedEvent;
+	speculation_gs.api.PMoveTouchTriggers = SpeculationTouchTriggers;
+
+	ParallelFor( Span< ClientMoveSpeculation >( move_speculations, num_clients ), SpeculateClientMovesJob );
+
+	for( int i = 0; i < num_clients; i++ ) {
+		move_speculations[ i ].ent->r.client->move_speculation = &move_speculations[ i ];
+	}
+
+	GClip_TrackLinkChanges( true );
+}
+
+/*
+* G_ClearSpeculatedClientMoves
+*/
+void G_ClearSpeculatedClientMoves() {
+	for( int i = 0; i < server_gs.maxclients; i++ ) {
+		edict_t * ent = game.edicts + 1 + i;
+		if( ent->r.client != NULL ) {
+			ent->r.client->move_speculation = NULL;
+		}
+	}
+
+	speculated_moves = Span< SpeculatedMove >();
+
+	GClip_TrackLinkChanges( false );
+}
+
+static void ApplySpeculatedTouchTriggers( SpeculatedMove * move ) {
+	pmove_t pm = move->touch_pm;
+	pm.playerState = &move->touch_ps;
+	G_PMoveTouchTriggers( &pm, move->touch_previous_origin );
+}
+
+/*
+* G_ApplySpeculatedMove
+*
+* Returns false if there's no speculated move for this usercmd or it's not
+* valid any more, and the caller has to run Pmove itself
+*/
+static bool G_ApplySpeculatedMove( edict_t *ent, pmove_t *pm ) {
+	gclient_t * client = ent->r.client;
+	ClientMoveSpeculation * spec = client->move_speculation;
+	if( spec == NULL || spec->next == spec->num_usable ) {
+		return false;
+	}
+
+	SpeculatedMove * move = &spec->moves[ spec->next ];
+	SyncPlayerState * ps = pm->playerState;
+
+	bool valid = memcmp( &move->cmd, &pm->cmd, sizeof( usercmd_t ) ) == 0 &&
+		memcmp( &move->pmove_in, &ps->pmove, sizeof( ps->pmove ) ) == 0 &&
+		move->viewangles_in == ps->viewangles &&
+		move->viewheight_in == ps->viewheight &&
+		move->weapon_in == ps->weapon &&
+		move->paused == GS_MatchPaused( &server_gs ) &&
+		!GClip_LinksChangedInBox( move->mins, move->maxs, ENTNUM( ent ) );
+
+	if( !valid ) {
+		// everything after this was worked out from a state we didn't end up in
+		client->move_speculation = NULL;
+		return false;
+	}
+
+	spec->next++;
+
+	// replay everything Pmove would have done, in the same order
+	for( int i = 0; i < move->num_events; i++ ) {
+		if( move->touched_triggers && move->touch_triggers_event == i ) {
+			ApplySpeculatedTouchTriggers( move );
+		}
+		G_PredictedEvent( ENTNUM( ent ), move->events[ i ].ev, move->events[ i ].parm );
+	}
+	if( move->touched_triggers && move->touch_triggers_event == move->num_events ) {
+		ApplySpeculatedTouchTriggers( move );
+	}
+
+	memcpy( &ps->pmove, &move->pmove_out, sizeof( ps->pmove ) );
+	ps->viewangles = move->viewangles_out;
+	ps->viewheight = move->viewheight_out;
+
+	*pm = move->pm;
+	pm->playerState = ps;
+
+	return true;
+}
+
+static void G_RecordPmoveTestCmd( const edict_t * ent, const usercmd_t * ucmd );
+
 /*
 * ClientThink
 */
@@ -993,24 +1315,19 @@ void ClientThink( edict_t *ent, usercmd_t *ucmd, int timeDelta ) {
 	client->ps.pmove.velocity = ent->velocity;
 	client->ps.viewangles = ent->s.angles;
 
-	client->ps.pmove.gravity = level.gravity;
+	ClientSetPmoveType( ent, &client->ps );
 
-	if( GS_MatchState( &server_gs ) >= MATCH_STATE_POSTMATCH || GS_MatchPaused( &server_gs )
-		|| ( ent->movetype != MOVETYPE_PLAYER && ent->movetype != MOVETYPE_NOCLIP ) ) {
-		client->ps.pmove.pm_type = PM_FREEZE;
-	} else if( ent->movetype == MOVETYPE_NOCLIP ) {
-		client->ps.pmove.pm_type = PM_SPECTATOR;
-	} else {
-		client->ps.pmove.pm_type = PM_NORMAL;
-	}
+	G_RecordPmoveTestCmd( ent, ucmd );
 
 	// set up for pmove
 	memset( &pm, 0, sizeof( pmove_t ) );
 	pm.playerState = &client->ps;
 	pm.cmd = *ucmd;
 
-	// perform a pmove
-	Pmove( &server_gs, &pm );
+	// perform a pmove, unless it was already done in G_SpeculateClientMoves
+	if( !G_ApplySpeculatedMove( ent, &pm ) ) {
+		Pmove( &server_gs, &pm );
+	}
 
 	// save results of pmove
 	client->old_pmove = client->ps.pmove;
@@ -1096,6 +1413,472 @@ void G_ClientThink( edict_t *ent ) {
 	trap_ExecuteClientThinks( PLAYERNUM( ent ) );
 }
 
+// pmovetest replays usercmds recorded from real clients through Pmove and
+// checks the results against a golden stream from an earlier build. Both
+// live in pmovetest/<map>.cmds and pmovetest/<map>.golden and get checked in,
+// so make the golden file with the build from before a Pmove change, and test
+// the build after it. The files are raw structs, so regenerate them both if
+// any of the structs in them change
+
+#define PMOVETEST_DIR "pmovetest"
+#define PMOVETEST_VERSION 1
+
+struct PmoveTestHeader {
+	u32 version;
+	u32 num_players;
+	u32 num_frames;
+};
+
+struct PmoveTestStart {
+	SyncPlayerState ps;
+	SyncEntityState s;
+};
+
+struct PmoveTestFrame {
+	pmove_state_t pmove;
+	u64 events;
+};
+
+struct PmoveTestRecording {
+	int num_frames;
+	usercmd_t * cmds;
+	PmoveTestStart starts[ MAX_CLIENTS ];
+	int num_cmds[ MAX_CLIENTS ];
+};
+
+static PmoveTestRecording pmove_test_recording;
+
+struct PmoveTestPlayer {
+	const PmoveTestStart * start;
+	Span< const usercmd_t > cmds;
+	PmoveTestFrame * frames;
+
+	SyncPlayerState ps;
+	PmoveTestFrame * frame;
+	int touching_jumppad;
+};
+
+static gs_state_t pmove_test_gs;
+static thread_local PmoveTestPlayer * current_pmove_test_player;
+
+static bool WritePmoveTestFile( const char * path, const PmoveTestHeader * header, const void * a, size_t a_size, const void * b, size_t b_size ) {
+	int file;
+	if( FS_FOpenFile( path, &file, FS_WRITE ) < 0 ) {
+		Com_Printf( "Couldn't open %s for writing\n", path );
+		return false;
+	}
+
+	FS_Write( header, sizeof( *header ), file );
+	FS_Write( a, a_size, file );
+	FS_Write( b, b_size, file );
+	FS_FCloseFile( file );
+
+	return true;
+}
+
+/*
+* G_RecordPmoveTestCmd
+*
+* Called from ClientThink with the state Pmove is about to start from
+*/
+static void G_RecordPmoveTestCmd( const edict_t * ent, const usercmd_t * ucmd ) {
+	PmoveTestRecording * rec = &pmove_test_recording;
+	if( rec->cmds == NULL ) {
+		return;
+	}
+
+	int player = PLAYERNUM( ent );
+	if( rec->num_cmds[ player ] == rec->num_frames ) {
+		return;
+	}
+
+	if( rec->num_cmds[ player ] == 0 ) {
+		memset( &rec->starts[ player ], 0, sizeof( rec->starts[ player ] ) );
+		rec->starts[ player ].ps = ent->r.client->ps;
+		rec->starts[ player ].s = ent->s;
+	}
+
+	rec->cmds[ player * rec->num_frames + rec->num_cmds[ player ] ] = *ucmd;
+	rec->num_cmds[ player ]++;
+
+	// done when everyone we started recording has enough, players that
+	// left part way through get dropped
+	PmoveTestHeader header = { PMOVETEST_VERSION, 0, u32( rec->num_frames ) };
+	for( int i = 0; i < server_gs.maxclients; i++ ) {
+		if( rec->num_cmds[ i ] == 0 ) {
+			continue;
+		}
+		if( rec->num_cmds[ i ] == rec->num_frames ) {
+			header.num_players++;
+		}
+		else if( game.edicts[ i + 1 ].r.inuse ) {
+			return;
+		}
+	}
+
+	DynamicArray< PmoveTestStart > starts( sys_allocator );
+	DynamicArray< usercmd_t > cmds( sys_allocator );
+	for( int i = 0; i < server_gs.maxclients; i++ ) {
+		if( rec->num_cmds[ i ] == rec->num_frames ) {
+			starts.add( rec->starts[ i ] );
+			for( int j = 0; j < rec->num_frames; j++ ) {
+				cmds.add( rec->cmds[ i * rec->num_frames + j ] );
+			}
+		}
+	}
+
+	const char * path = va( PMOVETEST_DIR "/%s.cmds", sv.mapname );
+	if( WritePmoveTestFile( path, &header, starts.ptr(), starts.num_bytes(), cmds.ptr(), cmds.num_bytes() ) ) {
+		Com_Printf( "Wrote %u players x %u frames to %s\n", header.num_players, header.num_frames, path );
+	}
+
+	FREE( sys_allocator, rec->cmds );
+	rec->cmds = NULL;
+}
+
+static void GeneratePmoveTestCmds( RNG * rng, usercmd_t * cmds, int num_frames ) {
+	usercmd_t cmd;
+	memset( &cmd, 0, sizeof( cmd ) );
+
+	// stand still for a bit so players dropped on jump pads land on them
+	int held = 30;
+
+	for( int i = 0; i < num_frames; i++ ) {
+		// hold inputs for a while like a person would
+		if( held-- <= 0 ) {
+			held = random_uniform( rng, 5, 60 );
+			cmd.forwardmove = random_uniform( rng, -1, 2 ) * 127;
+			cmd.sidemove = random_uniform( rng, -1, 2 ) * 127;
+			cmd.upmove = random_p( rng, 0.15f ) ? 127 : random_p( rng, 0.1f ) ? -127 : 0;
+			cmd.buttons = random_p( rng, 0.2f ) ? BUTTON_SPECIAL : 0;
+			if( random_p( rng, 0.1f ) ) {
+				cmd.buttons |= BUTTON_WALK;
+			}
+		}
+
+		cmd.msec = random_uniform( rng, 8, 34 );
+		cmd.angles[ YAW ] += random_uniform( rng, -600, 601 );
+		cmd.angles[ PITCH ] = Clamp( -ANGLE2SHORT( 60.0f ), cmd.angles[ PITCH ] + random_uniform( rng, -200, 201 ), ANGLE2SHORT( 60.0f ) );
+		cmd.serverTimeStamp += cmd.msec;
+
+		cmds[ i ] = cmd;
+	}
+}
+
+/*
+* GeneratePmoveTestFile
+*
+* For maps nobody has played on with pmovetest record. Alternates players
+* between spawn points and jump pads, with random inputs held for a while,
+* jumps, dashes and mouse movement
+*/
+static void GeneratePmoveTestFile( const char * path, int num_players, int num_frames ) {
+	const char * spawn_classnames[] = {
+		"info_player_deathmatch", "info_player_start",
+		"team_CTF_alphaspawn", "team_CTF_betaspawn",
+		"spawn_bomb_attacking", "spawn_bomb_defending", "spawn_gladiator",
+	};
+	DynamicArray< Vec3 > spawns( sys_allocator );
+	for( const char * classname : spawn_classnames ) {
+		edict_t * spot = NULL;
+		while( ( spot = G_Find( spot, FOFS( classname ), classname ) ) != NULL ) {
+			spawns.add( spot->s.origin + Vec3( 0.0f, 0.0f, 16.0f ) );
+		}
+	}
+
+	DynamicArray< Vec3 > jumppads( sys_allocator );
+	for( int i = server_gs.maxclients + 1; i < game.numentities; i++ ) {
+		const edict_t * ent = &game.edicts[ i ];
+		if( ent->r.inuse && ( ent->s.type == ET_JUMPPAD || ent->s.type == ET_PAINKILLER_JUMPPAD ) ) {
+			Vec3 center = ( ent->r.absmin + ent->r.absmax ) * 0.5f;
+			jumppads.add( Vec3( center.x, center.y, ent->r.absmax.z + 48.0f ) );
+		}
+	}
+
+	if( spawns.size() == 0 ) {
+		Com_Printf( "No spawn points\n" );
+		return;
+	}
+
+	PmoveTestStart * starts = ALLOC_MANY( sys_allocator, PmoveTestStart, num_players );
+	usercmd_t * cmds = ALLOC_MANY( sys_allocator, usercmd_t, num_players * num_frames );
+	defer { FREE( sys_allocator, starts ); };
+	defer { FREE( sys_allocator, cmds ); };
+
+	memset( starts, 0, num_players * sizeof( PmoveTestStart ) );
+
+	RNG rng = new_rng( 1, 1 );
+	for( int i = 0; i < num_players; i++ ) {
+		SyncPlayerState * ps = &starts[ i ].ps;
+		bool on_jumppad = jumppads.size() > 0 && i % 2 == 1;
+		const DynamicArray< Vec3 > & origins = on_jumppad ? jumppads : spawns;
+
+		ps->POVnum = MAX_EDICTS; // not a real entity
+		ps->pmove.pm_type = PM_NORMAL;
+		ps->pmove.features = PMFEAT_DEFAULT;
+		ps->pmove.gravity = level.gravity;
+		ps->pmove.max_speed = DEFAULT_PLAYERSPEED;
+		ps->pmove.jump_speed = DEFAULT_JUMPSPEED;
+		ps->pmove.dash_speed = DEFAULT_DASHSPEED;
+		ps->pmove.origin = origins[ random_uniform( &rng, 0, int( origins.size() ) ) ];
+		ps->viewangles.y = random_float01( &rng ) * 360.0f;
+
+		GeneratePmoveTestCmds( &rng, &cmds[ i * num_frames ], num_frames );
+	}
+
+	PmoveTestHeader header = { PMOVETEST_VERSION, u32( num_players ), u32( num_frames ) };
+	if( WritePmoveTestFile( path, &header, starts, num_players * sizeof( PmoveTestStart ), cmds, num_players * num_frames * sizeof( usercmd_t ) ) ) {
+		Com_Printf( "Wrote %d players x %d frames to %s, %zu of them on jump pads\n", num_players, num_frames, path, jumppads.size() > 0 ? size_t( num_players / 2 ) : size_t( 0 ) );
+	}
+}
+
+// traces only hit the world and triggers are looked up read only, so the
+// results don't depend on where everyone else is when the test runs, and
+// players can run on any thread
+
+static void PmoveTestTrace( trace_t *tr, Vec3 start, Vec3 mins, Vec3 maxs, Vec3 end, int ignore, int contentmask, int timeDelta ) {
+	CM_TransformedBoxTrace( CM_Server, svs.cms, tr, start, end, mins, maxs, NULL, contentmask, Vec3( 0.0f ), Vec3( 0.0f ) );
+	tr->ent = tr->fraction < 1.0f ? 0 : -1;
+}
+
+static int PmoveTestPointContents( Vec3 p, int timeDelta ) {
+	return CM_TransformedPointContents( CM_Server, svs.cms, p, NULL, Vec3( 0.0f ), Vec3( 0.0f ) );
+}
+
+static SyncEntityState * PmoveTestGetEntityState( int entNum, int deltaTime ) {
+	PmoveTestPlayer * player = current_pmove_test_player;
+	if( entNum == int( player->ps.POVnum ) ) {
+		return const_cast< SyncEntityState * >( &player->start->s );
+	}
+	return &game.edicts[ entNum ].s;
+}
+
+static void PmoveTestPredictedEvent( int entNum, int ev, u64 parm ) {
+	PmoveTestFrame * frame = current_pmove_test_player->frame;
+	frame->events = Hash64( &ev, sizeof( ev ), frame->events );
+	frame->events = Hash64( &parm, sizeof( parm ), frame->events );
+}
+
+// jump pads the way client prediction does them, once per touch
+static void PmoveTestTouchTriggers( pmove_t *pm, Vec3 previous_origin ) {
+	PmoveTestPlayer * player = current_pmove_test_player;
+	if( pm->playerState->pmove.pm_type != PM_NORMAL ) {
+		return;
+	}
+
+	Vec3 mins = pm->playerState->pmove.origin + pm->mins;
+	Vec3 maxs = pm->playerState->pmove.origin + pm->maxs;
+
+	int touch[ MAX_EDICTS ];
+	int num = GClip_AreaEdicts( mins, maxs, touch, MAX_EDICTS, AREA_TRIGGERS, 0 );
+
+	int jumppad = 0;
+	for( int i = 0; i < num; i++ ) {
+		const edict_t * hit = &game.edicts[ touch[ i ] ];
+		if( hit->s.type != ET_JUMPPAD && hit->s.type != ET_PAINKILLER_JUMPPAD ) {
+			continue;
+		}
+		if( GClip_EntityContact( mins, maxs, hit ) ) {
+			jumppad = touch[ i ];
+			break;
+		}
+	}
+
+	if( jumppad != 0 && jumppad != player->touching_jumppad ) {
+		GS_TouchPushTrigger( &pmove_test_gs, pm->playerState, &game.edicts[ jumppad ].s );
+	}
+	player->touching_jumppad = jumppad;
+}
+
+static void PmoveTestPlayerJob( TempAllocator * temp, void * data ) {
+	PmoveTestPlayer * player = ( PmoveTestPlayer * ) data;
+	current_pmove_test_player = player;
+
+	player->ps = player->start->ps;
+	player->touching_jumppad = 0;
+
+	for( size_t i = 0; i < player->cmds.n; i++ ) {
+		player->frame = &player->frames[ i ];
+		player->frame->events = 0;
+
+		pmove_t pm;
+		memset( &pm, 0, sizeof( pm ) );
+		pm.playerState = &player->ps;
+		pm.cmd = player->cmds[ i ];
+
+		Pmove( &pmove_test_gs, &pm );
+
+		player->frame->pmove = player->ps.pmove;
+	}
+
+	current_pmove_test_player = NULL;
+}
+
+static bool PmoveTestFramesEqual( const PmoveTestFrame & a, const PmoveTestFrame & b ) {
+	// not memcmp, struct copies don't have to copy the padding
+	const pmove_state_t & x = a.pmove;
+	const pmove_state_t & y = b.pmove;
+	return x.pm_type == y.pm_type && x.origin == y.origin && x.velocity == y.velocity &&
+		x.delta_angles[ 0 ] == y.delta_angles[ 0 ] && x.delta_angles[ 1 ] == y.delta_angles[ 1 ] && x.delta_angles[ 2 ] == y.delta_angles[ 2 ] &&
+		x.pm_flags == y.pm_flags && x.pm_time == y.pm_time && x.features == y.features &&
+		x.no_control_time == y.no_control_time && x.knockback_time == y.knockback_time &&
+		x.crouch_time == y.crouch_time && x.tbag_time == y.tbag_time && x.dash_time == y.dash_time &&
+		x.walljump_time == y.walljump_time && x.max_speed == y.max_speed && x.jump_speed == y.jump_speed &&
+		x.dash_speed == y.dash_speed && x.gravity == y.gravity && a.events == b.events;
+}
+
+static void ComparePmoveTestFrames( const char * name, const PmoveTestFrame * expected, const PmoveTestFrame * frames, u32 num_players, u32 num_frames, u32 copies ) {
+	u32 mismatches = 0;
+	u32 first_player = 0;
+	u32 first_frame = 0;
+
+	for( u32 copy = 0; copy < copies; copy++ ) {
+		for( u32 i = 0; i < num_players * num_frames; i++ ) {
+			if( !PmoveTestFramesEqual( expected[ i ], frames[ copy * num_players * num_frames + i ] ) ) {
+				if( mismatches == 0 ) {
+					for( u32 k = i - 2; k <= i; k++ ) { const pmove_state_t & e = expected[ k ].pmove; const pmove_state_t & f = frames[ copy * num_players * num_frames + k ].pmove;
+					Com_Printf( "exp %.9g %.9g %.9g v %.9g %.9g %.9g fl %x t %d ev %llx\n", e.origin.x, e.origin.y, e.origin.z, e.velocity.x, e.velocity.y, e.velocity.z, e.pm_flags, e.pm_time, (unsigned long long)expected[k].events );
+					Com_Printf( "got %.9g %.9g %.9g v %.9g %.9g %.9g fl %x t %d ev %llx\n", f.origin.x, f.origin.y, f.origin.z, f.velocity.x, f.velocity.y, f.velocity.z, f.pm_flags, f.pm_time, (unsigned long long)frames[ copy * num_players * num_frames + k ].events ); }
+					first_player = i / num_frames;
+					first_frame = i % num_frames;
+				}
+				mismatches++;
+			}
+		}
+	}
+
+	if( mismatches == 0 ) {
+		Com_Printf( "%s: all %u pmove states matched\n", name, num_players * num_frames * copies );
+	}
+	else {
+		Com_Printf( S_COLOR_RED "%s: %u pmove states didn't match, the first was player %u frame %u\n", name, mismatches, first_player, first_frame );
+	}
+}
+
+/*
+* G_PmoveDeterminismTest_f
+*
+* Usage: pmovetest [copies]
+*        pmovetest record [frames]
+*        pmovetest generate [players] [frames]
+*        pmovetest golden
+*
+* record saves the next usercmds every client sends, generate makes some up
+* instead, and golden saves what Pmove makes of them. With no arguments the recording is replayed one player
+* after another, then again as several copies of every player spread over
+* the thread pool, and every frame of both is checked against the golden
+* file and each other
+*/
+void G_PmoveDeterminismTest_f() {
+	char cmds_path[ MAX_QPATH ];
+	char golden_path[ MAX_QPATH ];
+	snprintf( cmds_path, sizeof( cmds_path ), PMOVETEST_DIR "/%s.cmds", sv.mapname );
+	snprintf( golden_path, sizeof( golden_path ), PMOVETEST_DIR "/%s.golden", sv.mapname );
+
+	if( Q_stricmp( Cmd_Argv( 1 ), "record" ) == 0 ) {
+		PmoveTestRecording * rec = &pmove_test_recording;
+		FREE( sys_allocator, rec->cmds );
+		memset( rec, 0, sizeof( *rec ) );
+		rec->num_frames = Cmd_Argc() > 2 ? Max2( 1, atoi( Cmd_Argv( 2 ) ) ) : 1000;
+		rec->cmds = ALLOC_MANY( sys_allocator, usercmd_t, MAX_CLIENTS * rec->num_frames );
+		Com_Printf( "Recording %d usercmds from every client\n", rec->num_frames );
+		return;
+	}
+
+	if( Q_stricmp( Cmd_Argv( 1 ), "generate" ) == 0 ) {
+		int num_players = Cmd_Argc() > 2 ? Max2( 1, atoi( Cmd_Argv( 2 ) ) ) : 16;
+		int num_frames = Cmd_Argc() > 3 ? Max2( 1, atoi( Cmd_Argv( 3 ) ) ) : 1000;
+		GeneratePmoveTestFile( cmds_path, num_players, num_frames );
+		return;
+	}
+
+	bool write_golden = Q_stricmp( Cmd_Argv( 1 ), "golden" ) == 0;
+	u32 copies = write_golden || Cmd_Argc() < 2 ? 8 : Max2( 1, atoi( Cmd_Argv( 1 ) ) );
+
+	uint8_t * cmds_file;
+	int cmds_length = FS_LoadFile( cmds_path, ( void ** ) &cmds_file, NULL, 0 );
+	defer { FS_FreeFile( cmds_file ); };
+
+	const PmoveTestHeader * header = ( const PmoveTestHeader * ) cmds_file;
+	if( cmds_file == NULL || size_t( cmds_length ) < sizeof( *header ) || header->version != PMOVETEST_VERSION ||
+			size_t( cmds_length ) != sizeof( *header ) + header->num_players * ( sizeof( PmoveTestStart ) + header->num_frames * sizeof( usercmd_t ) ) ) {
+		Com_Printf( "No usable %s, make one with pmovetest record or pmovetest generate\n", cmds_path );
+		return;
+	}
+
+	u32 num_players = header->num_players;
+	u32 num_frames = header->num_frames;
+	const PmoveTestStart * starts = ( const PmoveTestStart * ) ( header + 1 );
+	const usercmd_t * cmds = ( const usercmd_t * ) ( starts + num_players );
+
+	pmove_test_gs = server_gs;
+	pmove_test_gs.api.Trace = PmoveTestTrace;
+	pmove_test_gs.api.PointContents = PmoveTestPointContents;
+	pmove_test_gs.api.GetEntityState = PmoveTestGetEntityState;
+	pmove_test_gs.api.PredictedEvent = PmoveTestPredictedEvent;
+	pmove_test_gs.api.PMoveTouchTriggers = PmoveTestTouchTriggers;
+
+	size_t num_states = size_t( num_players ) * size_t( num_frames );
+	PmoveTestFrame * serial_frames = ALLOC_MANY( sys_allocator, PmoveTestFrame, num_states );
+	PmoveTestFrame * parallel_frames = ALLOC_MANY( sys_allocator, PmoveTestFrame, num_states * copies );
+	PmoveTestPlayer * players = ALLOC_MANY( sys_allocator, PmoveTestPlayer, num_players * copies );
+	defer { FREE( sys_allocator, serial_frames ); };
+	defer { FREE( sys_allocator, parallel_frames ); };
+	defer { FREE( sys_allocator, players ); };
+
+	// zero the padding so golden files come out the same every time
+	memset( serial_frames, 0, num_states * sizeof( PmoveTestFrame ) );
+
+	for( int pass = 0; pass < 2; pass++ ) {
+		u32 num_test_players = pass == 0 ? num_players : num_players * copies;
+		PmoveTestFrame * frames = pass == 0 ? serial_frames : parallel_frames;
+
+		for( u32 i = 0; i < num_test_players; i++ ) {
+			u32 recorded = i % num_players;
+			players[ i ].start = &starts[ recorded ];
+			players[ i ].cmds = Span< const usercmd_t >( &cmds[ recorded * num_frames ], num_frames );
+			players[ i ].frames = &frames[ i * num_frames ];
+		}
+
+		u64 start = Sys_Microseconds();
+		if( pass == 0 ) {
+			for( u32 i = 0; i < num_test_players; i++ ) {
+				PmoveTestPlayerJob( NULL, &players[ i ] );
+			}
+		}
+		else {
+			ParallelFor( Span< PmoveTestPlayer >( players, num_test_players ), PmoveTestPlayerJob );
+		}
+		u64 time = Sys_Microseconds() - start;
+
+		Com_Printf( "%s: %u players, %u frames, %.2fms\n", pass == 0 ? "Serial" : "Parallel", num_test_players, num_frames, time / 1000.0 );
+
+		if( write_golden ) {
+			if( WritePmoveTestFile( golden_path, header, serial_frames, num_states * sizeof( PmoveTestFrame ), NULL, 0 ) ) {
+				Com_Printf( "Wrote %s\n", golden_path );
+			}
+			return;
+		}
+	}
+
+	ComparePmoveTestFrames( "Parallel vs serial", serial_frames, parallel_frames, num_players, num_frames, copies );
+
+	uint8_t * golden_file;
+	int golden_length = FS_LoadFile( golden_path, ( void ** ) &golden_file, NULL, 0 );
+	defer { FS_FreeFile( golden_file ); };
+
+	const PmoveTestHeader * golden_header = ( const PmoveTestHeader * ) golden_file;
+	if( golden_file == NULL || size_t( golden_length ) != sizeof( *header ) + num_states * sizeof( PmoveTestFrame ) ||
+			memcmp( golden_header, header, sizeof( *header ) ) != 0 ) {
+		Com_Printf( S_COLOR_YELLOW "No usable %s, make one with pmovetest golden\n", golden_path );
+		return;
+	}
+
+	const PmoveTestFrame * golden = ( const PmoveTestFrame * ) ( golden_header + 1 );
+	ComparePmoveTestFrames( "Serial vs golden", golden, serial_frames, num_players, num_frames, 1 );
+	ComparePmoveTestFrames( "Parallel vs golden", golden, parallel_frames, num_players, num_frames, copies );
+}
+
 /*
 * G_CheckClientRespawnClick
 */
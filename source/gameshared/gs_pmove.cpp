@@ -69,9 +69,12 @@ typedef struct {
 	float dashPlayerSpeed;
 } pml_t;
 
-static pmove_t *pm;
-static pml_t pml;
-static const gs_state_t * pmove_gs;
+// thread_local so moves for different players can run on different threads.
+// Passing this around in a struct instead gives gcc room to reorder the
+// float math under -ffast-math, which changes where players end up
+static thread_local pmove_t *pm;
+static thread_local pml_t pml;
+static thread_local const gs_state_t * pmove_gs;
 
 // movement parameters
 
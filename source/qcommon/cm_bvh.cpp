@@ -0,0 +1,234 @@
+#include <algorithm>
+
+#include "qcommon/base.h"
+#include "qcommon/qcommon.h"
+#include "qcommon/array.h"
+#include "qcommon/cm_local.h"
+
+/*
+ * Builds a BVH over the world model's brushes and patches with binned SAH
+ * splits. Traces walk it front to back in CM_TraceBVH instead of walking the
+ * BSP, which visits every item once so there's no need to dedup brushes that
+ * are in lots of leaves, and lets long traces skip big empty volumes in one
+ * step. cm_bvh picks which one world traces use.
+ */
+
+constexpr u32 BVH_MAX_LEAF_ITEMS = 4;
+constexpr u32 BVH_NUM_BINS = 16;
+constexpr u32 BVH_MAX_DEPTH = 32; // past this we fall back to median splits, which keeps the depth well under the 64 CM_TraceBVH has room for
+
+struct BVHBuildItem {
+	Vec3 mins, maxs;
+	Vec3 centroid;
+	u32 item;
+};
+
+struct BVHBin {
+	Vec3 mins, maxs;
+	u32 count;
+};
+
+static float SurfaceArea( Vec3 mins, Vec3 maxs ) {
+	Vec3 d = maxs - mins;
+	return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+static void AddBoundsToBounds( Vec3 mins, Vec3 maxs, Vec3 * total_mins, Vec3 * total_maxs ) {
+	AddPointToBounds( mins, total_mins, total_maxs );
+	AddPointToBounds( maxs, total_mins, total_maxs );
+}
+
+static int BinForCentroid( float c, float lo, float scale ) {
+	return Clamp( 0, int( ( c - lo ) * scale ), int( BVH_NUM_BINS - 1 ) );
+}
+
+/*
+ * FindSAHSplit
+ *
+ * Returns the number of items that go left after partitioning, or 0 if no
+ * split is better than making a leaf
+ */
+static size_t FindSAHSplit( Span< BVHBuildItem > items, Vec3 mins, Vec3 maxs ) {
+	Vec3 cmins, cmaxs;
+	ClearBounds( &cmins, &cmaxs );
+	for( const BVHBuildItem & item : items ) {
+		AddPointToBounds( item.centroid, &cmins, &cmaxs );
+	}
+
+	float best_cost = float( items.n ); // cost of a leaf, relative to the parent's area
+	int best_axis = -1;
+	int best_bin = -1;
+
+	for( int axis = 0; axis < 3; axis++ ) {
+		float lo = cmins[ axis ];
+		float extent = cmaxs[ axis ] - lo;
+		if( extent <= 0.0f )
+			continue;
+		float scale = BVH_NUM_BINS / extent;
+
+		BVHBin bins[ BVH_NUM_BINS ];
+		for( BVHBin & bin : bins ) {
+			ClearBounds( &bin.mins, &bin.maxs );
+			bin.count = 0;
+		}
+
+		for( const BVHBuildItem & item : items ) {
+			BVHBin * bin = &bins[ BinForCentroid( item.centroid[ axis ], lo, scale ) ];
+			AddBoundsToBounds( item.mins, item.maxs, &bin->mins, &bin->maxs );
+			bin->count++;
+		}
+
+		// sweep from the right to get the cost of everything past each split
+		float right_area[ BVH_NUM_BINS ];
+		u32 right_count[ BVH_NUM_BINS ];
+		Vec3 rmins, rmaxs;
+		ClearBounds( &rmins, &rmaxs );
+		u32 count = 0;
+		for( u32 i = BVH_NUM_BINS - 1; i > 0; i-- ) {
+			if( bins[ i ].count > 0 ) {
+				AddBoundsToBounds( bins[ i ].mins, bins[ i ].maxs, &rmins, &rmaxs );
+			}
+			count += bins[ i ].count;
+			right_area[ i ] = count > 0 ? SurfaceArea( rmins, rmaxs ) : 0.0f;
+			right_count[ i ] = count;
+		}
+
+		Vec3 lmins, lmaxs;
+		ClearBounds( &lmins, &lmaxs );
+		count = 0;
+		float parent_area = SurfaceArea( mins, maxs );
+		for( u32 i = 0; i < BVH_NUM_BINS - 1; i++ ) {
+			if( bins[ i ].count > 0 ) {
+				AddBoundsToBounds( bins[ i ].mins, bins[ i ].maxs, &lmins, &lmaxs );
+			}
+			count += bins[ i ].count;
+			if( count == 0 || right_count[ i + 1 ] == 0 )
+				continue;
+
+			// 1 for the traversal step, then each side weighted by the chance of a trace going into it
+			float cost = 1.0f + ( count * SurfaceArea( lmins, lmaxs ) + right_count[ i + 1 ] * right_area[ i + 1 ] ) / parent_area;
+			if( cost < best_cost ) {
+				best_cost = cost;
+				best_axis = axis;
+				best_bin = i;
+			}
+		}
+	}
+
+	if( best_axis == -1 )
+		return 0;
+
+	float lo = cmins[ best_axis ];
+	float scale = BVH_NUM_BINS / ( cmaxs[ best_axis ] - lo );
+	BVHBuildItem * mid = std::partition( items.begin(), items.end(), [&]( const BVHBuildItem & item ) {
+		return BinForCentroid( item.centroid[ best_axis ], lo, scale ) <= best_bin;
+	} );
+
+	return mid - items.begin();
+}
+
+static size_t MedianSplit( Span< BVHBuildItem > items, Vec3 mins, Vec3 maxs ) {
+	Vec3 size = maxs - mins;
+	int axis = size.x > size.y ? ( size.x > size.z ? 0 : 2 ) : ( size.y > size.z ? 1 : 2 );
+
+	size_t half = items.n / 2;
+	std::nth_element( items.begin(), items.begin() + half, items.end(), [&]( const BVHBuildItem & a, const BVHBuildItem & b ) {
+		return a.centroid[ axis ] < b.centroid[ axis ];
+	} );
+
+	return half;
+}
+
+static u32 BuildBVHNode( DynamicArray< BVHNode > * nodes, DynamicArray< u32 > * leaf_items, Span< BVHBuildItem > items, u32 depth ) {
+	u32 idx = checked_cast< u32 >( nodes->add( BVHNode() ) );
+
+	Vec3 mins, maxs;
+	ClearBounds( &mins, &maxs );
+	for( const BVHBuildItem & item : items ) {
+		AddBoundsToBounds( item.mins, item.maxs, &mins, &maxs );
+	}
+
+	size_t split = 0;
+	if( items.n > BVH_MAX_LEAF_ITEMS ) {
+		split = depth < BVH_MAX_DEPTH ? FindSAHSplit( items, mins, maxs ) : MedianSplit( items, mins, maxs );
+	}
+
+	if( split == 0 ) {
+		// the SAH might prefer a leaf, but we don't want huge ones
+		if( items.n > BVH_MAX_LEAF_ITEMS * 4 ) {
+			split = MedianSplit( items, mins, maxs );
+		}
+	}
+
+	if( split == 0 ) {
+		BVHNode * node = &( *nodes )[ idx ];
+		node->mins = mins;
+		node->maxs = maxs;
+		node->first = checked_cast< u32 >( leaf_items->size() );
+		node->count = checked_cast< u32 >( items.n );
+		for( const BVHBuildItem & item : items ) {
+			leaf_items->add( item.item );
+		}
+		return idx;
+	}
+
+	BuildBVHNode( nodes, leaf_items, items.slice( 0, split ), depth + 1 );
+	u32 right = BuildBVHNode( nodes, leaf_items, items.slice( split, items.n ), depth + 1 );
+
+	// nodes can move when the array grows
+	BVHNode * node = &( *nodes )[ idx ];
+	node->mins = mins;
+	node->maxs = maxs;
+	node->first = right;
+	node->count = 0;
+
+	return idx;
+}
+
+void CM_BuildBVH( CModelServerOrClient soc, CollisionModel * cms ) {
+	ZoneScoped;
+
+	const cmodel_t * world = CM_FindCModel( soc, StringHash( cms->world_hash ) );
+
+	DynamicArray< BVHBuildItem > items( sys_allocator );
+
+	for( int i = 0; i < world->nummarkbrushes; i++ ) {
+		const cbrush_t * brush = &cms->map_brushes[ world->markbrushes[ i ] ];
+		if( brush->numsides == 0 )
+			continue;
+
+		BVHBuildItem item;
+		item.mins = brush->mins;
+		item.maxs = brush->maxs;
+		item.centroid = ( brush->mins + brush->maxs ) * 0.5f;
+		item.item = u32( world->markbrushes[ i ] );
+		items.add( item );
+	}
+
+	for( int i = 0; i < world->nummarkfaces; i++ ) {
+		const cface_t * face = &cms->map_faces[ world->markfaces[ i ] ];
+		if( face->numfacets == 0 )
+			continue;
+
+		BVHBuildItem item;
+		item.mins = face->mins;
+		item.maxs = face->maxs;
+		item.centroid = ( face->mins + face->maxs ) * 0.5f;
+		item.item = u32( world->markfaces[ i ] ) | BVH_ITEM_FACE;
+		items.add( item );
+	}
+
+	if( items.size() == 0 )
+		return;
+
+	DynamicArray< BVHNode > nodes( sys_allocator, items.size() * 2 );
+	DynamicArray< u32 > leaf_items( sys_allocator, items.size() );
+
+	BuildBVHNode( &nodes, &leaf_items, items.span(), 0 );
+
+	cms->num_bvh_nodes = checked_cast< u32 >( nodes.size() );
+	cms->bvh_nodes = ( BVHNode * ) Mem_Alloc( cmap_mempool, nodes.num_bytes() );
+	cms->bvh_items = ( u32 * ) Mem_Alloc( cmap_mempool, leaf_items.num_bytes() );
+	memcpy( cms->bvh_nodes, nodes.ptr(), nodes.num_bytes() );
+	memcpy( cms->bvh_items, leaf_items.ptr(), leaf_items.num_bytes() );
+}
@@ -22,14 +22,16 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "qcommon/hashmap.h"
 
 extern struct mempool_s * cmap_mempool;
+extern cvar_t * cm_bvh;
 
 #define CM_SUBDIV_LEVEL     ( 16 )
 
 cmodel_t * CM_NewCModel( CModelServerOrClient soc, u64 hash );
 
-void    CM_InitBoxHull( CollisionModel *cms );
-void    CM_InitOctagonHull( CollisionModel *cms );
-
 void    CM_FloodAreaConnections( CollisionModel *cms );
 
+void CM_BuildPlaneGroups( cbrush_t * brush, PlaneGroup * groups );
+
+void CM_BuildBVH( CModelServerOrClient soc, CollisionModel * cms );
+
 void CM_LoadQ3BrushModel( CModelServerOrClient soc, CollisionModel * cms, Span< const u8 > data );
@@ -28,6 +28,7 @@ static bool cm_initialized = false;
 mempool_t *cmap_mempool;
 
 static cvar_t *cm_noAreas;
+cvar_t *cm_bvh;
 
 static Hashmap< cmodel_t, 4096 > client_cmodels;
 static Hashmap< cmodel_t, 4096 > server_cmodels;
@@ -38,32 +39,6 @@ static Hashmap< cmodel_t, 4096 > * GetCModels( CModelServerOrClient soc ) {
 	return &server_cmodels;
 }
 
-/*
-* CM_AllocateCheckCounts
-*/
-static void CM_AllocateCheckCounts( CollisionModel *cms ) {
-	cms->checkcount = 0;
-	cms->map_brush_checkcheckouts = ( int * ) Mem_Alloc( cmap_mempool, cms->numbrushes * sizeof( int ) );
-	cms->map_face_checkcheckouts = ( int * ) Mem_Alloc( cmap_mempool, cms->numfaces * sizeof( int ) );
-}
-
-/*
-* CM_FreeCheckCounts
-*/
-static void CM_FreeCheckCounts( CollisionModel *cms ) {
-	cms->checkcount = 0;
-
-	if( cms->map_brush_checkcheckouts ) {
-		Mem_Free( cms->map_brush_checkcheckouts );
-		cms->map_brush_checkcheckouts = NULL;
-	}
-
-	if( cms->map_face_checkcheckouts ) {
-		Mem_Free( cms->map_face_checkcheckouts );
-		cms->map_face_checkcheckouts = NULL;
-	}
-}
-
 /*
 * CM_Clear
 */
@@ -144,6 +119,19 @@ static void CM_Clear( CModelServerOrClient soc, CollisionModel * cms ) {
 		cms->numbrushes = 0;
 	}
 
+	if( cms->bvh_nodes ) {
+		Mem_Free( cms->bvh_nodes );
+		Mem_Free( cms->bvh_items );
+		cms->bvh_nodes = NULL;
+		cms->bvh_items = NULL;
+		cms->num_bvh_nodes = 0;
+	}
+
+	if( cms->map_brush_plane_groups ) {
+		Mem_Free( cms->map_brush_plane_groups );
+		cms->map_brush_plane_groups = NULL;
+	}
+
 	if( cms->map_pvs ) {
 		Mem_Free( cms->map_pvs );
 		cms->map_pvs = NULL;
@@ -154,8 +142,6 @@ static void CM_Clear( CModelServerOrClient soc, CollisionModel * cms ) {
 		cms->map_entitystring = &cms->map_entitystring_empty;
 	}
 
-	CM_FreeCheckCounts( cms );
-
 	ClearBounds( &cms->world_mins, &cms->world_maxs );
 }
 
@@ -181,11 +167,10 @@ CollisionModel * CM_LoadMap( CModelServerOrClient soc, Span< const u8 > data, u6
 	const char * suffix = "*0";
 	cms->world_hash = Hash64( suffix, strlen( suffix ), cms->base_hash );
 
-	CM_InitBoxHull( cms );
-	CM_InitOctagonHull( cms );
 	CM_Clear( soc, cms );
 
 	CM_LoadQ3BrushModel( soc, cms, data );
+	CM_BuildBVH( soc, cms );
 
 	if( cms->numareas ) {
 		cms->map_areas = ( carea_t * ) Mem_Alloc( cmap_mempool, cms->numareas * sizeof( *cms->map_areas ) );
@@ -195,8 +180,6 @@ CollisionModel * CM_LoadMap( CModelServerOrClient soc, Span< const u8 > data, u6
 		CM_FloodAreaConnections( cms );
 	}
 
-	CM_AllocateCheckCounts( cms );
-
 	memset( cms->nullrow, 255, MAX_CM_LEAFS / 8 );
 
 	return cms;
@@ -579,6 +562,7 @@ void CM_Init( void ) {
 	cmap_mempool = Mem_AllocPool( NULL, "Collision Map" );
 
 	cm_noAreas = Cvar_Get( "cm_noAreas", "0", CVAR_CHEAT );
+	cm_bvh = Cvar_Get( "cm_bvh", "0", 0 );
 
 	cm_initialized = true;
 }
@@ -235,7 +235,12 @@ static void CM_CreatePatch( CollisionModel *cms, cface_t *patch, cshaderref_t *s
 	}
 
 	if( patch->numfacets ) {
-		uint8_t * fdata = ( uint8_t * ) Mem_Alloc( cmap_mempool, patch->numfacets * sizeof( cbrush_t ) + totalsides * ( sizeof( cbrushside_t ) + sizeof( cplane_t ) ) );
+		int totalgroups = 0;
+		for( int i = 0; i < patch->numfacets; i++ ) {
+			totalgroups += NumPlaneGroups( facets[ i ].numsides );
+		}
+
+		uint8_t * fdata = ( uint8_t * ) Mem_Alloc( cmap_mempool, patch->numfacets * sizeof( cbrush_t ) + totalsides * ( sizeof( cbrushside_t ) + sizeof( cplane_t ) ) + totalgroups * sizeof( PlaneGroup ) );
 
 		patch->facets = ( cbrush_t * )fdata; fdata += patch->numfacets * sizeof( cbrush_t );
 		memcpy( patch->facets, facets, patch->numfacets * sizeof( cbrush_t ) );
@@ -252,6 +257,9 @@ static void CM_CreatePatch( CollisionModel *cms, cface_t *patch, cshaderref_t *s
 				SnapPlane( &s->plane.normal, &s->plane.dist );
 				s->surfFlags = shaderref->flags;
 			}
+
+			facet->plane_groups = ( PlaneGroup * )fdata; fdata += NumPlaneGroups( facet->numsides ) * sizeof( PlaneGroup );
+			CM_BuildPlaneGroups( facet, facet->plane_groups );
 		}
 
 		patch->contents = shaderref->contents;
@@ -722,12 +730,22 @@ static void CMod_LoadBrushes( CollisionModel *cms, lump_t *l ) {
 	out = cms->map_brushes = ( cbrush_t * ) Mem_Alloc( cmap_mempool, count * sizeof( *out ) );
 	cms->numbrushes = count;
 
+	int numgroups = 0;
 	for( i = 0; i < count; i++, out++, in++ ) {
 		shaderref = LittleLong( in->shadernum );
 		out->contents = cms->map_shaderrefs[shaderref].contents;
 		out->numsides = LittleLong( in->numsides );
 		out->brushsides = cms->map_brushsides + LittleLong( in->firstside );
 		CM_BoundBrush( out );
+		numgroups += NumPlaneGroups( out->numsides );
+	}
+
+	PlaneGroup * groups = cms->map_brush_plane_groups = ( PlaneGroup * ) Mem_Alloc( cmap_mempool, Max2( numgroups, 1 ) * sizeof( PlaneGroup ) );
+	for( i = 0; i < count; i++ ) {
+		cbrush_t * brush = &cms->map_brushes[ i ];
+		brush->plane_groups = groups;
+		CM_BuildPlaneGroups( brush, groups );
+		groups += NumPlaneGroups( brush->numsides );
 	}
 }
 
@@ -19,7 +19,13 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 
 #include "qcommon/qcommon.h"
+#include "qcommon/array.h"
 #include "qcommon/cm_local.h"
+#include "qcommon/rng.h"
+#include "qcommon/threadpool.h"
+
+#include <float.h>
+#include <xmmintrin.h>
 
 typedef struct {
 	int leaf_topnode;
@@ -28,10 +34,45 @@ typedef struct {
 	Vec3 leaf_mins, leaf_maxs;
 } boxLeafsWork_t;
 
+/*
+ * Brushes and patches can be in more than one leaf, so traces keep a set of
+ * what they've already tested. Testing the same brush twice gives the same
+ * answer, so the set only needs to catch most repeats and stops taking new
+ * entries when it fills up. Keeping it per query means traces don't share any
+ * mutable state and can run on any thread.
+ */
+struct VisitedSet {
+	static constexpr u32 Capacity = 512;
+	static constexpr u32 MaxEntries = Capacity * 3 / 4;
+
+	u32 entries[ Capacity ]; // key + 1, 0 is empty
+	u32 n;
+};
+
+STATIC_ASSERT( IsPowerOf2( VisitedSet::Capacity ) );
+
+// returns true if key was already in the set
+static bool CheckAndAddVisited( VisitedSet * set, u32 key ) {
+	key++;
+
+	u32 i = ( key * U32( 2654435761 ) ) & ( VisitedSet::Capacity - 1 );
+	while( set->entries[ i ] != 0 ) {
+		if( set->entries[ i ] == key )
+			return true;
+		i = ( i + 1 ) & ( VisitedSet::Capacity - 1 );
+	}
+
+	if( set->n < VisitedSet::MaxEntries ) {
+		set->entries[ i ] = key;
+		set->n++;
+	}
+
+	return false;
+}
+
 typedef struct {
 	bool ispoint;
 	int contents;
-	int checkcount;
 
 	float realfraction;
 
@@ -53,8 +94,7 @@ typedef struct {
 	cface_t *faces;
 	int *markfaces;
 
-	int *brush_checkcounts;
-	int *face_checkcounts;
+	VisitedSet visited;
 } traceWork_t;
 
 /*
@@ -63,74 +103,29 @@ typedef struct {
 * Set up the planes so that the six floats of a bounding box
 * can just be stored out and get a proper clipping hull structure.
 */
-void CM_InitBoxHull( CollisionModel *cms ) {
-	cms->box_brush->numsides = 6;
-	cms->box_brush->brushsides = cms->box_brushsides;
-	cms->box_brush->contents = CONTENTS_BODY;
+static void CM_InitBoxHull( BoxHull * hull, int numsides ) {
+	hull->brush.numsides = numsides;
+	hull->brush.brushsides = hull->brushsides;
+	hull->brush.plane_groups = hull->plane_groups;
+	hull->brush.contents = CONTENTS_BODY;
 
 	// Make sure CM_CollideBox() will not reject the brush by its bounds
-	ClearBounds( &cms->box_brush->maxs, &cms->box_brush->mins );
+	ClearBounds( &hull->brush.maxs, &hull->brush.mins );
 
-	cms->box_markbrushes[0] = 0;
+	hull->markbrushes[0] = 0;
 
-	cms->box_cmodel->brushes = cms->box_brush;
-	cms->box_cmodel->builtin = true;
-	cms->box_cmodel->nummarkfaces = 0;
-	cms->box_cmodel->markfaces = NULL;
-	cms->box_cmodel->markbrushes = cms->box_markbrushes;
-	cms->box_cmodel->nummarkbrushes = 1;
-
-	for( int i = 0; i < 6; i++ ) {
-		// brush sides
-		cbrushside_t * s = cms->box_brushsides + i;
-		s->surfFlags = 0;
-
-		// planes
-		cplane_t * p = &s->plane;
-		p->normal = Vec3( 0.0f );
-
-		if( ( i & 1 ) ) {
-			p->normal[i >> 1] = -1;
-		} else {
-			p->normal[i >> 1] = 1;
-		}
-	}
-}
-
-/*
-* CM_InitOctagonHull
-*
-* Set up the planes so that the six floats of a bounding box
-* can just be stored out and get a proper clipping hull structure.
-*/
-void CM_InitOctagonHull( CollisionModel *cms ) {
-	const Vec3 oct_dirs[4] = {
-		Vec3(  1.0f,  1.0f, 0.0f ),
-		Vec3( -1.0f,  1.0f, 0.0f ),
-		Vec3( -1.0f, -1.0f, 0.0f ),
-		Vec3(  1.0f, -1.0f, 0.0f )
-	};
-
-	cms->oct_brush->numsides = 10;
-	cms->oct_brush->brushsides = cms->oct_brushsides;
-	cms->oct_brush->contents = CONTENTS_BODY;
-
-	// Make sure CM_CollideBox() will not reject the brush by its bounds
-	ClearBounds( &cms->oct_brush->maxs, &cms->oct_brush->mins );
-
-	cms->oct_markbrushes[0] = 0;
-
-	cms->oct_cmodel->brushes = cms->oct_brush;
-	cms->oct_cmodel->builtin = true;
-	cms->oct_cmodel->nummarkfaces = 0;
-	cms->oct_cmodel->markfaces = NULL;
-	cms->oct_cmodel->markbrushes = cms->oct_markbrushes;
-	cms->oct_cmodel->nummarkbrushes = 1;
+	hull->cmodel = { };
+	hull->cmodel.brushes = &hull->brush;
+	hull->cmodel.builtin = true;
+	hull->cmodel.nummarkfaces = 0;
+	hull->cmodel.markfaces = NULL;
+	hull->cmodel.markbrushes = hull->markbrushes;
+	hull->cmodel.nummarkbrushes = 1;
 
 	// axial planes
 	for( int i = 0; i < 6; i++ ) {
 		// brush sides
-		cbrushside_t * s = cms->oct_brushsides + i;
+		cbrushside_t * s = hull->brushsides + i;
 		s->surfFlags = 0;
 
 		// planes
@@ -144,15 +139,8 @@ void CM_InitOctagonHull( CollisionModel *cms ) {
 		}
 	}
 
-	// non-axial planes
-	for( int i = 6; i < 10; i++ ) {
-		// brush sides
-		cbrushside_t * s = cms->oct_brushsides + i;
-		s->surfFlags = 0;
-
-		// planes
-		cplane_t * p = &s->plane;
-		p->normal = oct_dirs[i - 6];
+	for( int i = 6; i < numsides; i++ ) {
+		hull->brushsides[ i ].surfFlags = 0;
 	}
 }
 
@@ -161,18 +149,22 @@ void CM_InitOctagonHull( CollisionModel *cms ) {
 *
 * To keep everything totally uniform, bounding boxes are turned into inline models
 */
-cmodel_t *CM_ModelForBBox( CollisionModel *cms, Vec3 mins, Vec3 maxs ) {
-	cms->box_brushsides[0].plane.dist = maxs.x;
-	cms->box_brushsides[1].plane.dist = -mins.x;
-	cms->box_brushsides[2].plane.dist = maxs.y;
-	cms->box_brushsides[3].plane.dist = -mins.y;
-	cms->box_brushsides[4].plane.dist = maxs.z;
-	cms->box_brushsides[5].plane.dist = -mins.z;
+cmodel_t *CM_ModelForBBox( BoxHull * hull, Vec3 mins, Vec3 maxs ) {
+	CM_InitBoxHull( hull, 6 );
+
+	hull->brushsides[0].plane.dist = maxs.x;
+	hull->brushsides[1].plane.dist = -mins.x;
+	hull->brushsides[2].plane.dist = maxs.y;
+	hull->brushsides[3].plane.dist = -mins.y;
+	hull->brushsides[4].plane.dist = maxs.z;
+	hull->brushsides[5].plane.dist = -mins.z;
 
-	cms->box_cmodel->mins = mins;
-	cms->box_cmodel->maxs = maxs;
+	hull->cmodel.mins = mins;
+	hull->cmodel.maxs = maxs;
 
-	return cms->box_cmodel;
+	CM_BuildPlaneGroups( &hull->brush, hull->plane_groups );
+
+	return &hull->cmodel;
 }
 
 /*
@@ -181,25 +173,27 @@ cmodel_t *CM_ModelForBBox( CollisionModel *cms, Vec3 mins, Vec3 maxs ) {
 * Same as CM_ModelForBBox with 4 additional planes at corners.
 * Internally offset to be symmetric on all sides.
 */
-cmodel_t *CM_OctagonModelForBBox( CollisionModel *cms, Vec3 mins, Vec3 maxs ) {
+cmodel_t *CM_OctagonModelForBBox( BoxHull * hull, Vec3 mins, Vec3 maxs ) {
 	float a, b, d, t;
 	float sina, cosa;
 	Vec3 offset, size[2];
 
+	CM_InitBoxHull( hull, 10 );
+
 	offset = ( mins + maxs ) * 0.5f;
 	size[0] = mins - offset;
 	size[1] = maxs - offset;
 
-	cms->oct_cmodel->cyl_offset = offset;
-	cms->oct_cmodel->mins = size[0];
-	cms->oct_cmodel->maxs = size[1];
+	hull->cmodel.cyl_offset = offset;
+	hull->cmodel.mins = size[0];
+	hull->cmodel.maxs = size[1];
 
-	cms->oct_brushsides[0].plane.dist = size[1].x;
-	cms->oct_brushsides[1].plane.dist = -size[0].x;
-	cms->oct_brushsides[2].plane.dist = size[1].y;
-	cms->oct_brushsides[3].plane.dist = -size[0].y;
-	cms->oct_brushsides[4].plane.dist = size[1].z;
-	cms->oct_brushsides[5].plane.dist = -size[0].z;
+	hull->brushsides[0].plane.dist = size[1].x;
+	hull->brushsides[1].plane.dist = -size[0].x;
+	hull->brushsides[2].plane.dist = size[1].y;
+	hull->brushsides[3].plane.dist = -size[0].y;
+	hull->brushsides[4].plane.dist = size[1].z;
+	hull->brushsides[5].plane.dist = -size[0].z;
 
 	a = size[1].x; // halfx
 	b = size[1].y; // halfy
@@ -217,21 +211,21 @@ cmodel_t *CM_OctagonModelForBBox( CollisionModel *cms, Vec3 mins, Vec3 maxs ) {
 	d = a * b / sqrtf( a * a * cosa * cosa + b * b * sina * sina );
 	//d = a * b / sqrtf( a * a  + b * b ); // produces a rectangle, inscribed at middle points
 
-	// the following should match normals set in CM_InitOctagonHull
+	hull->brushsides[6].plane.normal = Vec3( cosa, sina, 0 );
+	hull->brushsides[6].plane.dist = d;
 
-	cms->oct_brushsides[6].plane.normal = Vec3( cosa, sina, 0 );
-	cms->oct_brushsides[6].plane.dist = d;
+	hull->brushsides[7].plane.normal = Vec3( -cosa, sina, 0 );
+	hull->brushsides[7].plane.dist = d;
 
-	cms->oct_brushsides[7].plane.normal = Vec3( -cosa, sina, 0 );
-	cms->oct_brushsides[7].plane.dist = d;
+	hull->brushsides[8].plane.normal = Vec3( -cosa, -sina, 0 );
+	hull->brushsides[8].plane.dist = d;
 
-	cms->oct_brushsides[8].plane.normal = Vec3( -cosa, -sina, 0 );
-	cms->oct_brushsides[8].plane.dist = d;
+	hull->brushsides[9].plane.normal = Vec3( cosa, -sina, 0 );
+	hull->brushsides[9].plane.dist = d;
 
-	cms->oct_brushsides[9].plane.normal = Vec3( cosa, -sina, 0 );
-	cms->oct_brushsides[9].plane.dist = d;
+	CM_BuildPlaneGroups( &hull->brush, hull->plane_groups );
 
-	return cms->oct_cmodel;
+	return &hull->cmodel;
 }
 
 int CM_PointLeafnum( const CollisionModel *cms, Vec3 p ) {
@@ -454,6 +448,74 @@ BOX TRACING
 // 1/32 epsilon to keep floating point happy
 #define DIST_EPSILON    ( 1.0f / 32.0f )
 
+/*
+ * The brush kernels test 4 planes at a time out of brush->plane_groups. They
+ * do the same float ops in the same order as the one plane at a time versions
+ * further down, and pick the enter/leave planes in the same order, so they
+ * give bit identical results. The scalar versions are kept as the reference
+ * for brushbench to check against.
+ */
+
+struct TraceBoxSIMD {
+	__m128 start_x, start_y, start_z;
+	__m128 end_x, end_y, end_z;
+	__m128 mins_x, mins_y, mins_z;
+	__m128 maxs_x, maxs_y, maxs_z;
+};
+
+static TraceBoxSIMD LoadTraceBox( const traceWork_t * tw ) {
+	TraceBoxSIMD box;
+	box.start_x = _mm_set1_ps( tw->start.x );
+	box.start_y = _mm_set1_ps( tw->start.y );
+	box.start_z = _mm_set1_ps( tw->start.z );
+	box.end_x = _mm_set1_ps( tw->end.x );
+	box.end_y = _mm_set1_ps( tw->end.y );
+	box.end_z = _mm_set1_ps( tw->end.z );
+	box.mins_x = _mm_set1_ps( tw->mins.x );
+	box.mins_y = _mm_set1_ps( tw->mins.y );
+	box.mins_z = _mm_set1_ps( tw->mins.z );
+	box.maxs_x = _mm_set1_ps( tw->maxs.x );
+	box.maxs_y = _mm_set1_ps( tw->maxs.y );
+	box.maxs_z = _mm_set1_ps( tw->maxs.z );
+	return box;
+}
+
+// the box corner furthest behind the plane, normal < 0 ? maxs : mins
+static inline __m128 SelectCorner( __m128 normal, __m128 mins, __m128 maxs ) {
+	__m128 negative = _mm_cmplt_ps( normal, _mm_setzero_ps() );
+	return _mm_or_ps( _mm_and_ps( negative, maxs ), _mm_andnot_ps( negative, mins ) );
+}
+
+// Dot( normal, p + corner ), summed x + y + z like Dot
+static inline __m128 DotCorner( __m128 nx, __m128 ny, __m128 nz, __m128 px, __m128 py, __m128 pz, __m128 cx, __m128 cy, __m128 cz ) {
+	__m128 dx = _mm_mul_ps( nx, _mm_add_ps( px, cx ) );
+	__m128 dy = _mm_mul_ps( ny, _mm_add_ps( py, cy ) );
+	__m128 dz = _mm_mul_ps( nz, _mm_add_ps( pz, cz ) );
+	return _mm_add_ps( _mm_add_ps( dx, dy ), dz );
+}
+
+void CM_BuildPlaneGroups( cbrush_t * brush, PlaneGroup * groups ) {
+	for( int i = 0; i < NumPlaneGroups( brush->numsides ) * 4; i++ ) {
+		PlaneGroup * group = &groups[ i / 4 ];
+		int lane = i % 4;
+
+		if( i < brush->numsides ) {
+			const cplane_t * p = &brush->brushsides[ i ].plane;
+			group->normal_x[ lane ] = p->normal.x;
+			group->normal_y[ lane ] = p->normal.y;
+			group->normal_z[ lane ] = p->normal.z;
+			group->dist[ lane ] = p->dist;
+		}
+		else {
+			// everything is behind this, so it never clips or gets the trace out
+			group->normal_x[ lane ] = 0.0f;
+			group->normal_y[ lane ] = 0.0f;
+			group->normal_z[ lane ] = 0.0f;
+			group->dist[ lane ] = FLT_MAX;
+		}
+	}
+}
+
 static void CM_ClipBoxToBrush( traceWork_t *tw, const cbrush_t *brush ) {
 	ZoneScoped;
 
@@ -461,6 +523,151 @@ static void CM_ClipBoxToBrush( traceWork_t *tw, const cbrush_t *brush ) {
 		return;
 	}
 
+	float enterfrac = -1.0f;
+	float leavefrac = 1.0f;
+	float enterfrac2 = -1.0f;
+	int leadside = -1;
+
+	int getout = 0;
+	int startout = 0;
+
+	TraceBoxSIMD box = LoadTraceBox( tw );
+	__m128 zero = _mm_setzero_ps();
+
+	for( int i = 0; i < NumPlaneGroups( brush->numsides ); i++ ) {
+		const PlaneGroup * group = &brush->plane_groups[ i ];
+		__m128 nx = _mm_loadu_ps( group->normal_x );
+		__m128 ny = _mm_loadu_ps( group->normal_y );
+		__m128 nz = _mm_loadu_ps( group->normal_z );
+		__m128 dist = _mm_loadu_ps( group->dist );
+
+		__m128 cx = SelectCorner( nx, box.mins_x, box.maxs_x );
+		__m128 cy = SelectCorner( ny, box.mins_y, box.maxs_y );
+		__m128 cz = SelectCorner( nz, box.mins_z, box.maxs_z );
+
+		__m128 dot1 = DotCorner( nx, ny, nz, box.start_x, box.start_y, box.start_z, cx, cy, cz );
+		__m128 dot2 = DotCorner( nx, ny, nz, box.end_x, box.end_y, box.end_z, cx, cy, cz );
+		__m128 d1 = _mm_sub_ps( dot1, dist );
+		__m128 d2 = _mm_sub_ps( dot2, dist );
+
+		__m128 start_in_front = _mm_cmpgt_ps( d1, zero );
+		__m128 end_in_front = _mm_cmpgt_ps( d2, zero );
+
+		// if completely in front of any face, no intersection
+		if( _mm_movemask_ps( _mm_and_ps( start_in_front, _mm_cmpge_ps( d2, d1 ) ) ) != 0 ) {
+			return;
+		}
+
+		int starts_out = _mm_movemask_ps( start_in_front );
+		int ends_out = _mm_movemask_ps( end_in_front );
+		startout |= starts_out;
+		getout |= ends_out;
+
+		int crosses = starts_out | ends_out;
+		if( crosses == 0 ) {
+			continue;
+		}
+
+		// -ffast-math cancels out the dists in the scalar loop's d1 - d2, so
+		// do the same here to get the same roundings
+		__m128 f = _mm_sub_ps( dot1, dot2 );
+		int enters = crosses & _mm_movemask_ps( _mm_cmpgt_ps( f, zero ) );
+		int leaves = crosses & _mm_movemask_ps( _mm_cmplt_ps( f, zero ) );
+
+		alignas( 16 ) float d1s[ 4 ];
+		alignas( 16 ) float fs[ 4 ];
+		_mm_store_ps( d1s, d1 );
+		_mm_store_ps( fs, f );
+
+		// walk the lanes in order so ties go to the same plane as the scalar
+		// loop. the divisions stay scalar because -ffast-math turns packed
+		// division into rcpps, which rounds differently
+		for( int lane = 0; lane < 4; lane++ ) {
+			if( enters & ( 1 << lane ) ) {
+				float frac = d1s[ lane ] / fs[ lane ];
+				if( frac > enterfrac ) {
+					enterfrac = frac;
+					leadside = i * 4 + lane;
+					enterfrac2 = ( d1s[ lane ] - DIST_EPSILON ) / fs[ lane ]; // nudged fraction
+				}
+			}
+			else if( leaves & ( 1 << lane ) ) {
+				float frac = d1s[ lane ] / fs[ lane ];
+				if( frac < leavefrac ) {
+					leavefrac = frac;
+				}
+			}
+		}
+	}
+
+	if( startout == 0 ) {
+		// original point was inside brush
+		tw->trace->startsolid = true;
+		tw->contents = brush->contents;
+		if( getout == 0 ) {
+			tw->realfraction = 0;
+			tw->trace->allsolid = true;
+			tw->trace->fraction = 0;
+		}
+		return;
+	}
+
+	if( enterfrac <= -1 || enterfrac > leavefrac ) {
+		return;
+	}
+
+	// check if this will reduce the collision time range
+	if( enterfrac < tw->realfraction ) {
+		if( enterfrac2 < tw->trace->fraction ) {
+			const cbrushside_t * side = &brush->brushsides[ leadside ];
+			tw->realfraction = enterfrac;
+			tw->trace->plane = side->plane;
+			tw->trace->surfFlags = side->surfFlags;
+			tw->trace->contents = brush->contents;
+			tw->trace->fraction = enterfrac2;
+		}
+	}
+}
+
+static void CM_TestBoxInBrush( traceWork_t *tw, const cbrush_t *brush ) {
+	ZoneScoped;
+
+	if( !brush->numsides ) {
+		return;
+	}
+
+	TraceBoxSIMD box = LoadTraceBox( tw );
+
+	for( int i = 0; i < NumPlaneGroups( brush->numsides ); i++ ) {
+		const PlaneGroup * group = &brush->plane_groups[ i ];
+		__m128 nx = _mm_loadu_ps( group->normal_x );
+		__m128 ny = _mm_loadu_ps( group->normal_y );
+		__m128 nz = _mm_loadu_ps( group->normal_z );
+		__m128 dist = _mm_loadu_ps( group->dist );
+
+		__m128 cx = SelectCorner( nx, box.mins_x, box.maxs_x );
+		__m128 cy = SelectCorner( ny, box.mins_y, box.maxs_y );
+		__m128 cz = SelectCorner( nz, box.mins_z, box.maxs_z );
+
+		__m128 d = DotCorner( nx, ny, nz, box.start_x, box.start_y, box.start_z, cx, cy, cz );
+		if( _mm_movemask_ps( _mm_cmpgt_ps( d, dist ) ) != 0 ) {
+			return;
+		}
+	}
+
+	// inside this brush
+	tw->trace->startsolid = tw->trace->allsolid = true;
+	tw->trace->fraction = 0;
+	tw->trace->contents = brush->contents;
+}
+
+static void CM_ClipBoxToBrushReference( traceWork_t *tw, const cbrush_t *brush ) {
+	ZoneScoped;
+
+	if( !brush->numsides ) {
+		return;
+	}
+
 	float enterfrac = -1.0f;
 	float leavefrac = 1.0f;
 	float enterfrac2 = -1.0f;
@@ -550,7 +757,7 @@ static void CM_ClipBoxToBrush( traceWork_t *tw, const cbrush_t *brush ) {
 	}
 }
 
-static void CM_TestBoxInBrush( traceWork_t *tw, const cbrush_t *brush ) {
+static void CM_TestBoxInBrushReference( traceWork_t *tw, const cbrush_t *brush ) {
 	ZoneScoped;
 
 	if( !brush->numsides ) {
@@ -579,65 +786,69 @@ static void CM_TestBoxInBrush( traceWork_t *tw, const cbrush_t *brush ) {
 	tw->trace->contents = brush->contents;
 }
 
-static void CM_CollideBox( traceWork_t *tw, const int *markbrushes, int nummarkbrushes, const int *markfaces, int nummarkfaces, void ( *func )( traceWork_t *, const cbrush_t *b ) ) {
+typedef void ( *BrushCollideFunc )( traceWork_t *, const cbrush_t * );
+
+// these return true when the trace is completely blocked and there's no point testing anything else
+static bool CM_CollideBrush( traceWork_t *tw, const cbrush_t *b, BrushCollideFunc func ) {
+	if( !( b->contents & tw->contents ) ) {
+		return false;
+	}
+	if( !BoundsOverlap( b->mins, b->maxs, tw->absmins, tw->absmaxs ) ) {
+		return false;
+	}
+	func( tw, b );
+	return !tw->trace->fraction;
+}
+
+static bool CM_CollidePatch( traceWork_t *tw, const cface_t *patch, BrushCollideFunc func ) {
+	if( !( patch->contents & tw->contents ) ) {
+		return false;
+	}
+	if( !BoundsOverlap( patch->mins, patch->maxs, tw->absmins, tw->absmaxs ) ) {
+		return false;
+	}
+	const cbrush_t * facet = patch->facets;
+	for( int j = 0; j < patch->numfacets; j++, facet++ ) {
+		if( !BoundsOverlap( facet->mins, facet->maxs, tw->absmins, tw->absmaxs ) ) {
+			continue;
+		}
+		func( tw, facet );
+		if( !tw->trace->fraction ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static void CM_CollideBox( traceWork_t *tw, const int *markbrushes, int nummarkbrushes, const int *markfaces, int nummarkfaces, BrushCollideFunc func ) {
 	ZoneScoped;
 
 	const cbrush_t *brushes = tw->brushes;
 	const cface_t *faces = tw->faces;
-	int checkcount = tw->checkcount;
 
 	// trace line against all brushes
 	for( int i = 0; i < nummarkbrushes; i++ ) {
 		int mb = markbrushes[i];
-		const cbrush_t *b = brushes + mb;
 
-		if( tw->brush_checkcounts[mb] == checkcount ) {
+		if( CheckAndAddVisited( &tw->visited, u32( mb ) << 1 ) ) {
 			continue; // already checked this brush
 		}
-		tw->brush_checkcounts[mb] = checkcount;
 
-		if( !( b->contents & tw->contents ) ) {
-			continue;
-		}
-		if( !BoundsOverlap( b->mins, b->maxs, tw->absmins, tw->absmaxs ) ) {
-			continue;
-		}
-		func( tw, b );
-		if( !tw->trace->fraction ) {
+		if( CM_CollideBrush( tw, brushes + mb, func ) ) {
 			return;
 		}
 	}
 
-	if( !nummarkfaces ) {
-		return;
-	}
-
 	// trace line against all patches
 	for( int i = 0; i < nummarkfaces; i++ ) {
 		int mf = markfaces[i];
-		const cface_t *patch = faces + mf;
 
-		if( tw->face_checkcounts[mf] == checkcount ) {
-			continue; // already checked this brush
+		if( CheckAndAddVisited( &tw->visited, ( u32( mf ) << 1 ) | 1 ) ) {
+			continue; // already checked this patch
 		}
-		tw->face_checkcounts[mf] = checkcount;
 
-		if( !( patch->contents & tw->contents ) ) {
-			continue;
-		}
-		if( !BoundsOverlap( patch->mins, patch->maxs, tw->absmins, tw->absmaxs ) ) {
-			continue;
-		}
-		const cbrush_t * facet = patch->facets;
-		int j;
-		for( j = 0; j < patch->numfacets; j++, facet++ ) {
-			if( !BoundsOverlap( facet->mins, facet->maxs, tw->absmins, tw->absmaxs ) ) {
-				continue;
-			}
-			func( tw, facet );
-			if( !tw->trace->fraction ) {
-				return;
-			}
+		if( CM_CollidePatch( tw, faces + mf, func ) ) {
+			return;
 		}
 	}
 }
@@ -738,6 +949,181 @@ loc0:
 	CM_RecursiveHullCheck( tw, node->children[side ^ 1], midf, p2f, mid, p2 );
 }
 
+/*
+* CM_TraceBVH
+*
+* Walks the world BVH front to back. Nodes are tested as the segment against
+* their bounds grown by the trace box, plus a unit to be safe, which also
+* gives a lower bound on the fraction anything inside can be hit at, so
+* nodes further away than the nearest hit so far get skipped like
+* CM_RecursiveHullCheck skips leafs
+*/
+
+struct BVHTraversalRay {
+	Vec3 start;
+	Vec3 dir;
+	Vec3 inv_dir;
+	bool axial[ 3 ]; // dir is ~0 on this axis
+	Vec3 grow_mins, grow_maxs;
+};
+
+// returns false if the segment misses the bounds, otherwise the fraction it enters at
+static bool RayBoundsIntersect( const BVHTraversalRay * ray, Vec3 mins, Vec3 maxs, float * enter ) {
+	float t0 = 0.0f;
+	float t1 = 1.0f;
+
+	for( int i = 0; i < 3; i++ ) {
+		float lo = mins[ i ] - ray->grow_maxs[ i ];
+		float hi = maxs[ i ] - ray->grow_mins[ i ];
+
+		if( ray->axial[ i ] ) {
+			if( ray->start[ i ] < lo || ray->start[ i ] > hi )
+				return false;
+			continue;
+		}
+
+		float a = ( lo - ray->start[ i ] ) * ray->inv_dir[ i ];
+		float b = ( hi - ray->start[ i ] ) * ray->inv_dir[ i ];
+		t0 = Max2( t0, Min2( a, b ) );
+		t1 = Min2( t1, Max2( a, b ) );
+		if( t0 > t1 )
+			return false;
+	}
+
+	*enter = t0;
+	return true;
+}
+
+static bool RayNodeIntersect( const BVHTraversalRay * ray, const BVHNode * node, float * enter ) {
+	return RayBoundsIntersect( ray, node->mins, node->maxs, enter );
+}
+
+static bool CM_CollideBVHLeaf( traceWork_t *tw, const CollisionModel *cms, const BVHNode *node, BrushCollideFunc func ) {
+	for( u32 i = 0; i < node->count; i++ ) {
+		u32 item = cms->bvh_items[ node->first + i ];
+		bool blocked = ( item & BVH_ITEM_FACE ) != 0 ?
+			CM_CollidePatch( tw, &cms->map_faces[ item & ~BVH_ITEM_FACE ], func ) :
+			CM_CollideBrush( tw, &cms->map_brushes[ item ], func );
+		if( blocked ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+* CM_ClipBVHLeaf
+*
+* The move's absmins/absmaxs are huge for long diagonal traces, so check the
+* segment against each item's bounds before running the brush kernel on it
+*/
+static bool CM_ClipBVHLeaf( traceWork_t *tw, const CollisionModel *cms, const BVHTraversalRay *ray, const BVHNode *node ) {
+	for( u32 i = 0; i < node->count; i++ ) {
+		u32 item = cms->bvh_items[ node->first + i ];
+		bool face = ( item & BVH_ITEM_FACE ) != 0;
+		const cface_t * patch = face ? &cms->map_faces[ item & ~BVH_ITEM_FACE ] : NULL;
+		const cbrush_t * brush = face ? NULL : &cms->map_brushes[ item ];
+
+		float enter;
+		if( !RayBoundsIntersect( ray, face ? patch->mins : brush->mins, face ? patch->maxs : brush->maxs, &enter ) || tw->realfraction <= enter )
+			continue;
+
+		bool blocked = face ? CM_CollidePatch( tw, patch, CM_ClipBoxToBrush ) : CM_CollideBrush( tw, brush, CM_ClipBoxToBrush );
+		if( blocked ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static void CM_TraceBVH( traceWork_t *tw, const CollisionModel *cms ) {
+	ZoneScoped;
+
+	BVHTraversalRay ray;
+	ray.start = tw->start;
+	ray.dir = tw->end - tw->start;
+	for( int i = 0; i < 3; i++ ) {
+		ray.axial[ i ] = Abs( ray.dir[ i ] ) < 1e-6f;
+		ray.inv_dir[ i ] = ray.axial[ i ] ? 0.0f : 1.0f / ray.dir[ i ];
+	}
+	ray.grow_mins = tw->mins - Vec3( 1.0f );
+	ray.grow_maxs = tw->maxs + Vec3( 1.0f );
+
+	struct StackEntry {
+		u32 node;
+		float enter;
+	};
+
+	StackEntry stack[ 64 ];
+	u32 stack_size = 0;
+
+	float enter;
+	if( !RayNodeIntersect( &ray, &cms->bvh_nodes[ 0 ], &enter ) )
+		return;
+	stack[ stack_size++ ] = { 0, enter };
+
+	while( stack_size > 0 ) {
+		StackEntry top = stack[ --stack_size ];
+		if( tw->realfraction <= top.enter ) {
+			continue; // already hit something nearer
+		}
+
+		const BVHNode * node = &cms->bvh_nodes[ top.node ];
+		if( node->count > 0 ) {
+			if( CM_ClipBVHLeaf( tw, cms, &ray, node ) ) {
+				return;
+			}
+			continue;
+		}
+
+		u32 children[ 2 ] = { top.node + 1, node->first };
+		float enters[ 2 ];
+		bool hits[ 2 ];
+		for( int i = 0; i < 2; i++ ) {
+			hits[ i ] = RayNodeIntersect( &ray, &cms->bvh_nodes[ children[ i ] ], &enters[ i ] );
+		}
+
+		// push the far child first so the near one gets popped first
+		int near = enters[ 1 ] < enters[ 0 ] ? 1 : 0;
+		if( hits[ near ^ 1 ] ) {
+			stack[ stack_size++ ] = { children[ near ^ 1 ], enters[ near ^ 1 ] };
+		}
+		if( hits[ near ] ) {
+			stack[ stack_size++ ] = { children[ near ], enters[ near ] };
+		}
+	}
+}
+
+/*
+* CM_TestBVH
+*
+* Position test version of CM_TraceBVH, which only needs bounds checks
+*/
+static void CM_TestBVH( traceWork_t *tw, const CollisionModel *cms ) {
+	ZoneScoped;
+
+	u32 stack[ 64 ];
+	u32 stack_size = 0;
+	stack[ stack_size++ ] = 0;
+
+	while( stack_size > 0 ) {
+		const BVHNode * node = &cms->bvh_nodes[ stack[ --stack_size ] ];
+		if( !BoundsOverlap( node->mins, node->maxs, tw->absmins, tw->absmaxs ) ) {
+			continue;
+		}
+
+		if( node->count > 0 ) {
+			if( CM_CollideBVHLeaf( tw, cms, node, CM_TestBoxInBrush ) ) {
+				return;
+			}
+			continue;
+		}
+
+		stack[ stack_size++ ] = node->first;
+		stack[ stack_size++ ] = u32( node - cms->bvh_nodes ) + 1;
+	}
+}
+
 static void CM_BoxTrace( traceWork_t *tw, CollisionModel *cms, trace_t *tr,
 	Vec3 start, Vec3 end, Vec3 mins, Vec3 maxs,
 	cmodel_t *cmodel, Vec3 origin, int brushmask ) {
@@ -754,12 +1140,9 @@ static void CM_BoxTrace( traceWork_t *tw, CollisionModel *cms, trace_t *tr,
 		return;
 	}
 
-	cms->checkcount++;  // for multi-check avoidance
-
 	memset( tw, 0, sizeof( *tw ) );
 	// the epsilon considers blockers with realfraction == 1 and nudged fraction < 1
 	tw->realfraction = 1 + DIST_EPSILON;
-	tw->checkcount = cms->checkcount;
 	tw->trace = tr;
 	tw->contents = brushmask;
 	tw->cms = cms;
@@ -783,22 +1166,16 @@ static void CM_BoxTrace( traceWork_t *tw, CollisionModel *cms, trace_t *tr,
 	tw->brushes = cmodel->brushes;
 	tw->faces = cmodel->faces;
 
-	if( cmodel == cms->oct_cmodel ) {
-		tw->brush_checkcounts = &cms->oct_checkcount;
-		tw->face_checkcounts = NULL;
-	} else if( cmodel == cms->box_cmodel ) {
-		tw->brush_checkcounts = &cms->box_checkcount;
-		tw->face_checkcounts = NULL;
-	} else {
-		tw->brush_checkcounts = cms->map_brush_checkcheckouts;
-		tw->face_checkcounts = cms->map_face_checkcheckouts;
-	}
-
 	//
 	// check for position test special case
 	//
+	bool bvh = world && cm_bvh->integer != 0 && cms->bvh_nodes != NULL;
+
 	if( start == end ) {
-		if( world ) {
+		if( bvh ) {
+			CM_TestBVH( tw, cms );
+		}
+		else if( world ) {
 			Vec3 c1 = start + mins - Vec3( 1.0f );
 			Vec3 c2 = start + maxs + Vec3( 1.0f );
 
@@ -841,7 +1218,10 @@ static void CM_BoxTrace( traceWork_t *tw, CollisionModel *cms, trace_t *tr,
 	//
 	// general sweeping through world
 	//
-	if( world ) {
+	if( bvh ) {
+		CM_TraceBVH( tw, cms );
+	}
+	else if( world ) {
 		CM_RecursiveHullCheck( tw, 0, 0, 1, start, end );
 	}
 	else if( BoundsOverlap( cmodel->mins, cmodel->maxs, tw->absmins, tw->absmaxs ) ) {
@@ -878,8 +1258,8 @@ void CM_TransformedBoxTrace( CModelServerOrClient soc, CollisionModel * cms, tra
 		angles = Vec3( 0.0f );
 	}
 
-	// cylinder offset
-	if( cmodel == cms->oct_cmodel ) {
+	// cylinder offset, zero for boxes
+	if( cmodel->builtin ) {
 		start_l = start - cmodel->cyl_offset;
 		end_l = end - cmodel->cyl_offset;
 	} else {
@@ -925,3 +1305,361 @@ void CM_TransformedBoxTrace( CModelServerOrClient soc, CollisionModel * cms, tra
 
 	tr->endpos = Lerp( start, tr->fraction, end );
 }
+
+/*
+* CM_TraceStressTest
+*
+* Traces random boxes through the world and against temporary hulls on one
+* thread, then does the same traces again from the thread pool and checks
+* every result is identical
+*/
+
+struct StressTestTrace {
+	Vec3 start, end;
+	Vec3 mins, maxs;
+	int hull; // 0 = world, 1 = box, 2 = octagon
+	Vec3 hull_origin;
+	Vec3 hull_mins, hull_maxs;
+
+	CModelServerOrClient soc;
+	CollisionModel * cms;
+	trace_t result;
+};
+
+static void StressTestTraceJob( TempAllocator * temp, void * data ) {
+	StressTestTrace * t = ( StressTestTrace * ) data;
+
+	BoxHull hull;
+	cmodel_t * cmodel = NULL;
+	if( t->hull == 1 ) {
+		cmodel = CM_ModelForBBox( &hull, t->hull_mins, t->hull_maxs );
+	}
+	else if( t->hull == 2 ) {
+		cmodel = CM_OctagonModelForBBox( &hull, t->hull_mins, t->hull_maxs );
+	}
+
+	CM_TransformedBoxTrace( t->soc, t->cms, &t->result, t->start, t->end, t->mins, t->maxs, cmodel, MASK_PLAYERSOLID, t->hull_origin, Vec3( 0.0f ) );
+}
+
+void CM_TraceStressTest( CModelServerOrClient soc, CollisionModel * cms, u32 num_traces, u32 iterations ) {
+	StressTestTrace * traces = ALLOC_MANY( sys_allocator, StressTestTrace, num_traces );
+	trace_t * expected = ALLOC_MANY( sys_allocator, trace_t, num_traces );
+	defer { FREE( sys_allocator, traces ); };
+	defer { FREE( sys_allocator, expected ); };
+
+	RNG rng = new_rng( 1, 1 );
+	Vec3 mins = cms->world_mins;
+	Vec3 maxs = cms->world_maxs;
+
+	for( u32 i = 0; i < num_traces; i++ ) {
+		StressTestTrace * t = &traces[ i ];
+		memset( t, 0, sizeof( *t ) );
+
+		for( int j = 0; j < 3; j++ ) {
+			t->start[ j ] = random_uniform_float( &rng, mins[ j ], maxs[ j ] );
+			t->end[ j ] = t->start[ j ] + random_uniform_float( &rng, -512.0f, 512.0f );
+		}
+
+		if( random_p( &rng, 0.25f ) ) {
+			t->mins = Vec3( -16.0f, -16.0f, -24.0f );
+			t->maxs = Vec3( 16.0f, 16.0f, 40.0f );
+		}
+
+		t->hull = random_uniform( &rng, 0, 3 );
+		if( t->hull != 0 ) {
+			t->hull_origin = Lerp( t->start, random_float01( &rng ), t->end );
+			t->hull_mins = Vec3( -random_uniform_float( &rng, 4.0f, 32.0f ), -random_uniform_float( &rng, 4.0f, 32.0f ), -random_uniform_float( &rng, 4.0f, 32.0f ) );
+			t->hull_maxs = Vec3( random_uniform_float( &rng, 4.0f, 32.0f ), random_uniform_float( &rng, 4.0f, 32.0f ), random_uniform_float( &rng, 4.0f, 32.0f ) );
+		}
+
+		t->soc = soc;
+		t->cms = cms;
+	}
+
+	u64 serial_start = Sys_Microseconds();
+	for( u32 i = 0; i < num_traces; i++ ) {
+		StressTestTraceJob( NULL, &traces[ i ] );
+		memcpy( &expected[ i ], &traces[ i ].result, sizeof( trace_t ) );
+	}
+	u64 serial_time = Sys_Microseconds() - serial_start;
+
+	u32 mismatches = 0;
+	u64 parallel_time = 0;
+	for( u32 i = 0; i < iterations; i++ ) {
+		for( u32 j = 0; j < num_traces; j++ ) {
+			memset( &traces[ j ].result, 0xff, sizeof( traces[ j ].result ) );
+		}
+
+		u64 parallel_start = Sys_Microseconds();
+		ParallelFor( Span< StressTestTrace >( traces, num_traces ), StressTestTraceJob );
+		parallel_time += Sys_Microseconds() - parallel_start;
+
+		for( u32 j = 0; j < num_traces; j++ ) {
+			if( memcmp( &traces[ j ].result, &expected[ j ], sizeof( trace_t ) ) != 0 ) {
+				mismatches++;
+			}
+		}
+	}
+
+	Com_Printf( "%u traces, serial %.2fms, parallel %.2fms avg over %u iterations\n",
+		num_traces, serial_time / 1000.0, parallel_time / 1000.0 / Max2( iterations, u32( 1 ) ), iterations );
+
+	if( mismatches == 0 ) {
+		Com_Printf( "All parallel traces matched\n" );
+	}
+	else {
+		Com_Printf( S_COLOR_RED "%u parallel traces didn't match!\n", mismatches );
+	}
+}
+
+/*
+* CM_BrushKernelBenchmark
+*
+* Runs the SIMD brush kernels and the scalar reference versions over the same
+* boxes and sweeps against the map's brushes and patch facets, and checks they
+* give bit identical results
+*/
+
+struct BrushKernelTest {
+	const cbrush_t * brush;
+	Vec3 start, end;
+	Vec3 mins, maxs;
+};
+
+struct BrushKernelResult {
+	trace_t trace;
+	float realfraction;
+	int contents;
+};
+
+static void RunBrushKernelTests( Span< const BrushKernelTest > tests, BrushKernelResult * results, bool reference ) {
+	for( size_t i = 0; i < tests.n; i++ ) {
+		const BrushKernelTest * test = &tests[ i ];
+		BrushKernelResult * result = &results[ i ];
+
+		memset( &result->trace, 0, sizeof( result->trace ) );
+		result->trace.fraction = 1;
+
+		traceWork_t tw;
+		tw.trace = &result->trace;
+		tw.realfraction = 1 + DIST_EPSILON;
+		tw.contents = MASK_ALL;
+		tw.start = test->start;
+		tw.end = test->end;
+		tw.mins = test->mins;
+		tw.maxs = test->maxs;
+
+		if( test->start == test->end ) {
+			if( reference ) {
+				CM_TestBoxInBrushReference( &tw, test->brush );
+			}
+			else {
+				CM_TestBoxInBrush( &tw, test->brush );
+			}
+		}
+		else {
+			if( reference ) {
+				CM_ClipBoxToBrushReference( &tw, test->brush );
+			}
+			else {
+				CM_ClipBoxToBrush( &tw, test->brush );
+			}
+		}
+
+		result->realfraction = tw.realfraction;
+		result->contents = tw.contents;
+	}
+}
+
+void CM_BrushKernelBenchmark( CollisionModel * cms, u32 num_tests, u32 iterations ) {
+	DynamicArray< const cbrush_t * > brushes( sys_allocator );
+	for( int i = 0; i < cms->numbrushes; i++ ) {
+		if( cms->map_brushes[ i ].numsides > 0 ) {
+			brushes.add( &cms->map_brushes[ i ] );
+		}
+	}
+	for( int i = 0; i < cms->numfaces; i++ ) {
+		for( int j = 0; j < cms->map_faces[ i ].numfacets; j++ ) {
+			brushes.add( &cms->map_faces[ i ].facets[ j ] );
+		}
+	}
+
+	if( brushes.size() == 0 ) {
+		Com_Printf( "Map has no brushes\n" );
+		return;
+	}
+
+	BrushKernelTest * tests = ALLOC_MANY( sys_allocator, BrushKernelTest, num_tests );
+	BrushKernelResult * expected = ALLOC_MANY( sys_allocator, BrushKernelResult, num_tests );
+	BrushKernelResult * results = ALLOC_MANY( sys_allocator, BrushKernelResult, num_tests );
+	defer { FREE( sys_allocator, tests ); };
+	defer { FREE( sys_allocator, expected ); };
+	defer { FREE( sys_allocator, results ); };
+
+	// so padding doesn't show up as mismatches
+	memset( expected, 0, num_tests * sizeof( BrushKernelResult ) );
+	memset( results, 0, num_tests * sizeof( BrushKernelResult ) );
+
+	RNG rng = new_rng( 1, 1 );
+
+	// start near the brush so most tests get past the first few planes
+	u32 num_position_tests = 0;
+	for( u32 i = 0; i < num_tests; i++ ) {
+		BrushKernelTest * test = &tests[ i ];
+		test->brush = brushes[ random_uniform( &rng, 0, int( brushes.size() ) ) ];
+
+		for( int j = 0; j < 3; j++ ) {
+			test->start[ j ] = random_uniform_float( &rng, test->brush->mins[ j ] - 64.0f, test->brush->maxs[ j ] + 64.0f );
+			test->end[ j ] = test->start[ j ] + random_uniform_float( &rng, -128.0f, 128.0f );
+		}
+
+		if( random_p( &rng, 0.2f ) ) {
+			test->end = test->start;
+			num_position_tests++;
+		}
+
+		if( random_p( &rng, 0.5f ) ) {
+			test->mins = Vec3( 0.0f );
+			test->maxs = Vec3( 0.0f );
+		}
+		else {
+			test->mins = Vec3( -random_uniform_float( &rng, 4.0f, 32.0f ), -random_uniform_float( &rng, 4.0f, 32.0f ), -random_uniform_float( &rng, 4.0f, 32.0f ) );
+			test->maxs = Vec3( random_uniform_float( &rng, 4.0f, 32.0f ), random_uniform_float( &rng, 4.0f, 32.0f ), random_uniform_float( &rng, 4.0f, 32.0f ) );
+		}
+	}
+
+	Span< const BrushKernelTest > span( tests, num_tests );
+
+	u64 reference_time = 0;
+	u64 simd_time = 0;
+	u32 mismatches = 0;
+
+	for( u32 i = 0; i < iterations; i++ ) {
+		u64 reference_start = Sys_Microseconds();
+		RunBrushKernelTests( span, expected, true );
+		reference_time += Sys_Microseconds() - reference_start;
+
+		u64 simd_start = Sys_Microseconds();
+		RunBrushKernelTests( span, results, false );
+		simd_time += Sys_Microseconds() - simd_start;
+	}
+
+	for( u32 i = 0; i < num_tests; i++ ) {
+		if( memcmp( &results[ i ], &expected[ i ], sizeof( BrushKernelResult ) ) != 0 ) {
+			mismatches++;
+		}
+	}
+
+	Com_Printf( "%u brushes, %u tests (%u position tests), scalar %.2fms, SIMD %.2fms avg over %u iterations\n",
+		u32( brushes.size() ), num_tests, num_position_tests,
+		reference_time / 1000.0 / iterations, simd_time / 1000.0 / iterations, iterations );
+
+	if( mismatches == 0 ) {
+		Com_Printf( "All SIMD results matched\n" );
+	}
+	else {
+		Com_Printf( S_COLOR_RED "%u SIMD results didn't match!\n", mismatches );
+	}
+}
+
+/*
+* CM_BVHBenchmark
+*
+* Times world traces walking the BSP against the same traces walking the BVH,
+* half short moves and half long railgun style traces across the map, and
+* checks they agree
+*/
+void CM_BVHBenchmark( CModelServerOrClient soc, CollisionModel * cms, u32 num_traces ) {
+	if( cms->bvh_nodes == NULL ) {
+		Com_Printf( "Map has no BVH\n" );
+		return;
+	}
+
+	StressTestTrace * traces = ALLOC_MANY( sys_allocator, StressTestTrace, num_traces );
+	trace_t * bsp = ALLOC_MANY( sys_allocator, trace_t, num_traces );
+	trace_t * bvh = ALLOC_MANY( sys_allocator, trace_t, num_traces );
+	defer { FREE( sys_allocator, traces ); };
+	defer { FREE( sys_allocator, bsp ); };
+	defer { FREE( sys_allocator, bvh ); };
+
+	RNG rng = new_rng( 1, 1 );
+	Vec3 mins = cms->world_mins;
+	Vec3 maxs = cms->world_maxs;
+
+	for( u32 i = 0; i < num_traces; i++ ) {
+		StressTestTrace * t = &traces[ i ];
+		memset( t, 0, sizeof( *t ) );
+
+		bool long_trace = random_p( &rng, 0.5f );
+		for( int j = 0; j < 3; j++ ) {
+			t->start[ j ] = random_uniform_float( &rng, mins[ j ], maxs[ j ] );
+			t->end[ j ] = long_trace ? random_uniform_float( &rng, mins[ j ], maxs[ j ] ) : t->start[ j ] + random_uniform_float( &rng, -512.0f, 512.0f );
+		}
+
+		if( random_p( &rng, 0.1f ) ) {
+			t->end = t->start;
+		}
+
+		if( random_p( &rng, 0.25f ) ) {
+			t->mins = Vec3( -16.0f, -16.0f, -24.0f );
+			t->maxs = Vec3( 16.0f, 16.0f, 40.0f );
+		}
+
+		t->soc = soc;
+		t->cms = cms;
+	}
+
+	int old_bvh = cm_bvh->integer;
+	defer { Cvar_ForceSet( "cm_bvh", old_bvh != 0 ? "1" : "0" ); };
+
+	Cvar_ForceSet( "cm_bvh", "0" );
+	u64 bsp_start = Sys_Microseconds();
+	for( u32 i = 0; i < num_traces; i++ ) {
+		StressTestTraceJob( NULL, &traces[ i ] );
+		memcpy( &bsp[ i ], &traces[ i ].result, sizeof( trace_t ) );
+	}
+	u64 bsp_time = Sys_Microseconds() - bsp_start;
+
+	Cvar_ForceSet( "cm_bvh", "1" );
+	u64 bvh_start = Sys_Microseconds();
+	for( u32 i = 0; i < num_traces; i++ ) {
+		StressTestTraceJob( NULL, &traces[ i ] );
+		memcpy( &bvh[ i ], &traces[ i ].result, sizeof( trace_t ) );
+	}
+	u64 bvh_time = Sys_Microseconds() - bvh_start;
+
+	// the BSP walk can miss brushes the trace only grazes, and which brush
+	// wins between near ties or when starting in solid depends on the order
+	// they're tested in because of the DIST_EPSILON nudge, so the BVH is only
+	// wrong if it lets a trace go noticeably further than the BSP did
+	u32 missed = 0;
+	u32 nearer = 0;
+	u32 order_dependent = 0;
+	for( u32 i = 0; i < num_traces; i++ ) {
+		const trace_t * a = &bsp[ i ];
+		const trace_t * b = &bvh[ i ];
+		if( memcmp( a, b, sizeof( trace_t ) ) == 0 )
+			continue;
+
+		float distance = Length( traces[ i ].end - traces[ i ].start );
+		if( a->startsolid || b->startsolid || Abs( a->fraction - b->fraction ) * distance < 1.0f ) {
+			order_dependent++;
+		}
+		else if( b->fraction < a->fraction ) {
+			nearer++;
+		}
+		else {
+			missed++;
+		}
+	}
+
+	Com_Printf( "%u traces, %u BVH nodes, BSP %.2fms, BVH %.2fms\n", num_traces, cms->num_bvh_nodes, bsp_time / 1000.0, bvh_time / 1000.0 );
+	Com_Printf( "%u BVH traces stopped earlier on something the BSP walk skipped, %u differed starting in solid or on ties\n", nearer, order_dependent );
+
+	if( missed == 0 ) {
+		Com_Printf( "The BVH didn't miss anything\n" );
+	}
+	else {
+		Com_Printf( S_COLOR_RED "%u BVH traces went further than the BSP traces!\n", missed );
+	}
+}
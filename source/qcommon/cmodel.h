@@ -41,6 +41,19 @@ typedef struct {
 	cplane_t plane;
 } cbrushside_t;
 
+// brush side planes transposed into groups of 4 so the clipping code can test
+// 4 at once. the last group is padded out with planes nothing can be in front of
+struct PlaneGroup {
+	float normal_x[ 4 ];
+	float normal_y[ 4 ];
+	float normal_z[ 4 ];
+	float dist[ 4 ];
+};
+
+constexpr int NumPlaneGroups( int numsides ) {
+	return ( numsides + 3 ) / 4;
+}
+
 typedef struct {
 	int contents;
 	int numsides;
@@ -48,6 +61,7 @@ typedef struct {
 	Vec3 mins, maxs;
 
 	cbrushside_t *brushsides;
+	PlaneGroup *plane_groups;
 } cbrush_t;
 
 typedef struct {
@@ -93,6 +107,28 @@ typedef struct cmodel_s {
 	int *markbrushes;
 } cmodel_t;
 
+// storage for the temporary clipping hulls built by CM_ModelForBBox and
+// CM_OctagonModelForBBox. callers own these so traces can run in parallel
+struct BoxHull {
+	cbrushside_t brushsides[ 10 ];
+	PlaneGroup plane_groups[ NumPlaneGroups( 10 ) ];
+	cbrush_t brush;
+	int markbrushes[ 1 ];
+	cmodel_t cmodel;
+};
+
+// bounding volume hierarchy over the world's brushes and patches, an
+// alternative to walking the BSP for world traces. nodes are stored depth
+// first so an interior node's first child is the node right after it
+struct BVHNode {
+	Vec3 mins;
+	u32 first; // interior nodes: index of the second child, leaves: first item
+	Vec3 maxs;
+	u32 count; // 0 for interior nodes
+};
+
+constexpr u32 BVH_ITEM_FACE = U32( 1 ) << 31; // set on items that are map_faces indices, otherwise map_brushes
+
 typedef struct {
 	int floodnum;               // if two areas have equal floodnums, they are connected
 	int floodvalid;
@@ -102,7 +138,6 @@ struct CollisionModel {
 	u64 base_hash;
 	u64 world_hash;
 
-	int checkcount;
 	int floodvalid;
 
 	u32 checksum;
@@ -131,6 +166,7 @@ struct CollisionModel {
 
 	int numbrushes;
 	cbrush_t *map_brushes;
+	PlaneGroup *map_brush_plane_groups;
 
 	int numfaces;
 	cface_t *map_faces;
@@ -138,6 +174,10 @@ struct CollisionModel {
 	int nummarkfaces;
 	int *map_markfaces;
 
+	u32 num_bvh_nodes;
+	BVHNode *bvh_nodes;
+	u32 *bvh_items;
+
 	Vec3 *map_verts;              // this will be freed
 	int numvertexes;
 
@@ -159,22 +199,6 @@ struct CollisionModel {
 	char *map_entitystring;         // = &map_entitystring_empty;
 
 	const u8 *cmod_base;
-
-	// cm_trace.c
-	cbrushside_t box_brushsides[6];
-	cbrush_t box_brush[1];
-	int box_markbrushes[1];
-	cmodel_t box_cmodel[1];
-	int box_checkcount;
-
-	cbrushside_t oct_brushsides[10];
-	cbrush_t oct_brush[1];
-	int oct_markbrushes[1];
-	cmodel_t oct_cmodel[1];
-	int oct_checkcount;
-
-	int *map_brush_checkcheckouts;
-	int *map_face_checkcheckouts;
 };
 
 enum CModelServerOrClient {
@@ -195,9 +219,9 @@ int CM_NumAreas( const CollisionModel *cms );
 char *CM_EntityString( const CollisionModel *cms );
 int CM_EntityStringLen( const CollisionModel *cms );
 
-// creates a clipping hull for an arbitrary bounding box
-struct cmodel_s *CM_ModelForBBox( CollisionModel *cms, Vec3 mins, Vec3 maxs );
-struct cmodel_s *CM_OctagonModelForBBox( CollisionModel *cms, Vec3 mins, Vec3 maxs );
+// creates a clipping hull for an arbitrary bounding box, valid as long as hull is
+struct cmodel_s *CM_ModelForBBox( BoxHull * hull, Vec3 mins, Vec3 maxs );
+struct cmodel_s *CM_OctagonModelForBBox( BoxHull * hull, Vec3 mins, Vec3 maxs );
 void CM_InlineModelBounds( const CollisionModel *cms, const struct cmodel_s *cmodel, Vec3 * mins, Vec3 * maxs );
 
 // returns an ORed contents mask
@@ -227,3 +251,7 @@ void CM_MergePVS( CollisionModel *cms, Vec3 org, uint8_t *out );
 
 void CM_Init( void );
 void CM_Shutdown( void );
+
+void CM_TraceStressTest( CModelServerOrClient soc, CollisionModel * cms, u32 num_traces, u32 iterations );
+void CM_BrushKernelBenchmark( CollisionModel * cms, u32 num_tests, u32 iterations );
+void CM_BVHBenchmark( CModelServerOrClient soc, CollisionModel * cms, u32 num_traces );
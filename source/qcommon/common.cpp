@@ -21,8 +21,10 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "qcommon/qcommon.h"
 #include "qcommon/cmodel.h"
 #include "qcommon/glob.h"
+#include "qcommon/pack.h"
 #include "qcommon/csprng.h"
 #include "qcommon/threads.h"
+#include "qcommon/threadpool.h"
 #include "qcommon/version.h"
 #include "qcommon/wswcurl.h"
 
@@ -504,6 +506,9 @@ void Qcommon_InitCommands( void ) {
 		Cmd_AddCommand( "quit", Com_Quit );
 	}
 
+	Cmd_AddCommand( "msgbench", MSG_DeltaBenchmark_f );
+	Cmd_AddCommand( "jobbench", ThreadPoolBenchmark_f );
+
 	commands_intialized = true;
 }
 
@@ -519,6 +524,9 @@ void Qcommon_ShutdownCommands( void ) {
 		Cmd_RemoveCommand( "quit" );
 	}
 
+	Cmd_RemoveCommand( "msgbench" );
+	Cmd_RemoveCommand( "jobbench" );
+
 	commands_intialized = false;
 }
 
@@ -608,6 +616,11 @@ void Qcommon_Init( int argc, char **argv ) {
 
 	CSPRNG_Init();
 
+	InitThreadPool();
+
+	// before Netchan_Init, which loads the netchan dictionary out of the pack
+	InitPack();
+
 	NET_Init();
 	Netchan_Init();
 
@@ -676,7 +689,10 @@ void Qcommon_Frame( unsigned int realMsec ) {
 * Qcommon_Shutdown
 */
 void Qcommon_Shutdown( void ) {
+	ShutdownThreadPool();
+
 	CM_Shutdown();
+	ShutdownPack();
 	Netchan_Shutdown();
 	NET_Shutdown();
 	Key_Shutdown();
@@ -967,6 +967,22 @@ unsigned FS_ChecksumBaseFile( const char *filename ) {
 	return FS_ChecksumAbsoluteFile( fullname );
 }
 
+/*
+* FS_BaseFileMTime
+*
+* Returns -1 if the file doesn't exist. Doesn't touch any static buffers so
+* it's safe to call off the main thread
+*/
+int64_t FS_BaseFileMTime( const char *filename ) {
+	char path[FS_MAX_PATH];
+
+	if( !FS_SearchPathForBaseFile( filename, path, sizeof( path ) ) ) {
+		return -1;
+	}
+
+	return Sys_FS_FileMTime( path );
+}
+
 /*
 * FS_RemoveAbsoluteFile
 */
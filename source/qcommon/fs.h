@@ -15,3 +15,14 @@ ListDirHandle BeginListDir( const char * path );
 bool ListDirNext( ListDirHandle * handle, const char ** path, bool * dir );
 
 s64 FileLastModifiedTime( const char * path );
+
+/*
+ * MapFile maps a file read-only. Pages are only read from disk when they get
+ * touched. Only use it on files that won't change under us, like base.pack:
+ * truncating a mapped file makes reads past the new end crash on unix, and
+ * stops it from being rewritten at all on windows. zero_padded is set when the byte after the end of the file is
+ * readable and '\0', which is the case unless the file size is a multiple of
+ * the page size. Empty files can't be mapped.
+ */
+bool MapFile( const char * path, Span< const u8 > * data, bool * zero_padded );
+void UnmapFile( Span< const u8 > data );
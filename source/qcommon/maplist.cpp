@@ -4,6 +4,7 @@
 #include "qcommon/qcommon.h"
 #include "qcommon/array.h"
 #include "qcommon/fs.h"
+#include "qcommon/pack.h"
 
 static DynamicArray< char * > maps( NO_INIT );
 
@@ -48,6 +49,28 @@ void RefreshMapList() {
 		maps.add( map );
 	}
 
+	for( const PackedFile & file : PackedFiles() ) {
+		const char * path = PackedFileName( &file );
+		if( strncmp( path, "maps/", strlen( "maps/" ) ) != 0 || FileExtension( path ) != ".bsp" )
+			continue;
+
+		const char * name = path + strlen( "maps/" );
+		if( strchr( name, '/' ) != NULL )
+			continue;
+
+		size_t len = strlen( name ) - strlen( ".bsp" );
+		char * map = ALLOC_MANY( sys_allocator, char, len + 1 );
+		memcpy( map, name, len );
+		map[ len ] = '\0';
+
+		if( MapExists( map ) ) {
+			FREE( sys_allocator, map );
+			continue;
+		}
+
+		maps.add( map );
+	}
+
 	std::sort( maps.begin(), maps.end(), []( const char * a, const char * b ) {
 		return strcmp( a, b ) < 0;
 	} );
@@ -21,6 +21,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "qcommon/qcommon.h"
 #include "qcommon/half_float.h"
 #include "qcommon/serialization.h"
+#include "qcommon/rng.h"
 
 #define MAX_MSG_STRING_CHARS    2048
 
@@ -50,6 +51,8 @@ void *MSG_GetSpace( msg_t *msg, size_t length ) {
 	return ptr;
 }
 
+// a delta is encoded as the field count, a bitmask of changed fields, then
+// the changed fields. field_mask and buf both point straight into the msg_t
 struct DeltaBuffer {
 	static constexpr u32 MAX_FIELDS = 1024;
 
@@ -57,7 +60,8 @@ struct DeltaBuffer {
 	u8 * cursor;
 	u8 * end;
 
-	u8 field_mask[ MAX_FIELDS / 8 ];
+	u8 * field_mask;
+	u32 max_fields;
 	u32 num_fields;
 	u32 field_mask_read_cursor;
 
@@ -65,19 +69,17 @@ struct DeltaBuffer {
 	bool error;
 };
 
-static void MSG_WriteDeltaBuffer( msg_t * msg, const DeltaBuffer & delta ) {
-	MSG_WriteUintBase128( msg, delta.num_fields );
-	u8 bytes = ( delta.num_fields + 7 ) / 8;
-	MSG_WriteData( msg, delta.field_mask, bytes );
-	MSG_WriteData( msg, delta.buf, delta.cursor - delta.buf );
-}
-
 static DeltaBuffer MSG_StartReadingDeltaBuffer( msg_t * msg ) {
 	DeltaBuffer delta = { };
 
 	delta.num_fields = MSG_ReadUintBase128( msg );
-	u8 bytes = ( delta.num_fields + 7 ) / 8;
-	MSG_ReadData( msg, delta.field_mask, bytes );
+	u32 bytes = ( delta.num_fields + 7 ) / 8;
+	delta.field_mask = msg->data + msg->readcount;
+
+	if( delta.num_fields > DeltaBuffer::MAX_FIELDS || !MSG_SkipData( msg, bytes ) ) {
+		delta.error = true;
+		msg->readcount = msg->cursize;
+	}
 
 	delta.buf = msg->data + msg->readcount;
 	delta.cursor = msg->data + msg->readcount;
@@ -90,8 +92,10 @@ static void MSG_FinishReadingDeltaBuffer( msg_t * msg, const DeltaBuffer & delta
 	msg->readcount += delta.cursor - delta.buf;
 }
 
-static DeltaBuffer DeltaWriter( u8 * buf, size_t n ) {
+static DeltaBuffer DeltaWriter( u8 * field_mask, u32 max_fields, u8 * buf, size_t n ) {
 	DeltaBuffer delta = { };
+	delta.field_mask = field_mask;
+	delta.max_fields = max_fields;
 	delta.buf = buf;
 	delta.cursor = buf;
 	delta.end = delta.buf + n;
@@ -101,7 +105,7 @@ static DeltaBuffer DeltaWriter( u8 * buf, size_t n ) {
 }
 
 static void AddBit( DeltaBuffer * buf, bool b ) {
-	if( buf->error || buf->num_fields == DeltaBuffer::MAX_FIELDS ) {
+	if( buf->error || buf->num_fields == buf->max_fields ) {
 		buf->error = true;
 		return;
 	}
@@ -231,6 +235,61 @@ static void DeltaAngle( DeltaBuffer * buf, Vec3 & v, const Vec3 & baseline ) {
 	}
 }
 
+/*
+* DeltaFieldCount
+*
+* Every field emits a mask bit whether it changed or not, so the count only
+* depends on the type and can be worked out once with a dry run
+*/
+template< typename T >
+static u32 CountDeltaFields() {
+	T x = T();
+	T baseline = T();
+	DeltaBuffer delta = DeltaWriter( NULL, DeltaBuffer::MAX_FIELDS, NULL, 0 );
+	Delta( &delta, x, baseline );
+	assert( !delta.error );
+	return delta.num_fields;
+}
+
+template< typename T >
+static u32 DeltaFieldCount() {
+	static const u32 num_fields = CountDeltaFields< T >();
+	return num_fields;
+}
+
+/*
+* MSG_WriteDelta
+*
+* Reserves the header in the msg and encodes the changed fields directly
+* after it. Returns whether any field changed
+*/
+template< typename T >
+static bool MSG_WriteDelta( msg_t * msg, T & x, const T & baseline ) {
+	u32 num_fields = DeltaFieldCount< T >();
+	u32 mask_bytes = ( num_fields + 7 ) / 8;
+
+	MSG_WriteUintBase128( msg, num_fields );
+	u8 * field_mask = ( u8 * ) MSG_GetSpace( msg, mask_bytes );
+	memset( field_mask, 0, mask_bytes );
+
+	DeltaBuffer delta = DeltaWriter( field_mask, num_fields, msg->data + msg->cursize, msg->maxsize - msg->cursize );
+	Delta( &delta, x, baseline );
+
+	if( delta.error ) {
+		Com_Error( ERR_FATAL, "MSG_WriteDelta: overflowed" );
+	}
+
+	msg->cursize += delta.cursor - delta.buf;
+
+	for( u32 i = 0; i < mask_bytes; i++ ) {
+		if( field_mask[ i ] != 0 ) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 //==================================================
 // WRITE FUNCTIONS
 //==================================================
@@ -578,25 +637,19 @@ int MSG_ReadEntityNumber( msg_t *msg, bool *remove ) {
 }
 
 void MSG_WriteDeltaEntity( msg_t * msg, const SyncEntityState * baseline, const SyncEntityState * ent, bool force ) {
-	u8 buf[ MAX_MSGLEN ];
-	DeltaBuffer delta = DeltaWriter( buf, sizeof( buf ) );
-
-	Delta( &delta, *const_cast< SyncEntityState * >( ent ), * baseline );
-
-	bool changed = false;
-	for( u8 x : delta.field_mask ) {
-		if( x != 0 ) {
-			changed = true;
-			break;
-		}
-	}
-
-	if( !changed && !force ) {
+	// identical states can't produce a delta, which is the common case
+	if( !force && memcmp( ent, baseline, sizeof( *ent ) ) == 0 ) {
 		return;
 	}
 
+	size_t start = msg->cursize;
 	MSG_WriteEntityNumber( msg, ent->number, false );
-	MSG_WriteDeltaBuffer( msg, delta );
+	bool changed = MSG_WriteDelta( msg, *const_cast< SyncEntityState * >( ent ), *baseline );
+
+	// quantized angles etc can still come out unchanged
+	if( !changed && !force ) {
+		msg->cursize = start;
+	}
 }
 
 void MSG_ReadDeltaEntity( msg_t * msg, const SyncEntityState * baseline, SyncEntityState * ent ) {
@@ -631,12 +684,7 @@ static void Delta( DeltaBuffer * buf, usercmd_t & cmd, const usercmd_t & baselin
 }
 
 void MSG_WriteDeltaUsercmd( msg_t * msg, const usercmd_t * baseline, const usercmd_t * cmd ) {
-	u8 buf[ MAX_MSGLEN ];
-	DeltaBuffer delta = DeltaWriter( buf, sizeof( buf ) );
-
-	Delta( &delta, *const_cast< usercmd_t * >( cmd ), *baseline );
-
-	MSG_WriteDeltaBuffer( msg, delta );
+	MSG_WriteDelta( msg, *const_cast< usercmd_t * >( cmd ), *baseline );
 	MSG_WriteIntBase128( msg, cmd->serverTimeStamp );
 }
 
@@ -779,12 +827,7 @@ void MSG_WriteDeltaPlayerState( msg_t * msg, const SyncPlayerState * baseline, c
 		baseline = &dummy;
 	}
 
-	u8 buf[ MAX_MSGLEN ];
-	DeltaBuffer delta = DeltaWriter( buf, sizeof( buf ) );
-
-	Delta( &delta, *const_cast< SyncPlayerState * >( player ), *baseline );
-
-	MSG_WriteDeltaBuffer( msg, delta );
+	MSG_WriteDelta( msg, *const_cast< SyncPlayerState * >( player ), *baseline );
 }
 
 void MSG_ReadDeltaPlayerState( msg_t * msg, const SyncPlayerState * baseline, SyncPlayerState * player ) {
@@ -830,12 +873,7 @@ void MSG_WriteDeltaGameState( msg_t * msg, const SyncGameState * baseline, const
 		baseline = &dummy;
 	}
 
-	u8 buf[ MAX_MSGLEN ];
-	DeltaBuffer delta = DeltaWriter( buf, sizeof( buf ) );
-
-	Delta( &delta, *const_cast< SyncGameState * >( state ), *baseline );
-
-	MSG_WriteDeltaBuffer( msg, delta );
+	MSG_WriteDelta( msg, *const_cast< SyncGameState * >( state ), *baseline );
 }
 
 void MSG_ReadDeltaGameState( msg_t * msg, const SyncGameState * baseline, SyncGameState * state ) {
@@ -848,3 +886,105 @@ void MSG_ReadDeltaGameState( msg_t * msg, const SyncGameState * baseline, SyncGa
 	Delta( &delta, *state, *baseline );
 	MSG_FinishReadingDeltaBuffer( msg, delta );
 }
+
+//==================================================
+// BENCHMARK
+//==================================================
+
+/*
+* MSG_WriteDeltaEntityScratch
+*
+* How MSG_WriteDeltaEntity used to work, encoding into a stack buffer and
+* copying it into the msg afterwards. Only kept to compare against
+*/
+static void MSG_WriteDeltaEntityScratch( msg_t * msg, const SyncEntityState * baseline, const SyncEntityState * ent, bool force ) {
+	u8 buf[ MAX_MSGLEN ];
+	u8 field_mask[ DeltaBuffer::MAX_FIELDS / 8 ] = { };
+	DeltaBuffer delta = DeltaWriter( field_mask, DeltaBuffer::MAX_FIELDS, buf, sizeof( buf ) );
+
+	Delta( &delta, *const_cast< SyncEntityState * >( ent ), *baseline );
+
+	bool changed = false;
+	for( u8 x : field_mask ) {
+		if( x != 0 ) {
+			changed = true;
+			break;
+		}
+	}
+
+	if( !changed && !force ) {
+		return;
+	}
+
+	MSG_WriteEntityNumber( msg, ent->number, false );
+	MSG_WriteUintBase128( msg, delta.num_fields );
+	MSG_WriteData( msg, field_mask, ( delta.num_fields + 7 ) / 8 );
+	MSG_WriteData( msg, delta.buf, delta.cursor - delta.buf );
+}
+
+/*
+* MSG_DeltaBenchmark_f
+*
+* Usage: msgbench [iterations]
+* Encodes a snapshot's worth of entities where a quarter of them moved with
+* both entity writers, and checks they produce the same bytes
+*/
+void MSG_DeltaBenchmark_f( void ) {
+	constexpr int num_ents = 1024;
+	int iterations = Cmd_Argc() > 1 ? Max2( 1, atoi( Cmd_Argv( 1 ) ) ) : 1000;
+
+	RNG rng = new_rng( 1, 1 );
+	SyncEntityState * baselines = ALLOC_MANY( sys_allocator, SyncEntityState, num_ents );
+	SyncEntityState * ents = ALLOC_MANY( sys_allocator, SyncEntityState, num_ents );
+	for( int i = 0; i < num_ents; i++ ) {
+		baselines[ i ] = SyncEntityState();
+		baselines[ i ].number = i;
+		baselines[ i ].type = random_uniform( &rng, 0, 16 );
+		baselines[ i ].origin = Vec3( random_float11( &rng ), random_float11( &rng ), random_float11( &rng ) ) * 4096.0f;
+
+		ents[ i ] = baselines[ i ];
+		if( random_uniform( &rng, 0, 4 ) == 0 ) {
+			ents[ i ].origin += Vec3( random_float11( &rng ), random_float11( &rng ), 0.0f ) * 32.0f;
+			ents[ i ].angles.y = random_uniform_float( &rng, 0.0f, 360.0f );
+		}
+	}
+
+	size_t size = num_ents * sizeof( SyncEntityState ) * 2;
+	u8 * scratch_data = ALLOC_MANY( sys_allocator, u8, size );
+	u8 * direct_data = ALLOC_MANY( sys_allocator, u8, size );
+
+	msg_t scratch, direct;
+	MSG_Init( &scratch, scratch_data, size );
+	MSG_Init( &direct, direct_data, size );
+
+	u64 scratch_start = Sys_Microseconds();
+	for( int i = 0; i < iterations; i++ ) {
+		MSG_Clear( &scratch );
+		for( int j = 0; j < num_ents; j++ ) {
+			MSG_WriteDeltaEntityScratch( &scratch, &baselines[ j ], &ents[ j ], false );
+		}
+	}
+	u64 scratch_time = Max2( u64( 1 ), Sys_Microseconds() - scratch_start );
+
+	u64 direct_start = Sys_Microseconds();
+	for( int i = 0; i < iterations; i++ ) {
+		MSG_Clear( &direct );
+		for( int j = 0; j < num_ents; j++ ) {
+			MSG_WriteDeltaEntity( &direct, &baselines[ j ], &ents[ j ], false );
+		}
+	}
+	u64 direct_time = Max2( u64( 1 ), Sys_Microseconds() - direct_start );
+
+	bool identical = scratch.cursize == direct.cursize && memcmp( scratch.data, direct.data, direct.cursize ) == 0;
+	double mb = double( direct.cursize ) * iterations / ( 1024.0 * 1024.0 );
+
+	Com_Printf( "%i iterations of %i entities, %" PRIuPTR " bytes each\n", iterations, num_ents, uintptr_t( direct.cursize ) );
+	Com_Printf( "scratch buffer: %.2fms, %.2f MB/s\n", scratch_time / 1000.0, mb / ( scratch_time / 1000000.0 ) );
+	Com_Printf( "direct:         %.2fms, %.2f MB/s\n", direct_time / 1000.0, mb / ( direct_time / 1000000.0 ) );
+	Com_Printf( "output %s\n", identical ? "matches" : "DIFFERS" );
+
+	FREE( sys_allocator, direct_data );
+	FREE( sys_allocator, scratch_data );
+	FREE( sys_allocator, ents );
+	FREE( sys_allocator, baselines );
+}
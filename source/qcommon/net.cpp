@@ -312,6 +312,163 @@ static int NET_UDP_GetPacket( const socket_t *socket, netadr_t *address, msg_t *
 	return 1;
 }
 
+/*
+* NET_UDP_GetPackets
+*
+* Datagrams we can't use are left with cursize 0
+*/
+static int NET_UDP_GetPackets( const socket_t *socket, netadr_t *addresses, msg_t *messages, int count ) {
+	net_datagram_t datagrams[NET_MAX_BATCH];
+	struct sockaddr_storage from[NET_MAX_BATCH];
+	int i, ret;
+
+	assert( socket && socket->open && socket->type == SOCKET_UDP );
+	assert( count > 0 );
+
+	count = Min2( count, NET_MAX_BATCH );
+	for( i = 0; i < count; i++ ) {
+		assert( messages[i].data && messages[i].maxsize > 0 );
+		datagrams[i].data = messages[i].data;
+		datagrams[i].length = messages[i].maxsize;
+		datagrams[i].addr = &from[i];
+		datagrams[i].addrlen = sizeof( from[i] );
+	}
+
+	ret = Sys_NET_RecvBatch( socket->handle, datagrams, count );
+	if( ret == SOCKET_ERROR ) {
+		net_error_t err;
+
+		NET_SetErrorStringFromLastError( "Sys_NET_RecvBatch" );
+
+		err = Sys_NET_GetLastError();
+		if( err == NET_ERR_WOULDBLOCK || err == NET_ERR_CONNRESET ) { // would block
+			return 0;
+		}
+
+		return -1;
+	}
+
+	for( i = 0; i < ret; i++ ) {
+		messages[i].readcount = 0;
+		messages[i].cursize = datagrams[i].length;
+
+		if( !SockaddressToAddress( (struct sockaddr *)&from[i], &addresses[i] ) ) {
+			messages[i].cursize = 0;
+			continue;
+		}
+
+		if( datagrams[i].length == messages[i].maxsize ) {
+			Com_DPrintf( "NET_GetPackets: Oversized packet from %s\n", NET_AddressToString( &addresses[i] ) );
+			messages[i].cursize = 0;
+		}
+	}
+
+	return ret;
+}
+
+/*
+* Batched sends
+*
+* Between NET_BeginSendBatch and NET_EndSendBatch, UDP packets get copied
+* into a queue instead of being sent straight away, and then go out a batch
+* per syscall with Sys_NET_SendBatch. Send errors can only be reported when
+* the queue is flushed.
+*/
+#define NET_SEND_QUEUE_BYTES ( NET_MAX_BATCH * MAX_PACKETLEN )
+
+typedef struct {
+	socket_handle_t handle;
+	netadr_t address;
+	struct sockaddr_storage addr;
+	socklen_t addrlen;
+	size_t offset;
+	size_t length;
+} queued_packet_t;
+
+static bool send_batch_open;
+static queued_packet_t send_queue[NET_MAX_BATCH];
+static int send_queue_count;
+static uint8_t send_queue_data[NET_SEND_QUEUE_BYTES];
+static size_t send_queue_bytes;
+
+/*
+* NET_FlushSendQueue
+*/
+static void NET_FlushSendQueue( void ) {
+	net_datagram_t datagrams[NET_MAX_BATCH];
+	int first, run, ret;
+
+	for( int i = 0; i < send_queue_count; i++ ) {
+		datagrams[i].data = send_queue_data + send_queue[i].offset;
+		datagrams[i].length = send_queue[i].length;
+		datagrams[i].addr = &send_queue[i].addr;
+		datagrams[i].addrlen = send_queue[i].addrlen;
+	}
+
+	first = 0;
+	while( first < send_queue_count ) {
+		// one syscall per run of packets going out the same socket
+		run = 1;
+		while( first + run < send_queue_count && send_queue[first + run].handle == send_queue[first].handle ) {
+			run++;
+		}
+
+		ret = Sys_NET_SendBatch( send_queue[first].handle, datagrams + first, run );
+		if( ret <= 0 ) {
+			// drop the packet that failed and carry on with the rest
+			NET_SetErrorStringFromLastError( "Sys_NET_SendBatch" );
+			Com_Printf( "Error sending packet to %s: %s\n", NET_AddressToString( &send_queue[first].address ), NET_ErrorString() );
+			ret = 1;
+		}
+
+		first += ret;
+	}
+
+	send_queue_count = 0;
+	send_queue_bytes = 0;
+}
+
+/*
+* NET_QueuePacket
+*/
+static void NET_QueuePacket( const socket_t *socket, const void *data, size_t length, const netadr_t *address,
+	const struct sockaddr_storage *addr, socklen_t addrlen ) {
+	queued_packet_t *packet;
+
+	if( send_queue_count == NET_MAX_BATCH || send_queue_bytes + length > NET_SEND_QUEUE_BYTES ) {
+		NET_FlushSendQueue();
+	}
+
+	packet = &send_queue[send_queue_count];
+	packet->handle = socket->handle;
+	packet->address = *address;
+	packet->addr = *addr;
+	packet->addrlen = addrlen;
+	packet->offset = send_queue_bytes;
+	packet->length = length;
+	memcpy( send_queue_data + send_queue_bytes, data, length );
+
+	send_queue_count++;
+	send_queue_bytes += length;
+}
+
+/*
+* NET_BeginSendBatch
+*/
+void NET_BeginSendBatch( void ) {
+	assert( !send_batch_open );
+	send_batch_open = true;
+}
+
+/*
+* NET_EndSendBatch
+*/
+void NET_EndSendBatch( void ) {
+	assert( send_batch_open );
+	NET_FlushSendQueue();
+	send_batch_open = false;
+}
+
 /*
 * NET_UDP_SendPacket
 */
@@ -329,6 +486,12 @@ static bool NET_UDP_SendPacket( const socket_t *socket, const void *data, size_t
 	}
 
 	addrlen = ( addr.ss_family == AF_INET6 ? sizeof( struct sockaddr_in6 ) : sizeof( struct sockaddr_in ) );
+
+	if( send_batch_open && length <= NET_SEND_QUEUE_BYTES ) {
+		NET_QueuePacket( socket, data, length, address, &addr, addrlen );
+		return true;
+	}
+
 	if( sendto( socket->handle, ( const char * ) data, length, 0, (struct sockaddr *)&addr, addrlen ) == SOCKET_ERROR ) {
 		NET_SetErrorStringFromLastError( "sendto" );
 		return false;
@@ -396,6 +559,11 @@ static void NET_UDP_CloseSocket( socket_t *socket ) {
 		return;
 	}
 
+	// don't leave packets queued on a handle that's about to go away
+	if( send_queue_count > 0 ) {
+		NET_FlushSendQueue();
+	}
+
 	Sys_NET_SocketClose( socket->handle );
 	socket->handle = 0;
 	socket->open = false;
@@ -542,7 +710,7 @@ static int NET_TCP_Send( const socket_t *socket, const void *data, size_t length
 static bool NET_TCP_Listen( const socket_t *socket ) {
 	assert( socket && socket->open && socket->type == SOCKET_TCP && socket->handle );
 
-	if( listen( socket->handle, 8 ) == -1 ) {
+	if( listen( socket->handle, SOMAXCONN ) == -1 ) {
 		NET_SetErrorStringFromLastError( "listen" );
 		return false;
 	}
@@ -593,6 +761,35 @@ static int NET_TCP_Accept( const socket_t *socket, socket_t *newsocket, netadr_t
 	return 1;
 }
 
+/*
+* NET_TCP_Connect
+*/
+static connection_status_t NET_TCP_Connect( socket_t *socket, const netadr_t *address ) {
+	struct sockaddr_storage sockaddress;
+	socklen_t addrlen;
+
+	assert( socket && socket->open && socket->type == SOCKET_TCP && !socket->connected );
+
+	if( !AddressToSockaddress( address, &sockaddress ) ) {
+		return CONNECTION_FAILED;
+	}
+
+	socket->remoteAddress = *address;
+
+	addrlen = ( sockaddress.ss_family == AF_INET6 ? sizeof( struct sockaddr_in6 ) : sizeof( struct sockaddr_in ) );
+	if( connect( socket->handle, (struct sockaddr *)&sockaddress, addrlen ) == SOCKET_ERROR ) {
+		net_error_t err = Sys_NET_GetLastError();
+		if( err == NET_ERR_INPROGRESS || err == NET_ERR_WOULDBLOCK ) {
+			return CONNECTION_INPROGRESS;
+		}
+		NET_SetErrorStringFromLastError( "connect" );
+		return CONNECTION_FAILED;
+	}
+
+	socket->connected = true;
+	return CONNECTION_SUCCEEDED;
+}
+
 /*
 * NET_TCP_CloseSocket
 */
@@ -791,6 +988,41 @@ int NET_GetPacket( const socket_t *socket, netadr_t *address, msg_t *message ) {
 	}
 }
 
+/*
+* NET_GetPackets
+*
+* Reads up to count packets, each into its own message. Returns how many
+* were read, or -1 if reading the first one failed. Packets that couldn't be
+* used are left with cursize 0 and should be skipped.
+*
+* UDP sockets read the whole batch in one syscall where the platform can.
+*/
+int NET_GetPackets( const socket_t *socket, netadr_t *addresses, msg_t *messages, int count ) {
+	int i, ret;
+
+	assert( socket->open );
+
+	if( !socket->open ) {
+		return -1;
+	}
+
+	if( socket->type == SOCKET_UDP ) {
+		return NET_UDP_GetPackets( socket, addresses, messages, count );
+	}
+
+	for( i = 0; i < count; i++ ) {
+		ret = NET_GetPacket( socket, &addresses[i], &messages[i] );
+		if( ret == 0 ) {
+			break;
+		}
+		if( ret == -1 ) {
+			return i > 0 ? i : -1;
+		}
+	}
+
+	return i;
+}
+
 /*
 * NET_Get
 *
@@ -1381,6 +1613,55 @@ int NET_Accept( const socket_t *socket, socket_t *newsocket, netadr_t *address )
 			return false;
 	}
 }
+
+/*
+* NET_Connect
+*
+* Starts connecting socket to address. The socket is non-blocking so this
+* usually comes back with CONNECTION_INPROGRESS, see NET_CheckConnect
+*/
+connection_status_t NET_Connect( socket_t *socket, const netadr_t *address ) {
+	assert( socket && socket->open );
+
+	if( socket->type != SOCKET_TCP ) {
+		assert( false );
+		NET_SetErrorString( "Unsupported socket type" );
+		return CONNECTION_FAILED;
+	}
+
+	return NET_TCP_Connect( socket, address );
+}
+
+/*
+* NET_CheckConnect
+*
+* Finishes a connect that was in progress. The OS says the same thing for
+* connected and still connecting, so only call this once the socket has
+* become writable.
+*/
+connection_status_t NET_CheckConnect( socket_t *socket ) {
+	int error;
+	socklen_t error_size = sizeof( error );
+
+	assert( socket && socket->open && socket->type == SOCKET_TCP );
+
+	if( socket->connected ) {
+		return CONNECTION_SUCCEEDED;
+	}
+
+	if( getsockopt( socket->handle, SOL_SOCKET, SO_ERROR, (char *)&error, &error_size ) == SOCKET_ERROR ) {
+		NET_SetErrorStringFromLastError( "getsockopt" );
+		return CONNECTION_FAILED;
+	}
+
+	if( error != 0 ) {
+		NET_SetErrorString( "connect failed (%i)", error );
+		return CONNECTION_FAILED;
+	}
+
+	socket->connected = true;
+	return CONNECTION_SUCCEEDED;
+}
 #endif
 
 /*
@@ -1564,6 +1845,69 @@ int NET_Monitor( int msec, socket_t *sockets[], void ( *read_cb )( socket_t *, v
 	return ret;
 }
 
+/*
+* NET_CreatePoller
+*/
+net_poller_t *NET_CreatePoller( void ) {
+	return Sys_NET_CreatePoller();
+}
+
+/*
+* NET_DestroyPoller
+*/
+void NET_DestroyPoller( net_poller_t *poller ) {
+	if( poller != NULL ) {
+		Sys_NET_DestroyPoller( poller );
+	}
+}
+
+/*
+* NET_PollerAdd
+*/
+bool NET_PollerAdd( net_poller_t *poller, const socket_t *socket, void *data ) {
+	assert( socket->open );
+
+	switch( socket->type ) {
+		case SOCKET_UDP:
+#ifdef TCP_SUPPORT
+		case SOCKET_TCP:
+#endif
+			if( !Sys_NET_PollerAdd( poller, socket->handle, data ) ) {
+				NET_SetErrorStringFromLastError( "NET_PollerAdd" );
+				return false;
+			}
+			return true;
+
+		default:
+			NET_SetErrorString( "Unsupported socket type" );
+			return false;
+	}
+}
+
+/*
+* NET_PollerRemove
+*/
+void NET_PollerRemove( net_poller_t *poller, const socket_t *socket ) {
+	if( socket->open && socket->type != SOCKET_LOOPBACK ) {
+		Sys_NET_PollerRemove( poller, socket->handle );
+	}
+}
+
+/*
+* NET_Poll
+*
+* Waits up to msec for something to happen and returns how many events it
+* filled in, or -1 on error
+*/
+int NET_Poll( net_poller_t *poller, int msec, net_poll_event_t *events, int count ) {
+	int ret = Sys_NET_PollerWait( poller, msec, events, count );
+	if( ret == SOCKET_ERROR ) {
+		NET_SetErrorStringFromLastError( "NET_Poll" );
+		return -1;
+	}
+	return ret;
+}
+
 /*
 * NET_SendFile
 */
@@ -19,6 +19,11 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 
 #include "qcommon/qcommon.h"
+#include "qcommon/array.h"
+#include "qcommon/pack.h"
+
+#define ZSTD_STATIC_LINKING_ONLY
+#include "zstd/zstd.h"
 
 #if defined ( __MACOSX__ )
 #include <arpa/inet.h>
@@ -85,6 +90,8 @@ static int local_game_port;
 static cvar_t *showpackets;
 static cvar_t *showdrop;
 static cvar_t *net_showfragments;
+static cvar_t *net_zstd;
+static cvar_t *net_capture;
 
 /*
 * Netchan_OutOfBand
@@ -207,23 +214,223 @@ static int Netchan_ZLibDecompressChunk( const uint8_t *source, unsigned long sou
 	return result;
 }
 
+//=============================================================
+// zstd compression
+//
+// Used instead of zlib when both sides agree on it in the connect
+// handshake. It runs at a fast level with a dictionary trained on captured
+// netchan traffic, which is what makes it worthwhile on messages this small.
+//
+// To make a new dictionary, capture a few maps' worth of snapshots with
+// net_capture on a busy server, then
+// zstd --train --maxdict=65536 -r <write dir>/base/netcapture -o base/netchan.dict
+// and check it against traffic from a map it wasn't trained on with netchanbench
+//
+// Both sides have to use the same dictionary, so its ID goes in the connect
+// packet and we fall back to zlib if they don't match.
+//=============================================================
+
+#define NETCHAN_ZSTD_LEVEL 1
+#define NETCHAN_DICT_PATH "netchan.dict"
+#define NETCHAN_CAPTURE_DIR "netcapture"
+
+static ZSTD_CCtx *zstd_cctx;
+static ZSTD_DCtx *zstd_dctx;
+static ZSTD_CDict *zstd_cdict;
+static ZSTD_DDict *zstd_ddict;
+static unsigned zstd_dict_id;
+
+static int capture_index = -1;
+
+/*
+* Netchan_LoadZstdDictionary
+*/
+static void Netchan_LoadZstdDictionary( void ) {
+	uint8_t *buf;
+	int length = FS_LoadFile( NETCHAN_DICT_PATH, (void **)&buf, NULL, 0 );
+	defer { FS_FreeFile( buf ); };
+
+	Span< const u8 > dict = Span< const u8 >( buf, length > 0 ? length : 0 );
+	Span< const u8 > packed;
+	bool packed_allocated = false;
+	defer {
+		if( packed_allocated ) {
+			FREE( sys_allocator, const_cast< u8 * >( packed.ptr ) );
+		}
+	};
+
+	if( buf == NULL ) {
+		const PackedFile * file = FindPackedFile( Hash64( NETCHAN_DICT_PATH ) );
+		if( file == NULL || !ReadPackedFile( file, sys_allocator, &packed, &packed_allocated ) ) {
+			Com_DPrintf( "No netchan dictionary, zstd will run without one\n" );
+			return;
+		}
+		dict = packed;
+	}
+
+	zstd_cdict = ZSTD_createCDict( dict.ptr, dict.n, NETCHAN_ZSTD_LEVEL );
+	zstd_ddict = ZSTD_createDDict( dict.ptr, dict.n );
+	if( zstd_cdict == NULL || zstd_ddict == NULL ) {
+		Com_Printf( S_COLOR_YELLOW "Bad netchan dictionary, ignoring it\n" );
+		ZSTD_freeCDict( zstd_cdict );
+		ZSTD_freeDDict( zstd_ddict );
+		zstd_cdict = NULL;
+		zstd_ddict = NULL;
+		return;
+	}
+
+	zstd_dict_id = ZSTD_getDictID_fromDDict( zstd_ddict );
+}
+
+/*
+* Netchan_InitZstd
+*/
+static void Netchan_InitZstd( void ) {
+	zstd_cctx = ZSTD_createCCtx();
+	zstd_dctx = ZSTD_createDCtx();
+
+	// leave out everything the other side already knows to save a few bytes
+	// per message
+	ZSTD_CCtx_setParameter( zstd_cctx, ZSTD_c_compressionLevel, NETCHAN_ZSTD_LEVEL );
+	ZSTD_CCtx_setParameter( zstd_cctx, ZSTD_c_format, ZSTD_f_zstd1_magicless );
+	ZSTD_CCtx_setParameter( zstd_cctx, ZSTD_c_contentSizeFlag, 0 );
+	ZSTD_CCtx_setParameter( zstd_cctx, ZSTD_c_dictIDFlag, 0 );
+	ZSTD_DCtx_setParameter( zstd_dctx, ZSTD_d_format, ZSTD_f_zstd1_magicless );
+
+	Netchan_LoadZstdDictionary();
+
+	if( zstd_cdict != NULL ) {
+		ZSTD_CCtx_refCDict( zstd_cctx, zstd_cdict );
+		ZSTD_DCtx_refDDict( zstd_dctx, zstd_ddict );
+	}
+}
+
+/*
+* Netchan_ShutdownZstd
+*/
+static void Netchan_ShutdownZstd( void ) {
+	ZSTD_freeCCtx( zstd_cctx );
+	ZSTD_freeDCtx( zstd_dctx );
+	ZSTD_freeCDict( zstd_cdict );
+	ZSTD_freeDDict( zstd_ddict );
+	zstd_cctx = NULL;
+	zstd_dctx = NULL;
+	zstd_cdict = NULL;
+	zstd_ddict = NULL;
+	zstd_dict_id = 0;
+}
+
+static int Netchan_ZstdCompressChunk( const uint8_t *source, size_t sourceLen, uint8_t *dest, size_t destLen ) {
+	size_t r = ZSTD_compress2( zstd_cctx, dest, destLen, source, sourceLen );
+	if( ZSTD_isError( r ) ) {
+		if( ZSTD_getErrorCode( r ) == ZSTD_error_dstSize_tooSmall ) {
+			return destLen; // incompressible, the caller sends it as is
+		}
+		Com_DPrintf( "zstd error on compress: %s\n", ZSTD_getErrorName( r ) );
+		return -1;
+	}
+
+	return r;
+}
+
+static int Netchan_ZstdDecompressChunk( const uint8_t *source, size_t sourceLen, uint8_t *dest, size_t destLen ) {
+	size_t r = ZSTD_decompressDCtx( zstd_dctx, dest, destLen, source, sourceLen );
+	if( ZSTD_isError( r ) ) {
+		Com_DPrintf( "zstd error on decompress: %s\n", ZSTD_getErrorName( r ) );
+		return -1;
+	}
+
+	return r;
+}
+
+/*
+* Netchan_ZstdDictID
+*/
+unsigned Netchan_ZstdDictID( void ) {
+	return zstd_dict_id;
+}
+
+/*
+* Netchan_LocalCompression
+*
+* What we ask for when connecting
+*/
+netchan_compression_t Netchan_LocalCompression( void ) {
+	return net_zstd->integer ? NETCHAN_COMPRESSION_ZSTD : NETCHAN_COMPRESSION_ZLIB;
+}
+
+/*
+* Netchan_NegotiateCompression
+*
+* What we use with a peer that asked for requested
+*/
+netchan_compression_t Netchan_NegotiateCompression( int requested, unsigned dict_id ) {
+	if( requested == NETCHAN_COMPRESSION_ZSTD && net_zstd->integer && dict_id == zstd_dict_id ) {
+		return NETCHAN_COMPRESSION_ZSTD;
+	}
+	return NETCHAN_COMPRESSION_ZLIB;
+}
+
+/*
+* Netchan_CaptureMessage
+*
+* net_capture N writes the next N messages we compress to netcapture/,
+* one file each, to train dictionaries and run netchanbench on
+*/
+static void Netchan_CaptureMessage( const msg_t *msg ) {
+	char path[MAX_QPATH];
+	int file;
+
+	if( capture_index < 0 ) {
+		// carry on from any earlier captures
+		capture_index = 0;
+		while( true ) {
+			snprintf( path, sizeof( path ), NETCHAN_CAPTURE_DIR "/%06i.msg", capture_index );
+			if( FS_FOpenFile( path, &file, FS_READ ) < 0 ) {
+				break;
+			}
+			FS_FCloseFile( file );
+			capture_index++;
+		}
+	}
+
+	snprintf( path, sizeof( path ), NETCHAN_CAPTURE_DIR "/%06i.msg", capture_index );
+	if( FS_FOpenFile( path, &file, FS_WRITE ) < 0 ) {
+		Com_Printf( "Couldn't open %s for writing\n", path );
+		Cvar_ForceSet( "net_capture", "0" );
+		return;
+	}
+
+	FS_Write( msg->data, msg->cursize, file );
+	FS_FCloseFile( file );
+	capture_index++;
+
+	Cvar_ForceSet( "net_capture", va( "%i", net_capture->integer - 1 ) );
+}
+
 /*
 * Netchan_CompressMessage
 */
-int Netchan_CompressMessage( msg_t *msg ) {
+int Netchan_CompressMessage( msg_t *msg, netchan_compression_t compression ) {
 	int length;
 
 	if( msg == NULL || !msg->data ) {
 		return 0;
 	}
 
-	// zero-fill our buffer
-	length = 0;
-	memset( msg_process_data, 0, sizeof( msg_process_data ) );
+	if( net_capture->integer > 0 ) {
+		Netchan_CaptureMessage( msg );
+	}
 
 	//compress the message
-	length = Netchan_ZLibCompressChunk( msg->data, msg->cursize,
-										msg_process_data, sizeof( msg_process_data ), Z_BEST_COMPRESSION, -MAX_WBITS );
+	if( compression == NETCHAN_COMPRESSION_ZSTD ) {
+		length = Netchan_ZstdCompressChunk( msg->data, msg->cursize, msg_process_data, sizeof( msg_process_data ) );
+	} else {
+		// zero-fill our buffer
+		memset( msg_process_data, 0, sizeof( msg_process_data ) );
+		length = Netchan_ZLibCompressChunk( msg->data, msg->cursize,
+											msg_process_data, sizeof( msg_process_data ), Z_BEST_COMPRESSION, -MAX_WBITS );
+	}
 	if( length < 0 ) { // failed to compress, return the error
 		return length;
 	}
@@ -243,7 +450,7 @@ int Netchan_CompressMessage( msg_t *msg ) {
 /*
 * Netchan_DecompressMessage
 */
-int Netchan_DecompressMessage( msg_t *msg ) {
+int Netchan_DecompressMessage( msg_t *msg, netchan_compression_t compression ) {
 	int length;
 
 	if( msg == NULL || !msg->data ) {
@@ -254,7 +461,11 @@ int Netchan_DecompressMessage( msg_t *msg ) {
 		return 0;
 	}
 
-	length = Netchan_ZLibDecompressChunk( msg->data + msg->readcount, msg->cursize - msg->readcount, msg_process_data, ( sizeof( msg_process_data ) - msg->readcount ), -MAX_WBITS );
+	if( compression == NETCHAN_COMPRESSION_ZSTD ) {
+		length = Netchan_ZstdDecompressChunk( msg->data + msg->readcount, msg->cursize - msg->readcount, msg_process_data, ( sizeof( msg_process_data ) - msg->readcount ) );
+	} else {
+		length = Netchan_ZLibDecompressChunk( msg->data + msg->readcount, msg->cursize - msg->readcount, msg_process_data, ( sizeof( msg_process_data ) - msg->readcount ), -MAX_WBITS );
+	}
 	if( length < 0 ) {
 		return length;
 	}
@@ -614,6 +825,121 @@ int Netchan_GamePort( void ) {
 	return local_game_port;
 }
 
+typedef struct {
+	const char *name;
+	netchan_compression_t compression;
+	size_t bytes;
+	int64_t compress_usec;
+	int64_t decompress_usec;
+	int failures;
+} netchan_bench_t;
+
+static void Netchan_BenchCompression( netchan_bench_t *bench, Span< const msg_t > messages, int iterations ) {
+	static uint8_t compressed[MAX_MSGLEN];
+	static uint8_t decompressed[MAX_MSGLEN];
+
+	for( const msg_t & msg : messages ) {
+		int length;
+		int64_t t0 = Sys_Microseconds();
+		for( int i = 0; i < iterations; i++ ) {
+			if( bench->compression == NETCHAN_COMPRESSION_ZSTD ) {
+				length = Netchan_ZstdCompressChunk( msg.data, msg.cursize, compressed, sizeof( compressed ) );
+			} else {
+				length = Netchan_ZLibCompressChunk( msg.data, msg.cursize, compressed, sizeof( compressed ), Z_BEST_COMPRESSION, -MAX_WBITS );
+			}
+		}
+		int64_t t1 = Sys_Microseconds();
+
+		// same as Netchan_CompressMessage, send it as is if it didn't shrink
+		if( length < 0 || (size_t)length >= msg.cursize ) {
+			bench->bytes += msg.cursize;
+			bench->compress_usec += t1 - t0;
+			continue;
+		}
+
+		int decompressed_length;
+		for( int i = 0; i < iterations; i++ ) {
+			if( bench->compression == NETCHAN_COMPRESSION_ZSTD ) {
+				decompressed_length = Netchan_ZstdDecompressChunk( compressed, length, decompressed, sizeof( decompressed ) );
+			} else {
+				decompressed_length = Netchan_ZLibDecompressChunk( compressed, length, decompressed, sizeof( decompressed ), -MAX_WBITS );
+			}
+		}
+		int64_t t2 = Sys_Microseconds();
+
+		if( decompressed_length != (int)msg.cursize || memcmp( decompressed, msg.data, msg.cursize ) != 0 ) {
+			bench->failures++;
+		}
+
+		bench->bytes += length;
+		bench->compress_usec += t1 - t0;
+		bench->decompress_usec += t2 - t1;
+	}
+}
+
+/*
+* Netchan_Bench_f
+*
+* netchanbench [iterations]
+*
+* Runs everything captured with net_capture through zlib the way we used to
+* compress it, and zstd with and without the dictionary
+*/
+static void Netchan_Bench_f( void ) {
+	int iterations = Cmd_Argc() > 1 ? Max2( atoi( Cmd_Argv( 1 ) ), 1 ) : 10;
+
+	DynamicArray< msg_t > messages( sys_allocator );
+	defer {
+		for( msg_t & msg : messages ) {
+			FS_FreeFile( msg.data );
+		}
+	};
+
+	size_t total = 0;
+	for( int i = 0; ; i++ ) {
+		char path[MAX_QPATH];
+		snprintf( path, sizeof( path ), NETCHAN_CAPTURE_DIR "/%06i.msg", i );
+
+		msg_t msg = { };
+		int length = FS_LoadFile( path, (void **)&msg.data, NULL, 0 );
+		if( msg.data == NULL ) {
+			break;
+		}
+
+		msg.cursize = msg.maxsize = length;
+		total += length;
+		messages.add( msg );
+	}
+
+	if( messages.size() == 0 ) {
+		Com_Printf( "Nothing in " NETCHAN_CAPTURE_DIR "/, capture some traffic with net_capture first\n" );
+		return;
+	}
+
+	netchan_bench_t benches[] = {
+		{ "zlib", NETCHAN_COMPRESSION_ZLIB },
+		{ "zstd", NETCHAN_COMPRESSION_ZSTD },
+		{ "zstd without dictionary", NETCHAN_COMPRESSION_ZSTD },
+	};
+
+	Netchan_BenchCompression( &benches[0], messages.span(), iterations );
+	Netchan_BenchCompression( &benches[1], messages.span(), iterations );
+
+	ZSTD_CCtx_refCDict( zstd_cctx, NULL );
+	ZSTD_DCtx_refDDict( zstd_dctx, NULL );
+	Netchan_BenchCompression( &benches[2], messages.span(), iterations );
+	ZSTD_CCtx_refCDict( zstd_cctx, zstd_cdict );
+	ZSTD_DCtx_refDDict( zstd_dctx, zstd_ddict );
+
+	Com_Printf( "%zu messages, %zu bytes, %i iterations, dictionary %u\n", messages.size(), total, iterations, zstd_dict_id );
+	for( const netchan_bench_t & bench : benches ) {
+		double runs = double( messages.size() ) * iterations;
+		Com_Printf( "%s: %zu bytes (%.1f%%), compress %.2fus/msg, decompress %.2fus/msg%s\n", bench.name,
+					bench.bytes, 100.0 * bench.bytes / total, bench.compress_usec / runs, bench.decompress_usec / runs,
+					bench.failures > 0 ? va( S_COLOR_RED " %i round trip failures", bench.failures ) : "" );
+	}
+}
+
 /*
 * Netchan_Init
 */
@@ -624,10 +950,19 @@ void Netchan_Init( void ) {
 	showpackets = Cvar_Get( "showpackets", "0", 0 );
 	showdrop = Cvar_Get( "showdrop", "0", 0 );
 	net_showfragments = Cvar_Get( "net_showfragments", "0", 0 );
+	net_zstd = Cvar_Get( "net_zstd", "1", CVAR_ARCHIVE );
+	net_capture = Cvar_Get( "net_capture", "0", 0 );
+
+	Netchan_InitZstd();
+
+	Cmd_AddCommand( "netchanbench", Netchan_Bench_f );
 }
 
 /*
 * Netchan_Shutdown
 */
 void Netchan_Shutdown( void ) {
+	Cmd_RemoveCommand( "netchanbench" );
+
+	Netchan_ShutdownZstd();
 }
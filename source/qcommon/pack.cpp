@@ -0,0 +1,169 @@
+#include "qcommon/base.h"
+#include "qcommon/qcommon.h"
+#include "qcommon/fs.h"
+#include "qcommon/pack.h"
+
+#include "zstd/zstd.h"
+
+static Span< const u8 > pack;
+static const PackHeader * header;
+static const PackedFile * files;
+static const u32 * pack_index;
+static const char * names;
+static ZSTD_DDict * dict;
+
+static bool InRange( u64 offset, u64 size ) {
+	return offset <= pack.n && size <= pack.n - offset;
+}
+
+static bool ValidatePack() {
+	if( pack.n < sizeof( PackHeader ) )
+		return false;
+
+	header = ( const PackHeader * ) pack.ptr;
+	if( header->magic != PACK_MAGIC || header->version != PACK_VERSION )
+		return false;
+
+	if( header->index_capacity == 0 || !IsPowerOf2( header->index_capacity ) || header->index_capacity <= header->num_files )
+		return false;
+
+	if( header->files_offset % alignof( PackedFile ) != 0 || header->index_offset % alignof( u32 ) != 0 )
+		return false;
+
+	if( !InRange( header->files_offset, u64( header->num_files ) * sizeof( PackedFile ) ) )
+		return false;
+	if( !InRange( header->index_offset, u64( header->index_capacity ) * sizeof( u32 ) ) )
+		return false;
+	if( !InRange( header->names_offset, header->names_size ) || header->names_size == 0 )
+		return false;
+	if( !InRange( header->dict_offset, header->dict_size ) )
+		return false;
+
+	files = ( const PackedFile * ) ( pack.ptr + header->files_offset );
+	pack_index = ( const u32 * ) ( pack.ptr + header->index_offset );
+	names = ( const char * ) ( pack.ptr + header->names_offset );
+
+	if( names[ header->names_size - 1 ] != '\0' )
+		return false;
+
+	for( u32 i = 0; i < header->num_files; i++ ) {
+		const PackedFile * file = &files[ i ];
+		// + 1 for the trailing '\0'
+		if( file->size >= pack.n || !InRange( file->offset, file->size + 1 ) || pack.ptr[ file->offset + file->size ] != '\0' )
+			return false;
+		if( file->name_offset >= header->names_size )
+			return false;
+		if( ( file->flags & PackedFileFlag_Compressed ) == 0 && file->size != file->decompressed_size )
+			return false;
+	}
+
+	for( u32 i = 0; i < header->index_capacity; i++ ) {
+		if( pack_index[ i ] > header->num_files )
+			return false;
+	}
+
+	return true;
+}
+
+static void UnmountPack() {
+	UnmapFile( pack );
+	pack = Span< const u8 >();
+	header = NULL;
+	files = NULL;
+	pack_index = NULL;
+	names = NULL;
+}
+
+void InitPack() {
+	ZoneScoped;
+
+	u8 arena_memory[ 4096 ];
+	ArenaAllocator arena( arena_memory, sizeof( arena_memory ) );
+	TempAllocator temp = arena.temp();
+
+	const char * path = temp( "{}/base.pack", FS_RootPath( &temp ) );
+
+	bool zero_padded;
+	if( !MapFile( path, &pack, &zero_padded ) )
+		return;
+
+	if( !ValidatePack() ) {
+		Com_Printf( S_COLOR_RED "%s is corrupt, ignoring it\n", path );
+		UnmountPack();
+		return;
+	}
+
+	if( header->dict_size > 0 ) {
+		dict = ZSTD_createDDict( pack.ptr + header->dict_offset, header->dict_size );
+		if( dict == NULL ) {
+			Com_Printf( S_COLOR_RED "%s has a bad dictionary, ignoring it\n", path );
+			UnmountPack();
+			return;
+		}
+	}
+
+	Com_Printf( "Mounted %s with %u files\n", path, header->num_files );
+}
+
+void ShutdownPack() {
+	ZSTD_freeDDict( dict );
+	dict = NULL;
+	UnmountPack();
+}
+
+Span< const PackedFile > PackedFiles() {
+	if( header == NULL )
+		return Span< const PackedFile >();
+	return Span< const PackedFile >( files, header->num_files );
+}
+
+const char * PackedFileName( const PackedFile * file ) {
+	return names + file->name_offset;
+}
+
+const PackedFile * FindPackedFile( u64 hash ) {
+	if( header == NULL )
+		return NULL;
+
+	u32 mask = header->index_capacity - 1;
+	for( u32 i = hash & mask; pack_index[ i ] != 0; i = ( i + 1 ) & mask ) {
+		const PackedFile * file = &files[ pack_index[ i ] - 1 ];
+		if( file->hash == hash ) {
+			return file;
+		}
+	}
+
+	return NULL;
+}
+
+bool ReadPackedFile( const PackedFile * file, Allocator * a, Span< const u8 > * data, bool * allocated ) {
+	ZoneScoped;
+
+	Span< const u8 > stored = pack.slice( file->offset, file->offset + file->size );
+
+	if( ( file->flags & PackedFileFlag_Compressed ) == 0 ) {
+		*data = stored;
+		*allocated = false;
+		return true;
+	}
+
+	u8 * decompressed = ALLOC_MANY( a, u8, file->decompressed_size + 1 );
+
+	ZSTD_DCtx * dctx = ZSTD_createDCtx();
+	defer { ZSTD_freeDCtx( dctx ); };
+
+	size_t r = dict == NULL ?
+		ZSTD_decompressDCtx( dctx, decompressed, file->decompressed_size, stored.ptr, stored.n ) :
+		ZSTD_decompress_usingDDict( dctx, decompressed, file->decompressed_size, stored.ptr, stored.n, dict );
+	if( r != file->decompressed_size ) {
+		Com_Printf( S_COLOR_RED "Can't decompress %s: %s\n", PackedFileName( file ), ZSTD_isError( r ) ? ZSTD_getErrorName( r ) : "wrong size" );
+		FREE( a, decompressed );
+		return false;
+	}
+
+	decompressed[ file->decompressed_size ] = '\0';
+
+	*data = Span< const u8 >( decompressed, file->decompressed_size );
+	*allocated = true;
+	return true;
+}
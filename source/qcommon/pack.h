@@ -0,0 +1,67 @@
+#pragma once
+
+#include "qcommon/types.h"
+
+/*
+ * base.pack is everything in base/ packed into one file by
+ * ggbuild/pack_assets.lua. The layout is:
+ *
+ * PackHeader
+ * PackedFile[ num_files ]
+ * u32 index[ index_capacity ] - open addressing on PackedFile::hash, file + 1, 0 is empty
+ * names - NUL terminated paths relative to base/
+ * zstd dictionary
+ * file data
+ *
+ * Everything is little endian. File data starts on a PACK_PAGE_SIZE boundary,
+ * uncompressed files are page aligned so they can be used straight out of the
+ * mapping, and every file is followed by a '\0'. Compressed files are
+ * individual zstd frames, compressed with the dictionary if there is one.
+ */
+
+constexpr u32 PACK_MAGIC = 0x4b505346; // FSPK
+constexpr u32 PACK_VERSION = 1;
+constexpr u64 PACK_PAGE_SIZE = 4096;
+
+enum PackedFileFlags : u32 {
+	PackedFileFlag_Compressed = 1 << 0,
+};
+
+struct PackHeader {
+	u32 magic;
+	u32 version;
+	u32 num_files;
+	u32 index_capacity;
+	u64 files_offset;
+	u64 index_offset;
+	u64 names_offset;
+	u64 names_size;
+	u64 dict_offset;
+	u64 dict_size;
+};
+
+struct PackedFile {
+	u64 hash; // Hash64 of the name, same as StringHash
+	u64 offset;
+	u64 size;
+	u64 decompressed_size;
+	u32 name_offset;
+	u32 flags;
+};
+
+STATIC_ASSERT( sizeof( PackHeader ) == 64 );
+STATIC_ASSERT( sizeof( PackedFile ) == 40 );
+
+void InitPack();
+void ShutdownPack();
+
+Span< const PackedFile > PackedFiles();
+const char * PackedFileName( const PackedFile * file );
+const PackedFile * FindPackedFile( u64 hash );
+
+/*
+ * ReadPackedFile returns uncompressed files straight out of the mapping and
+ * decompresses the others into a, setting allocated. Either way there's a
+ * '\0' after the end of data.
+ */
+bool ReadPackedFile( const PackedFile * file, Allocator * a, Span< const u8 > * data, bool * allocated );
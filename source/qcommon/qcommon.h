@@ -120,6 +120,8 @@ void MSG_ReadDeltaPlayerState( msg_t * msg, const SyncPlayerState * baseline, Sy
 void MSG_ReadDeltaGameState( msg_t * msg, const SyncGameState * baseline, SyncGameState * state );
 void MSG_ReadData( msg_t *sb, void *buffer, size_t length );
 
+void MSG_DeltaBenchmark_f( void );
+
 //============================================================================
 
 #define SNAP_MAX_DEMO_META_DATA_SIZE    16 * 1024
@@ -130,14 +132,40 @@ void MSG_ReadData( msg_t *sb, void *buffer, size_t length );
 void SNAP_ParseBaseline( msg_t *msg, SyncEntityState *baselines );
 struct snapshot_s *SNAP_ParseFrame( msg_t *msg, struct snapshot_s *lastFrame, struct snapshot_s *backup, SyncEntityState *baselines, int showNet );
 
+// caches encoded entity deltas so clients that ack the same frame can share them
+struct SnapDeltaCache;
+SnapDeltaCache *SNAP_NewDeltaCache( void );
+void SNAP_DeleteDeltaCache( SnapDeltaCache *cache );
+void SNAP_PlotDeltaCacheStats( SnapDeltaCache *cache );
+
+// budget is how big msg can get before entity updates get held back until
+// the next snapshot, most important first. 0 means no limit
+#define SNAP_MIN_BUDGET 256
 void SNAP_WriteFrameSnapToClient( struct ginfo_s *gi, struct client_s *client, msg_t *msg, int64_t frameNum, int64_t gameTime,
-	SyncEntityState *baselines, struct client_entities_s *client_entities );
+	SyncEntityState *baselines, struct client_entities_s *client_entities, SnapDeltaCache *delta_cache, size_t budget );
 
 void SNAP_BuildClientFrameSnap( CollisionModel *cms, struct ginfo_s *gi, int64_t frameNum, int64_t timeStamp,
 								struct client_s *client,
 								SyncGameState *gameState, struct client_entities_s *client_entities,
 								struct mempool_s *mempool );
 
+// SNAP_BuildClientFrameSnap split into stages so the culling can run on worker
+// threads. Begin and Finish must be called on the main thread, in client order
+#define MAX_SNAPSHOT_ENTITIES   1024
+typedef struct {
+	int numSnapshotEntities;
+	int snapshotEntities[MAX_SNAPSHOT_ENTITIES];
+	uint8_t entityAddedToSnapList[MAX_EDICTS / 8];
+} snapshotEntityNumbers_t;
+
+void SNAP_ValidateSnapEntities( struct ginfo_s *gi );
+bool SNAP_BeginClientFrameSnap( struct ginfo_s *gi, int64_t frameNum, int64_t timeStamp, struct client_s *client,
+								CollisionModel *cms, struct mempool_s *mempool );
+void SNAP_CullClientFrameSnap( CollisionModel *cms, struct ginfo_s *gi, int64_t frameNum, struct client_s *client,
+							   snapshotEntityNumbers_t *entsList );
+void SNAP_FinishClientFrameSnap( struct ginfo_s *gi, int64_t frameNum, struct client_s *client, SyncGameState *gameState,
+								 struct client_entities_s *client_entities, const snapshotEntityNumbers_t *entsList );
+
 void SNAP_FreeClientFrames( struct client_s *client );
 
 void SNAP_RecordDemoMessage( int demofile, msg_t *msg, int offset );
@@ -332,6 +360,7 @@ NET
 #define MAX_RELIABLE_COMMANDS   64          // max string commands buffered for restransmit
 #define MAX_PACKETLEN           1400        // max size of a network packet
 #define MAX_MSGLEN              32768       // max length of a message, which may be fragmented into multiple packets
+#define NET_MAX_BATCH           32          // max packets moved per NET_GetPackets call or batched send syscall
 
 // wsw: Medar: doubled the MSGLEN as a temporary solution for multiview on bigger servers
 #define FRAGMENT_SIZE           ( MAX_PACKETLEN - 96 )
@@ -412,9 +441,20 @@ void        NET_CloseSocket( socket_t *socket );
 
 bool        NET_Listen( const socket_t *socket );
 int         NET_Accept( const socket_t *socket, socket_t *newsocket, netadr_t *address );
+connection_status_t NET_Connect( socket_t *socket, const netadr_t *address );
+connection_status_t NET_CheckConnect( socket_t *socket );
 
 int         NET_GetPacket( const socket_t *socket, netadr_t *address, msg_t *message );
 bool        NET_SendPacket( const socket_t *socket, const void *data, size_t length, const netadr_t *address );
+int         NET_GetPackets( const socket_t *socket, netadr_t *addresses, msg_t *messages, int count );
+void        NET_BeginSendBatch( void );
+void        NET_EndSendBatch( void );
+
+// scoped NET_BeginSendBatch/NET_EndSendBatch so the batch can't be left open
+struct NetSendBatch {
+	NetSendBatch() { NET_BeginSendBatch(); }
+	~NetSendBatch() { NET_EndSendBatch(); }
+};
 
 int         NET_Get( const socket_t *socket, netadr_t *address, void *data, size_t length );
 int         NET_Send( const socket_t *socket, const void *data, size_t length, const netadr_t *address );
@@ -425,6 +465,33 @@ int         NET_Monitor( int msec, socket_t *sockets[],
 						 void ( *read_cb )( socket_t *socket, void* ),
 						 void ( *write_cb )( socket_t *socket, void* ),
 						 void ( *exception_cb )( socket_t *socket, void* ), void *privatep[] );
+
+/*
+* A poller waits on any number of sockets in O(ready) instead of O(sockets)
+* like NET_Monitor. It's edge triggered: a socket is reported once when it
+* becomes readable or writable, and not again until a read or write on it
+* has come back with would block, so callers have to drain it each time.
+* NET_CreatePoller returns NULL if the platform doesn't have one, in which
+* case use NET_Monitor.
+*/
+typedef struct net_poller_s net_poller_t;
+
+#define NET_POLL_READ       1
+#define NET_POLL_WRITE      2
+#define NET_POLL_HANGUP     4   // error, or the connection is gone both ways
+#define NET_POLL_READ_CLOSED 8  // the other end shut down its side, reads hit EOF once what's buffered is drained
+
+typedef struct {
+	void *data;
+	int flags;
+} net_poll_event_t;
+
+net_poller_t *NET_CreatePoller( void );
+void        NET_DestroyPoller( net_poller_t *poller );
+bool        NET_PollerAdd( net_poller_t *poller, const socket_t *socket, void *data );
+void        NET_PollerRemove( net_poller_t *poller, const socket_t *socket );
+int         NET_Poll( net_poller_t *poller, int msec, net_poll_event_t *events, int count );
+
 const char *NET_ErrorString( void );
 
 #ifndef _MSC_VER
@@ -452,8 +519,14 @@ void    NET_BroadcastAddress( netadr_t *address, int port );
 
 //============================================================================
 
+typedef enum {
+	NETCHAN_COMPRESSION_ZLIB,
+	NETCHAN_COMPRESSION_ZSTD,
+} netchan_compression_t;
+
 typedef struct {
 	const socket_t *socket;
+	netchan_compression_t compression;  // agreed on when connecting
 
 	int dropped;                // between last packet and previous
 
@@ -489,8 +562,11 @@ bool Netchan_Process( netchan_t *chan, msg_t *msg );
 bool Netchan_Transmit( netchan_t *chan, msg_t *msg );
 bool Netchan_PushAllFragments( netchan_t *chan );
 bool Netchan_TransmitNextFragment( netchan_t *chan );
-int Netchan_CompressMessage( msg_t *msg );
-int Netchan_DecompressMessage( msg_t *msg );
+int Netchan_CompressMessage( msg_t *msg, netchan_compression_t compression );
+int Netchan_DecompressMessage( msg_t *msg, netchan_compression_t compression );
+netchan_compression_t Netchan_LocalCompression( void );
+netchan_compression_t Netchan_NegotiateCompression( int requested, unsigned dict_id );
+unsigned Netchan_ZstdDictID( void );
 void Netchan_OutOfBand( const socket_t *socket, const netadr_t *address, size_t length, const uint8_t *data );
 
 #ifndef _MSC_VER
@@ -567,6 +643,7 @@ bool    FS_RemoveBaseFile( const char *filename );
 bool    FS_RemoveAbsoluteFile( const char *filename );
 unsigned    FS_ChecksumAbsoluteFile( const char *filename );
 unsigned    FS_ChecksumBaseFile( const char *filename );
+int64_t     FS_BaseFileMTime( const char *filename );
 
 // // only for game files
 const char *FS_BaseNameForFile( const char *filename );
@@ -763,6 +840,7 @@ void SV_Init( void );
 void SV_Shutdown( const char *finalmsg );
 void SV_ShutdownGame( const char *finalmsg, bool reconnect );
 void SV_Frame( unsigned realMsec, unsigned gameMsec );
+void SV_WaitForNextFrame( int64_t elapsed );
 bool SV_SendMessageToClient( struct client_s *client, msg_t *msg );
 void SV_ParseClientMessage( struct client_s *client, msg_t *msg );
 
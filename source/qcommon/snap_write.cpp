@@ -18,8 +18,11 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 */
 
+#include <algorithm>
+
 #include "qcommon/qcommon.h"
 #include "qcommon/cmodel.h"
+#include "qcommon/threads.h"
 #include "server/server.h"
 
 #undef EDICT_NUM
@@ -36,12 +39,407 @@ Encode a client frame onto the network channel
 =========================================================================
 */
 
+/*
+=========================================================================
+
+Entity delta cache
+
+Every client gets its own copy of an entity's state, but the copies made
+in the same server frame are identical. So the delta between an entity at
+frame A and frame B is the same for every client that acked frame A, and
+only has to be encoded once per server frame.
+
+=========================================================================
+*/
+
+#define DELTA_CACHE_WAYS 4 // distinct baseline frames cached per entity
+#define DELTA_CACHE_MAX_BYTES 256
+#define DELTA_CACHE_LOCKS 64
+
+struct SnapDeltaCacheEntry {
+	int64_t frame; // entries from older frames are free
+	int64_t baseline_frame; // -1 when deltaing from the baselines
+	SyncEntityState written; // the state after MSG_WriteDeltaEntity quantized it
+	u16 num_bytes;
+	u8 bytes[ DELTA_CACHE_MAX_BYTES ];
+};
+
+struct SnapDeltaCache {
+	SnapDeltaCacheEntry entries[ MAX_EDICTS ][ DELTA_CACHE_WAYS ];
+
+	// striped by entity number so the parallel snapshot writer rarely contends
+	Mutex *locks[ DELTA_CACHE_LOCKS ];
+	u32 hits[ DELTA_CACHE_LOCKS ];
+	u32 misses[ DELTA_CACHE_LOCKS ];
+};
+
+SnapDeltaCache *SNAP_NewDeltaCache( void ) {
+	SnapDeltaCache *cache = ALLOC( sys_allocator, SnapDeltaCache );
+	memset( cache, 0, sizeof( *cache ) );
+
+	for( Mutex *& lock : cache->locks ) {
+		lock = NewMutex();
+	}
+
+	for( int i = 0; i < MAX_EDICTS; i++ ) {
+		for( SnapDeltaCacheEntry & entry : cache->entries[i] ) {
+			entry.frame = -1;
+		}
+	}
+
+	return cache;
+}
+
+void SNAP_DeleteDeltaCache( SnapDeltaCache *cache ) {
+	if( cache == NULL ) {
+		return;
+	}
+
+	for( Mutex *lock : cache->locks ) {
+		DeleteMutex( lock );
+	}
+
+	FREE( sys_allocator, cache );
+}
+
+/*
+* SNAP_PlotDeltaCacheStats
+*
+* Reports the hit rate since the last call
+*/
+void SNAP_PlotDeltaCacheStats( SnapDeltaCache *cache ) {
+	u32 hits = 0;
+	u32 misses = 0;
+	for( int i = 0; i < DELTA_CACHE_LOCKS; i++ ) {
+		hits += cache->hits[i];
+		misses += cache->misses[i];
+		cache->hits[i] = 0;
+		cache->misses[i] = 0;
+	}
+
+	TracyPlot( "Snapshot delta cache hits", int64_t( hits ) );
+	TracyPlot( "Snapshot delta cache misses", int64_t( misses ) );
+	if( hits + misses > 0 ) {
+		TracyPlot( "Snapshot delta cache hit rate", float( hits ) / float( hits + misses ) );
+	}
+}
+
+/*
+* SNAP_WriteDeltaEntity
+*
+* MSG_WriteDeltaEntity, but reuses the bytes if another client already
+* wrote the same entity against the same baseline frame this frame
+*/
+static void SNAP_WriteDeltaEntity( SnapDeltaCache *cache, int64_t frameNum, int64_t baselineFrame,
+								   msg_t *msg, const SyncEntityState *baseline, SyncEntityState *ent, bool force ) {
+	if( cache == NULL || ent->number < 0 || ent->number >= MAX_EDICTS ) {
+		MSG_WriteDeltaEntity( msg, baseline, ent, force );
+		return;
+	}
+
+	int stripe = ent->number % DELTA_CACHE_LOCKS;
+	SnapDeltaCacheEntry *ways = cache->entries[ent->number];
+
+	Lock( cache->locks[stripe] );
+	for( int i = 0; i < DELTA_CACHE_WAYS; i++ ) {
+		const SnapDeltaCacheEntry *entry = &ways[i];
+		if( entry->frame == frameNum && entry->baseline_frame == baselineFrame ) {
+			MSG_WriteData( msg, entry->bytes, entry->num_bytes );
+			*ent = entry->written;
+			cache->hits[stripe]++;
+			Unlock( cache->locks[stripe] );
+			return;
+		}
+	}
+	cache->misses[stripe]++;
+	Unlock( cache->locks[stripe] );
+
+	size_t start = msg->cursize;
+	MSG_WriteDeltaEntity( msg, baseline, ent, force );
+	size_t num_bytes = msg->cursize - start;
+
+	if( num_bytes > DELTA_CACHE_MAX_BYTES ) {
+		return;
+	}
+
+	Lock( cache->locks[stripe] );
+	for( int i = 0; i < DELTA_CACHE_WAYS; i++ ) {
+		SnapDeltaCacheEntry *entry = &ways[i];
+		if( entry->frame == frameNum && entry->baseline_frame == baselineFrame ) {
+			break; // someone beat us to it
+		}
+
+		if( entry->frame != frameNum ) {
+			entry->frame = frameNum;
+			entry->baseline_frame = baselineFrame;
+			entry->written = *ent;
+			entry->num_bytes = num_bytes;
+			memcpy( entry->bytes, msg->data + start, num_bytes );
+			break;
+		}
+	}
+	Unlock( cache->locks[stripe] );
+}
+
+/*
+=========================================================================
+
+Snapshot budget
+
+When a client has a budget, every entity delta is written to the message
+first. If they don't all fit, the most important ones are kept and the
+rest are cut back out and held back until the next snapshot instead of
+making the netchan fragment. The client keeps what it had for those, so
+we put that back into the frame we store for delta compression: the old
+state for entities it already knew about, and nothing for new ones.
+
+That makes the stored frame different from what other clients acking the
+same frame number have, so budgeted clients and clients deltaing from a
+frame that had entities held back don't use the delta cache.
+
+=========================================================================
+*/
+
+// past this many snapshots in a row an entity goes out even if it doesn't
+// fit, so a budget that's too small for the fixed part of the snapshot
+// can't hide things forever
+#define SNAP_MAX_DEFERRED 10
+
+struct SnapEntityUpdate {
+	int oldindex; // -1 for new entities
+	int newindex; // -1 for removals
+	u32 offset; // into the message
+	u32 num_bytes;
+	float priority;
+	bool send;
+};
+
+/*
+* SNAP_EntityPriority
+*
+* Higher goes first when there isn't room for everything
+*/
+static float SNAP_EntityPriority( const SyncEntityState *ent, Vec3 vieworg, Vec3 forward, int deferred ) {
+	float priority;
+
+	switch( ent->type ) {
+		case ET_PLAYER:
+		case ET_CORPSE:
+			priority = 4.0f;
+			break;
+
+		// fast and deadly
+		case ET_ROCKET:
+		case ET_GRENADE:
+		case ET_PLASMA:
+		case ET_BUBBLE:
+		case ET_RIFLEBULLET:
+		case ET_LASERBEAM:
+			priority = 3.0f;
+			break;
+
+		default:
+			priority = 1.0f;
+			break;
+	}
+
+	// events only last a frame, so if we hold them back they're gone
+	if( ent->type >= EVENT_ENTITIES_START || ent->events[0].type ) {
+		priority += 8.0f;
+	}
+
+	Vec3 dir = ent->origin - vieworg;
+	float dist = Length( dir );
+	priority /= 1.0f + dist / 1024.0f;
+
+	// behind us
+	if( dist > 0.0f && Dot( dir, forward ) < 0.0f ) {
+		priority *= 0.5f;
+	}
+
+	// so everything gets through eventually
+	return priority + deferred;
+}
+
+/*
+* SNAP_ScheduleEntityUpdates
+*
+* Picks which updates go out. Returns how many got held back
+*/
+static int SNAP_ScheduleEntityUpdates( client_t *client, client_snapshot_t *to, SnapEntityUpdate *updates, int num_updates,
+									   SyncEntityState *client_entities, int num_client_entities, size_t available ) {
+	const SyncPlayerState *ps = &to->ps[0];
+	Vec3 vieworg = ps->pmove.origin + Vec3( 0.0f, 0.0f, ps->viewheight );
+	Vec3 forward;
+	AngleVectors( ps->viewangles, &forward, NULL, NULL );
+
+	int *order = ( int * ) alloca( num_updates * sizeof( int ) );
+	int num_ordered = 0;
+
+	for( int i = 0; i < num_updates; i++ ) {
+		SnapEntityUpdate *update = &updates[i];
+		update->send = true;
+
+		// removals and unchanged entities are free
+		if( update->newindex == -1 || update->num_bytes == 0 ) {
+			continue;
+		}
+
+		// our own entity always goes, and so does anything we've held back for too long
+		const SyncEntityState *ent = &client_entities[( to->first_entity + update->newindex ) % num_client_entities];
+		if( ent->number == int( ps->POVnum ) || client->snapDeferred[ent->number] >= SNAP_MAX_DEFERRED ) {
+			available -= Min2( available, size_t( update->num_bytes ) );
+			continue;
+		}
+
+		update->send = false;
+		update->priority = SNAP_EntityPriority( ent, vieworg, forward, client->snapDeferred[ent->number] );
+		order[num_ordered++] = i;
+	}
+
+	std::sort( order, order + num_ordered, [&]( int a, int b ) {
+		return updates[a].priority > updates[b].priority;
+	} );
+
+	// something small might still fit after something big didn't
+	int deferred = 0;
+	for( int i = 0; i < num_ordered; i++ ) {
+		SnapEntityUpdate *update = &updates[order[i]];
+		if( update->num_bytes <= available ) {
+			update->send = true;
+			available -= update->num_bytes;
+		} else {
+			deferred++;
+		}
+	}
+
+	return deferred;
+}
+
+/*
+* SNAP_EmitBudgetedPacketEntities
+*
+* SNAP_EmitPacketEntities for clients with a budget. Returns how many
+* entities got held back
+*/
+static int SNAP_EmitBudgetedPacketEntities( client_t *client, client_snapshot_t *from, client_snapshot_t *to, msg_t *msg,
+											int64_t frameNum, int64_t fromFrameNum, SnapDeltaCache *delta_cache,
+											SyncEntityState *baselines, SyncEntityState *client_entities, int num_client_entities,
+											size_t budget ) {
+	int from_num_entities = from ? from->num_entities : 0;
+	int max_updates = to->num_entities + from_num_entities;
+	SnapEntityUpdate *updates = ( SnapEntityUpdate * ) alloca( Max2( max_updates, 1 ) * sizeof( SnapEntityUpdate ) );
+	int num_updates = 0;
+
+	MSG_WriteUint8( msg, svc_packetentities );
+	size_t start = msg->cursize;
+
+	// the same walk as SNAP_EmitPacketEntities, but remember where each update went
+	int oldindex = 0;
+	int newindex = 0;
+	while( newindex < to->num_entities || oldindex < from_num_entities ) {
+		SyncEntityState *newent = NULL, *oldent = NULL;
+		int newnum = 9999, oldnum = 9999;
+
+		if( newindex < to->num_entities ) {
+			newent = &client_entities[( to->first_entity + newindex ) % num_client_entities];
+			newnum = newent->number;
+		}
+		if( oldindex < from_num_entities ) {
+			oldent = &client_entities[( from->first_entity + oldindex ) % num_client_entities];
+			oldnum = oldent->number;
+		}
+
+		SnapEntityUpdate *update = &updates[num_updates++];
+		update->offset = msg->cursize;
+
+		if( newnum == oldnum ) {
+			SNAP_WriteDeltaEntity( delta_cache, frameNum, fromFrameNum, msg, oldent, newent, false );
+			update->oldindex = oldindex++;
+			update->newindex = newindex++;
+		} else if( newnum < oldnum ) {
+			SNAP_WriteDeltaEntity( delta_cache, frameNum, -1, msg, &baselines[newnum], newent, true );
+			update->oldindex = -1;
+			update->newindex = newindex++;
+		} else {
+			MSG_WriteEntityNumber( msg, oldnum, true );
+			update->oldindex = oldindex++;
+			update->newindex = -1;
+		}
+
+		update->num_bytes = msg->cursize - update->offset;
+	}
+
+	// removals always go out, and leave room for the terminator
+	size_t used = start + 3;
+	for( int i = 0; i < num_updates; i++ ) {
+		if( updates[i].newindex == -1 ) {
+			used += updates[i].num_bytes;
+		}
+	}
+	size_t available = budget > used ? budget - used : 0;
+
+	int deferred = 0;
+	if( msg->cursize - start > available ) {
+		deferred = SNAP_ScheduleEntityUpdates( client, to, updates, num_updates, client_entities, num_client_entities, available );
+	} else {
+		for( int i = 0; i < num_updates; i++ ) {
+			updates[i].send = true;
+		}
+	}
+
+	// cut out what we held back, and make the stored frame match what the client will have
+	size_t cursor = start;
+	int num_entities = 0;
+	for( int i = 0; i < num_updates; i++ ) {
+		const SnapEntityUpdate *update = &updates[i];
+
+		if( update->send ) {
+			// updates only ever move down so this never clobbers one we haven't looked at
+			memmove( msg->data + cursor, msg->data + update->offset, update->num_bytes );
+			cursor += update->num_bytes;
+		}
+
+		if( update->newindex == -1 ) {
+			continue;
+		}
+
+		SyncEntityState *newent = &client_entities[( to->first_entity + update->newindex ) % num_client_entities];
+		uint8_t *deferred_count = &client->snapDeferred[newent->number];
+
+		if( update->send ) {
+			*deferred_count = 0;
+		} else {
+			*deferred_count = Min2( *deferred_count + 1, 255 );
+			if( update->oldindex == -1 ) {
+				// it doesn't know about this one yet
+				continue;
+			}
+			*newent = client_entities[( from->first_entity + update->oldindex ) % num_client_entities];
+		}
+
+		// entities only ever get dropped so this never overwrites one we haven't looked at
+		if( num_entities != update->newindex ) {
+			client_entities[( to->first_entity + num_entities ) % num_client_entities] = *newent;
+		}
+		num_entities++;
+	}
+	to->num_entities = num_entities;
+	msg->cursize = cursor;
+
+	MSG_WriteEntityNumber( msg, 0, false ); // end of packetentities
+
+	return deferred;
+}
+
 /*
 * SNAP_EmitPacketEntities
 *
 * Writes a delta update of an SyncEntityState list to the message.
 */
-static void SNAP_EmitPacketEntities( ginfo_t *gi, client_snapshot_t *from, client_snapshot_t *to, msg_t *msg, SyncEntityState *baselines, SyncEntityState *client_entities, int num_client_entities ) {
+static void SNAP_EmitPacketEntities( ginfo_t *gi, client_snapshot_t *from, client_snapshot_t *to, msg_t *msg,
+									 int64_t frameNum, int64_t fromFrameNum, SnapDeltaCache *delta_cache,
+									 SyncEntityState *baselines, SyncEntityState *client_entities, int num_client_entities ) {
 	SyncEntityState *oldent, *newent;
 	int oldindex, newindex;
 	int oldnum, newnum;
@@ -80,7 +478,7 @@ static void SNAP_EmitPacketEntities( ginfo_t *gi, client_snapshot_t *from, clien
 			// in any bytes being emited if the entity has not changed at all
 			// note that players are always 'newentities', this updates their oldorigin always
 			// and prevents warping ( wsw : jal : I removed it from the players )
-			MSG_WriteDeltaEntity( msg, oldent, newent, false );
+			SNAP_WriteDeltaEntity( delta_cache, frameNum, fromFrameNum, msg, oldent, newent, false );
 			oldindex++;
 			newindex++;
 			continue;
@@ -88,7 +486,7 @@ static void SNAP_EmitPacketEntities( ginfo_t *gi, client_snapshot_t *from, clien
 
 		if( newnum < oldnum ) {
 			// this is a new entity, send it from the baseline
-			MSG_WriteDeltaEntity( msg, &baselines[newnum], newent, true );
+			SNAP_WriteDeltaEntity( delta_cache, frameNum, -1, msg, &baselines[newnum], newent, true );
 			newindex++;
 			continue;
 		}
@@ -231,7 +629,7 @@ static void SNAP_WriteMultiPOVCommands( ginfo_t *gi, client_t *client, msg_t *ms
 * SNAP_WriteFrameSnapToClient
 */
 void SNAP_WriteFrameSnapToClient( ginfo_t *gi, client_t *client, msg_t *msg, int64_t frameNum, int64_t gameTime,
-								  SyncEntityState *baselines, client_entities_t *client_entities ) {
+								  SyncEntityState *baselines, client_entities_t *client_entities, SnapDeltaCache *delta_cache, size_t budget ) {
 	client_snapshot_t *frame, *oldframe;
 	int flags, i, index;
 
@@ -327,9 +725,28 @@ void SNAP_WriteFrameSnapToClient( ginfo_t *gi, client_t *client, msg_t *msg, int
 	MSG_WriteUint8( msg, 0 );
 
 	// delta encode the entities
-	SNAP_EmitPacketEntities( gi, oldframe, frame, msg, baselines, client_entities->entities, client_entities->num_entities );
+	if( budget > 0 || ( oldframe != NULL && oldframe->held_back ) ) {
+		delta_cache = NULL;
+	}
+
+	int deferred = 0;
+	if( budget > 0 && !frame->multipov && frame->numplayers > 0 ) {
+		deferred = SNAP_EmitBudgetedPacketEntities( client, oldframe, frame, msg, frameNum, client->lastframe, delta_cache,
+			baselines, client_entities->entities, client_entities->num_entities, budget );
+	} else {
+		SNAP_EmitPacketEntities( gi, oldframe, frame, msg, frameNum, client->lastframe, delta_cache,
+			baselines, client_entities->entities, client_entities->num_entities );
+	}
 
+	frame->held_back = deferred > 0;
 	client->lastSentFrameNum = frameNum;
+
+	client->lastSnapBytes = msg->cursize;
+	client->lastSnapDeferred = deferred;
+	client->snapStats.snaps++;
+	client->snapStats.bytes_total += msg->cursize;
+	client->snapStats.bytes_max = Max2( client->snapStats.bytes_max, int64_t( msg->cursize ) );
+	client->snapStats.deferred_total += deferred;
 }
 
 /*
@@ -376,13 +793,6 @@ static bool SNAP_PVSCullEntity( CollisionModel *cms, edict_t *ent, uint8_t *bits
 
 //=====================================================================
 
-#define MAX_SNAPSHOT_ENTITIES   1024
-typedef struct {
-	int numSnapshotEntities;
-	int snapshotEntities[MAX_SNAPSHOT_ENTITIES];
-	uint8_t entityAddedToSnapList[MAX_EDICTS / 8];
-} snapshotEntityNumbers_t;
-
 /*
 * SNAP_AddEntNumToSnapList
 */
@@ -603,36 +1013,46 @@ static void SNAP_BuildSnapEntitiesList( CollisionModel *cms, ginfo_t *gi, edict_
 }
 
 /*
-* SNAP_BuildClientFrameSnap
+* SNAP_ValidateSnapEntities
 *
-* Decides which entities are going to be visible to the client, and
-* copies off the playerstat and areabits.
+* Fixes up broken entity numbers up front, so culling never has to write to
+* the edicts and can run for several clients at once
 */
-void SNAP_BuildClientFrameSnap( CollisionModel *cms, ginfo_t *gi, int64_t frameNum, int64_t timeStamp,
-								client_t *client,
-								SyncGameState *gameState, client_entities_t *client_entities,
-								mempool_t *mempool ) {
-	int e, i, ne;
-	Vec3 org;
+void SNAP_ValidateSnapEntities( ginfo_t *gi ) {
+	for( int entNum = 1; entNum < gi->num_edicts; entNum++ ) {
+		edict_t *ent = EDICT_NUM( entNum );
+
+		if( ent->s.number != entNum ) {
+			Com_Printf( "FIXING ENT->S.NUMBER: %i %i!!!\n", ent->s.number, entNum );
+			ent->s.number = entNum;
+		}
+
+		if( ( ent->r.svflags & SVF_FORCEOWNER ) && ( ent->s.ownerNum <= 0 || ent->s.ownerNum >= gi->num_edicts ) ) {
+			Com_Printf( "FIXING ENT->S.OWNERNUM: %i %i!!!\n", ent->s.type, ent->s.ownerNum );
+			ent->s.ownerNum = 0;
+		}
+	}
+}
+
+/*
+* SNAP_BeginClientFrameSnap
+*
+* Sets up the frame and copies off the playerstate. Returns false if the
+* client isn't in game yet
+*/
+bool SNAP_BeginClientFrameSnap( ginfo_t *gi, int64_t frameNum, int64_t timeStamp, client_t *client,
+								CollisionModel *cms, mempool_t *mempool ) {
+	int i;
 	edict_t *ent, *clent;
 	client_snapshot_t *frame;
-	SyncEntityState *state;
 	int numplayers, numareas;
-	snapshotEntityNumbers_t entsList;
-
-	assert( gameState );
 
 	clent = client->edict;
 	if( clent && !clent->r.client ) {   // allow NULL ent for server record
-		return;     // not in game yet
-
+		return false;     // not in game yet
 	}
-	if( clent ) {
-		org = clent->s.origin;
-		org.z += clent->r.client->ps.viewheight;
-	} else {
+	if( !clent ) {
 		assert( client->mv );
-		org = Vec3( 0.0f );
 	}
 
 	// this is the frame we are creating
@@ -647,6 +1067,7 @@ void SNAP_BuildClientFrameSnap( CollisionModel *cms, ginfo_t *gi, int64_t frameN
 		frame->multipov = false;
 		frame->allentities = false;
 	}
+	frame->held_back = false;
 
 	// areaportals matrix
 	numareas = CM_NumAreas( cms );
@@ -699,23 +1120,57 @@ void SNAP_BuildClientFrameSnap( CollisionModel *cms, ginfo_t *gi, int64_t frameN
 		frame->ps[0].playerNum = NUM_FOR_EDICT( clent ) - 1;
 	}
 
-	// build up the list of visible entities
-	//=============================
-	SNAP_BuildSnapEntitiesList( cms, gi, clent, org, frame, &entsList );
+	return true;
+}
+
+/*
+* SNAP_CullClientFrameSnap
+*
+* Decides which entities are going to be visible to the client. Only writes
+* to the client's own frame and entsList, so it's safe to call from worker
+* threads once SNAP_ValidateSnapEntities has run
+*/
+void SNAP_CullClientFrameSnap( CollisionModel *cms, ginfo_t *gi, int64_t frameNum, client_t *client,
+							   snapshotEntityNumbers_t *entsList ) {
+	ZoneScoped;
+
+	edict_t *clent = client->edict;
+	client_snapshot_t *frame = &client->snapShots[frameNum & UPDATE_MASK];
+
+	Vec3 org = Vec3( 0.0f );
+	if( clent ) {
+		org = clent->s.origin;
+		org.z += clent->r.client->ps.viewheight;
+	}
+
+	SNAP_BuildSnapEntitiesList( cms, gi, clent, org, frame, entsList );
+}
+
+/*
+* SNAP_FinishClientFrameSnap
+*
+* Copies the visible entities into the circular client_entities array
+*/
+void SNAP_FinishClientFrameSnap( ginfo_t *gi, int64_t frameNum, client_t *client, SyncGameState *gameState,
+								 client_entities_t *client_entities, const snapshotEntityNumbers_t *entsList ) {
+	int e, ne;
+	edict_t *ent;
+	SyncEntityState *state;
+	client_snapshot_t *frame = &client->snapShots[frameNum & UPDATE_MASK];
+
+	assert( gameState );
 
 	// store current match state information
 	frame->gameState = *gameState;
 
-	//=============================
-
 	// dump the entities list
 	ne = client_entities->next_entities;
 	frame->num_entities = 0;
 	frame->first_entity = ne;
 
-	for( e = 0; e < entsList.numSnapshotEntities; e++ ) {
+	for( e = 0; e < entsList->numSnapshotEntities; e++ ) {
 		// add it to the circular client_entities array
-		ent = EDICT_NUM( entsList.snapshotEntities[e] );
+		ent = EDICT_NUM( entsList->snapshotEntities[e] );
 		state = &client_entities->entities[ne % client_entities->num_entities];
 
 		*state = ent->s;
@@ -733,6 +1188,26 @@ void SNAP_BuildClientFrameSnap( CollisionModel *cms, ginfo_t *gi, int64_t frameN
 	client_entities->next_entities = ne;
 }
 
+/*
+* SNAP_BuildClientFrameSnap
+*
+* Decides which entities are going to be visible to the client, and
+* copies off the playerstat and areabits.
+*/
+void SNAP_BuildClientFrameSnap( CollisionModel *cms, ginfo_t *gi, int64_t frameNum, int64_t timeStamp,
+								client_t *client,
+								SyncGameState *gameState, client_entities_t *client_entities,
+								mempool_t *mempool ) {
+	snapshotEntityNumbers_t entsList;
+
+	if( !SNAP_BeginClientFrameSnap( gi, frameNum, timeStamp, client, cms, mempool ) ) {
+		return;
+	}
+
+	SNAP_CullClientFrameSnap( cms, gi, frameNum, client, &entsList );
+	SNAP_FinishClientFrameSnap( gi, frameNum, client, gameState, client_entities, &entsList );
+}
+
 /*
 * SNAP_FreeClientFrame
 *
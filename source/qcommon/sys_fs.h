@@ -30,3 +30,5 @@ const char *Sys_FS_FindNext( unsigned musthave, unsigned canthave );
 void        Sys_FS_FindClose( void );
 
 int         Sys_FS_FileNo( FILE *fp );
+
+int64_t     Sys_FS_FileMTime( const char *filename );
@@ -31,3 +31,28 @@ void        Sys_NET_SocketClose( socket_handle_t handle );
 int         Sys_NET_SocketIoctl( socket_handle_t handle, long request, ioctl_param_t* param );
 
 int64_t     Sys_NET_SendFile( socket_handle_t handle, int fileno, size_t offset, size_t count );
+
+/*
+* A datagram for Sys_NET_RecvBatch/Sys_NET_SendBatch. addr points at a
+* struct sockaddr_storage. When receiving, length and addrlen start out as
+* the buffer sizes and come back as what was received.
+*/
+typedef struct {
+	void *data;
+	size_t length;
+	void *addr;
+	int addrlen;
+} net_datagram_t;
+
+/*
+* Sys_NET_CreatePoller returns NULL where there's no better way to wait on
+* lots of sockets than select, see NET_CreatePoller.
+*/
+net_poller_t *Sys_NET_CreatePoller( void );
+void        Sys_NET_DestroyPoller( net_poller_t *poller );
+bool        Sys_NET_PollerAdd( net_poller_t *poller, socket_handle_t handle, void *data );
+void        Sys_NET_PollerRemove( net_poller_t *poller, socket_handle_t handle );
+int         Sys_NET_PollerWait( net_poller_t *poller, int msec, net_poll_event_t *events, int count );
+
+int         Sys_NET_RecvBatch( socket_handle_t handle, net_datagram_t *datagrams, int count );
+int         Sys_NET_SendBatch( socket_handle_t handle, const net_datagram_t *datagrams, int count );
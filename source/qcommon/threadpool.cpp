@@ -0,0 +1,528 @@
+#include "qcommon/base.h"
+#include "qcommon/qcommon.h"
+#include "qcommon/threads.h"
+#include "qcommon/threadpool.h"
+
+#include <emmintrin.h>
+
+/*
+ * Each thread in the pool owns a deque of jobs. Jobs get pushed and popped at
+ * the bottom by the owner and other threads steal from the top when they run
+ * out of work, so the common case never touches a lock. The deques are
+ * Chase-Lev deques, see "Correct and Efficient Work-Stealing for Weak Memory
+ * Models" by Le et al.
+ *
+ * The thread that calls InitThreadPool is part of the pool and runs jobs
+ * while it waits. Jobs from any other thread go through a locked shared queue.
+ *
+ * When there's nothing left to run, waiting threads spin for a moment and
+ * then sleep on waiters_sem, which gets signalled whenever a counter drops to
+ * zero or more jobs get queued.
+ */
+
+struct Job {
+	JobCallback callback;
+	void * data;
+	JobCounter * counter;
+};
+
+static constexpr s64 JOB_DEQUE_SIZE = 4096;
+
+struct JobDeque {
+	alignas( 64 ) std::atomic< s64 > top;
+	alignas( 64 ) std::atomic< s64 > bottom;
+	Job jobs[ JOB_DEQUE_SIZE ];
+};
+
+struct Worker {
+	Thread * thread;
+	ArenaAllocator arena;
+	JobDeque deque;
+	u32 rng;
+};
+
+static Worker workers[ 33 ];
+static u32 num_workers; // not counting workers[ 0 ], which is the main thread
+static thread_local Worker * this_worker;
+
+static Job shared_jobs[ 4096 ];
+static Mutex * shared_jobs_mutex;
+static size_t shared_jobs_head;
+static std::atomic< size_t > shared_jobs_length;
+
+static Semaphore * jobs_sem;
+static std::atomic< u32 > num_sleeping_workers;
+
+static Semaphore * waiters_sem;
+static std::atomic< u32 > num_sleeping_waiters;
+static thread_local u32 running_jobs;
+
+static std::atomic< bool > shutting_down;
+static JobCounter all_jobs;
+
+static bool PushJob( JobDeque * deque, const Job & job ) {
+	s64 b = deque->bottom.load( std::memory_order_relaxed );
+	s64 t = deque->top.load( std::memory_order_acquire );
+	if( b - t >= JOB_DEQUE_SIZE ) {
+		return false;
+	}
+
+	deque->jobs[ b % JOB_DEQUE_SIZE ] = job;
+	std::atomic_thread_fence( std::memory_order_release );
+	deque->bottom.store( b + 1, std::memory_order_relaxed );
+
+	return true;
+}
+
+static bool PopJob( JobDeque * deque, Job * job ) {
+	s64 b = deque->bottom.load( std::memory_order_relaxed ) - 1;
+	deque->bottom.store( b, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	s64 t = deque->top.load( std::memory_order_relaxed );
+
+	if( t > b ) {
+		deque->bottom.store( b + 1, std::memory_order_relaxed );
+		return false;
+	}
+
+	*job = deque->jobs[ b % JOB_DEQUE_SIZE ];
+	if( t != b ) {
+		return true;
+	}
+
+	// last job, race the thieves for it
+	bool won = deque->top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+	deque->bottom.store( b + 1, std::memory_order_relaxed );
+	return won;
+}
+
+static bool StealJob( JobDeque * deque, Job * job ) {
+	s64 t = deque->top.load( std::memory_order_acquire );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	s64 b = deque->bottom.load( std::memory_order_acquire );
+
+	if( t >= b ) {
+		return false;
+	}
+
+	*job = deque->jobs[ t % JOB_DEQUE_SIZE ];
+	return deque->top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+}
+
+static bool PopSharedJob( Job * job ) {
+	if( shared_jobs_length.load( std::memory_order_relaxed ) == 0 ) {
+		return false;
+	}
+
+	Lock( shared_jobs_mutex );
+
+	bool found = shared_jobs_length.load( std::memory_order_relaxed ) > 0;
+	if( found ) {
+		*job = shared_jobs[ shared_jobs_head % ARRAY_COUNT( shared_jobs ) ];
+		shared_jobs_head++;
+		shared_jobs_length.fetch_sub( 1, std::memory_order_relaxed );
+	}
+
+	Unlock( shared_jobs_mutex );
+
+	return found;
+}
+
+static bool FindJob( Worker * self, Job * job ) {
+	if( PopJob( &self->deque, job ) ) {
+		return true;
+	}
+
+	if( PopSharedJob( job ) ) {
+		return true;
+	}
+
+	// xorshift32 to pick where to start stealing from
+	self->rng ^= self->rng << 13;
+	self->rng ^= self->rng >> 17;
+	self->rng ^= self->rng << 5;
+
+	u32 n = num_workers + 1;
+	u32 start = self->rng % n;
+	for( u32 i = 0; i < n; i++ ) {
+		Worker * victim = &workers[ ( start + i ) % n ];
+		if( victim != self && StealJob( &victim->deque, job ) ) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void WakeWaiters() {
+	// pairs with the fetch_add in ThreadPoolWait, so either we see the
+	// waiter going to sleep or it sees the counter hit zero
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+
+	// they're probably not all waiting on this counter, but the ones that
+	// aren't check and go back to sleep
+	u32 sleeping = num_sleeping_waiters.load( std::memory_order_relaxed );
+	if( sleeping > 0 ) {
+		Signal( waiters_sem, checked_cast< int >( sleeping ) );
+	}
+}
+
+static void RunJob( Worker * self, const Job & job ) {
+	running_jobs++;
+	{
+		TempAllocator temp = self->arena.temp();
+		job.callback( &temp, job.data );
+	}
+	running_jobs--;
+
+	bool finished_counter = false;
+	if( job.counter != NULL ) {
+		finished_counter = job.counter->pending.fetch_sub( 1, std::memory_order_release ) == 1;
+	}
+	finished_counter = all_jobs.pending.fetch_sub( 1, std::memory_order_release ) == 1 || finished_counter;
+
+	if( finished_counter ) {
+		WakeWaiters();
+	}
+}
+
+static void QueueJob( const Job & job ) {
+	if( job.counter != NULL ) {
+		job.counter->pending.fetch_add( 1, std::memory_order_relaxed );
+	}
+	all_jobs.pending.fetch_add( 1, std::memory_order_relaxed );
+
+	Worker * self = this_worker;
+	if( self != NULL ) {
+		if( !PushJob( &self->deque, job ) ) {
+			RunJob( self, job );
+		}
+		return;
+	}
+
+	Lock( shared_jobs_mutex );
+
+	size_t length = shared_jobs_length.load( std::memory_order_relaxed );
+	assert( length < ARRAY_COUNT( shared_jobs ) );
+	shared_jobs[ ( shared_jobs_head + length ) % ARRAY_COUNT( shared_jobs ) ] = job;
+	shared_jobs_length.store( length + 1, std::memory_order_relaxed );
+
+	Unlock( shared_jobs_mutex );
+}
+
+static void WakeWorkers( u32 n ) {
+	// pairs with the fetch_adds in ThreadPoolWorker and ThreadPoolWait, so
+	// either we see the thread going to sleep or it sees our job
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+
+	u32 sleeping = num_sleeping_workers.load( std::memory_order_relaxed );
+	if( sleeping > 0 ) {
+		Signal( jobs_sem, checked_cast< int >( Min2( n, sleeping ) ) );
+	}
+
+	// threads sleeping in ThreadPoolWait can help out too
+	u32 waiting = num_sleeping_waiters.load( std::memory_order_relaxed );
+	if( waiting > 0 ) {
+		Signal( waiters_sem, checked_cast< int >( Min2( n, waiting ) ) );
+	}
+}
+
+static void ThreadPoolWorker( void * data ) {
+#if TRACY_ENABLE
+	tracy::SetThreadName( "Thread pool worker" );
+#endif
+
+	Worker * self = ( Worker * ) data;
+	this_worker = self;
+
+	while( true ) {
+		Job job;
+		if( FindJob( self, &job ) ) {
+			RunJob( self, job );
+			continue;
+		}
+
+		num_sleeping_workers.fetch_add( 1, std::memory_order_seq_cst );
+
+		// check again in case a job was queued before we said we were sleeping
+		bool found = FindJob( self, &job );
+		if( !found && !shutting_down.load( std::memory_order_acquire ) ) {
+			Wait( jobs_sem );
+		}
+
+		num_sleeping_workers.fetch_sub( 1, std::memory_order_relaxed );
+
+		if( found ) {
+			RunJob( self, job );
+		}
+		else if( shutting_down.load( std::memory_order_acquire ) ) {
+			break;
+		}
+	}
+}
+
+void InitThreadPool() {
+	ZoneScoped;
+
+	shutting_down.store( false );
+	num_sleeping_workers.store( 0 );
+	num_sleeping_waiters.store( 0 );
+	all_jobs.pending.store( 0 );
+	shared_jobs_head = 0;
+	shared_jobs_length.store( 0 );
+	shared_jobs_mutex = NewMutex();
+	jobs_sem = NewSemaphore();
+	waiters_sem = NewSemaphore();
+
+	// always have at least one worker so threads outside the pool can wait on jobs
+	num_workers = Clamp( u32( 1 ), GetCoreCount() - 1, u32( ARRAY_COUNT( workers ) - 1 ) );
+
+	constexpr size_t arena_size = 1024 * 1024; // 1MB
+	for( u32 i = 0; i <= num_workers; i++ ) {
+		Worker * worker = &workers[ i ];
+		worker->deque.top.store( 0 );
+		worker->deque.bottom.store( 0 );
+		worker->rng = i + 1;
+
+		void * arena_memory = ALLOC_SIZE( sys_allocator, arena_size, 16 );
+		worker->arena = ArenaAllocator( arena_memory, arena_size );
+	}
+
+	this_worker = &workers[ 0 ];
+
+	for( u32 i = 1; i <= num_workers; i++ ) {
+		workers[ i ].thread = NewThread( ThreadPoolWorker, &workers[ i ] );
+	}
+}
+
+void ShutdownThreadPool() {
+	ZoneScoped;
+
+	shutting_down.store( true, std::memory_order_seq_cst );
+	Signal( jobs_sem, checked_cast< int >( num_workers ) );
+
+	for( u32 i = 1; i <= num_workers; i++ ) {
+		JoinThread( workers[ i ].thread );
+	}
+
+	for( u32 i = 0; i <= num_workers; i++ ) {
+		FREE( sys_allocator, workers[ i ].arena.get_memory() );
+	}
+
+	this_worker = NULL;
+
+	DeleteSemaphore( waiters_sem );
+	DeleteSemaphore( jobs_sem );
+	DeleteMutex( shared_jobs_mutex );
+}
+
+void ThreadPoolDo( JobCallback callback, void * data, JobCounter * counter ) {
+	ZoneScoped;
+
+	Job job;
+	job.callback = callback;
+	job.data = data;
+	job.counter = counter;
+
+	QueueJob( job );
+	WakeWorkers( 1 );
+}
+
+/*
+ * ThreadPoolWait
+ *
+ * Runs jobs until everything queued against counter has finished. Once there
+ * are none left to run, or from threads outside the pool, which can't run
+ * jobs, it spins for a bit in case the rest are nearly done and then sleeps
+ * until a counter finishes
+ */
+void ThreadPoolWait( JobCounter * counter ) {
+	ZoneScoped;
+
+	constexpr u32 spin_iterations = 256;
+
+	Worker * self = this_worker;
+	u32 spins = 0;
+
+	while( counter->pending.load( std::memory_order_acquire ) != 0 ) {
+		Job job;
+		if( self != NULL && FindJob( self, &job ) ) {
+			RunJob( self, job );
+			spins = 0;
+			continue;
+		}
+
+		// the remaining jobs are running on other threads
+		if( spins < spin_iterations ) {
+			_mm_pause();
+			spins++;
+			continue;
+		}
+
+		num_sleeping_waiters.fetch_add( 1, std::memory_order_seq_cst );
+
+		// check again in case the counter finished before we said we were
+		// sleeping. don't sleep if there are jobs we could be running
+		// either, they could be the ones we're waiting on
+		bool done = counter->pending.load( std::memory_order_acquire ) == 0;
+		bool found = !done && self != NULL && FindJob( self, &job );
+		if( !done && !found ) {
+			Wait( waiters_sem );
+		}
+
+		num_sleeping_waiters.fetch_sub( 1, std::memory_order_relaxed );
+
+		if( found ) {
+			RunJob( self, job );
+		}
+		spins = 0;
+	}
+}
+
+/*
+ * ThreadPoolFinish
+ *
+ * Waits for every job to finish, so it can't be called from a job, which
+ * would be waiting on itself
+ */
+void ThreadPoolFinish() {
+	assert( running_jobs == 0 );
+	ThreadPoolWait( &all_jobs );
+}
+
+struct ParallelForChunk {
+	JobCallback callback;
+	char * datum;
+	size_t stride;
+	size_t begin, end;
+};
+
+static void ParallelForChunkJob( TempAllocator * temp, void * data ) {
+	const ParallelForChunk * chunk = ( const ParallelForChunk * ) data;
+	for( size_t i = chunk->begin; i < chunk->end; i++ ) {
+		TempAllocator item_temp = this_worker->arena.temp();
+		chunk->callback( &item_temp, chunk->datum + chunk->stride * i );
+	}
+}
+
+/*
+ * ParallelFor
+ *
+ * Splits the items into a few chunks per thread, which keeps the per-job
+ * overhead down while leaving enough chunks to even out the load
+ */
+void ParallelFor( void * datum, size_t n, size_t stride, JobCallback callback ) {
+	ZoneScoped;
+
+	if( n == 0 ) {
+		return;
+	}
+
+	constexpr size_t chunks_per_thread = 4;
+	ParallelForChunk chunks[ ARRAY_COUNT( workers ) * chunks_per_thread ];
+	size_t num_chunks = Min2( n, size_t( num_workers + 1 ) * chunks_per_thread );
+
+	JobCounter counter;
+	for( size_t i = 0; i < num_chunks; i++ ) {
+		ParallelForChunk * chunk = &chunks[ i ];
+		chunk->callback = callback;
+		chunk->datum = ( char * ) datum;
+		chunk->stride = stride;
+		chunk->begin = n * i / num_chunks;
+		chunk->end = n * ( i + 1 ) / num_chunks;
+
+		Job job;
+		job.callback = ParallelForChunkJob;
+		job.data = chunk;
+		job.counter = &counter;
+		QueueJob( job );
+	}
+
+	WakeWorkers( checked_cast< u32 >( num_chunks ) );
+
+	ThreadPoolWait( &counter );
+}
+
+/*
+ * ThreadPoolBenchmark_f
+ *
+ * Usage: jobbench [iterations]
+ * Times lots of tiny jobs through ThreadPoolDo and ParallelFor, where the
+ * scheduling overhead dominates, and a few big ones where it shouldn't
+ */
+
+struct BenchmarkJob {
+	u64 x;
+	u32 work;
+};
+
+static void BenchmarkJobCallback( TempAllocator * temp, void * data ) {
+	BenchmarkJob * job = ( BenchmarkJob * ) data;
+	for( u32 i = 0; i < job->work; i++ ) {
+		job->x = Hash64( job->x );
+	}
+}
+
+static void BenchmarkThreadPoolDo( Span< BenchmarkJob > jobs, int iterations ) {
+	for( int i = 0; i < iterations; i++ ) {
+		for( BenchmarkJob & job : jobs ) {
+			ThreadPoolDo( BenchmarkJobCallback, &job );
+		}
+		ThreadPoolFinish();
+	}
+}
+
+static void BenchmarkParallelFor( Span< BenchmarkJob > jobs, int iterations ) {
+	for( int i = 0; i < iterations; i++ ) {
+		ParallelFor( jobs, BenchmarkJobCallback );
+	}
+}
+
+static void BenchmarkSerial( Span< BenchmarkJob > jobs, int iterations ) {
+	for( int i = 0; i < iterations; i++ ) {
+		for( BenchmarkJob & job : jobs ) {
+			BenchmarkJobCallback( NULL, &job );
+		}
+	}
+}
+
+void ThreadPoolBenchmark_f() {
+	int iterations = Cmd_Argc() > 1 ? Max2( 1, atoi( Cmd_Argv( 1 ) ) ) : 100;
+
+	constexpr size_t num_jobs = 4000;
+	BenchmarkJob * jobs = ALLOC_MANY( sys_allocator, BenchmarkJob, num_jobs );
+
+	struct {
+		const char * name;
+		void ( *f )( Span< BenchmarkJob > jobs, int iterations );
+		size_t n;
+		u32 work;
+	} tests[] = {
+		{ "serial, tiny jobs", BenchmarkSerial, num_jobs, 16 },
+		{ "ThreadPoolDo, tiny jobs", BenchmarkThreadPoolDo, num_jobs, 16 },
+		{ "ParallelFor, tiny jobs", BenchmarkParallelFor, num_jobs, 16 },
+		{ "serial, big jobs", BenchmarkSerial, 64, 100000 },
+		{ "ThreadPoolDo, big jobs", BenchmarkThreadPoolDo, 64, 100000 },
+		{ "ParallelFor, big jobs", BenchmarkParallelFor, 64, 100000 },
+	};
+
+	Com_Printf( "%u workers, %d iterations\n", num_workers, iterations );
+
+	for( const auto & test : tests ) {
+		for( size_t i = 0; i < test.n; i++ ) {
+			jobs[ i ].x = i;
+			jobs[ i ].work = test.work;
+		}
+
+		int test_iterations = test.work > 1000 ? Max2( 1, iterations / 10 ) : iterations;
+
+		u64 start = Sys_Microseconds();
+		test.f( Span< BenchmarkJob >( jobs, test.n ), test_iterations );
+		u64 dt = Max2( u64( 1 ), Sys_Microseconds() - start );
+
+		double jobs_per_second = double( test.n ) * test_iterations / ( dt / 1000000.0 );
+		Com_Printf( "%-24s %8.2fms %12.0f jobs/s\n", test.name, dt / 1000.0, jobs_per_second );
+	}
+
+	FREE( sys_allocator, jobs );
+}
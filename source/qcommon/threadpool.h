@@ -2,15 +2,28 @@
 
 #include "qcommon/types.h"
 
+#include <atomic>
+
 typedef void ( *JobCallback )( TempAllocator * temp, void * data );
 
+// counts outstanding jobs so you can wait on a group of them. jobs can wait on
+// each other's counters to express dependencies
+struct JobCounter {
+	std::atomic< u32 > pending;
+
+	JobCounter() : pending( 0 ) { }
+};
+
 void InitThreadPool();
 void ShutdownThreadPool();
 
-void ThreadPoolDo( JobCallback callback, void * data = NULL );
+void ThreadPoolDo( JobCallback callback, void * data = NULL, JobCounter * counter = NULL );
+void ThreadPoolWait( JobCounter * counter );
 void ParallelFor( void * datum, size_t n, size_t stride, JobCallback callback );
 void ThreadPoolFinish();
 
+void ThreadPoolBenchmark_f();
+
 template< typename T >
 void ParallelFor( Span< T > datum, JobCallback callback ) {
 	ParallelFor( datum.ptr, datum.n, sizeof( T ), callback );
@@ -74,6 +74,7 @@ typedef struct {
 typedef struct {
 	bool allentities;
 	bool multipov;
+	bool held_back;                     // entities were held back by the snapshot budget, see SNAP_EmitBudgetedPacketEntities
 	int numareas;
 	uint8_t *areabits;                  // portalarea visibility bits
 	int numplayers;
@@ -157,6 +158,21 @@ typedef struct client_s {
 	int mm_session;
 	unsigned int mm_ticket;
 	char mm_login[MAX_INFO_VALUE];
+
+	// bytes per snapshot, from the snapbudget userinfo key. 0 means no
+	// limit other than sv_snapBudget
+	int snapBudget;
+	uint8_t snapDeferred[MAX_EDICTS];   // snapshots in a row each entity has been left out of
+
+	// see the snapstats command
+	int lastSnapBytes;
+	int lastSnapDeferred;
+	struct {
+		int64_t snaps;
+		int64_t bytes_total;
+		int64_t bytes_max;
+		int64_t deferred_total;
+	} snapStats;
 } client_t;
 
 // a client can leave the server in one of four ways:
@@ -218,12 +234,24 @@ typedef struct {
 
 	client_t *clients;                  // [sv_maxclients->integer];
 	client_entities_t client_entities;
+	uint8_t *snap_messages;             // [sv_maxclients->integer * MAX_MSGLEN], see sv_parallelSnapshots
+	SnapDeltaCache *delta_cache;
 
 	challenge_t challenges[MAX_CHALLENGES]; // to prevent invalid IPs from connecting
 
 	server_static_demo_t demo;
 
 	CollisionModel *cms;                // passed to CM-functions
+
+	// how late frames ran compared to when they were due, see the frametimes command
+	struct {
+		int64_t game_frames;
+		int64_t game_late_total;
+		int64_t game_late_max;
+		int64_t snaps;
+		int64_t snap_late_total;
+		int64_t snap_late_max;
+	} jitter;
 } server_static_t;
 
 typedef struct {
@@ -273,6 +301,10 @@ extern cvar_t *sv_public;         // should heartbeats be sent
 // wsw : debug netcode
 extern cvar_t *sv_debug_serverCmd;
 
+extern cvar_t *sv_parallelSnapshots;
+extern cvar_t *sv_snapDeltaCache;
+extern cvar_t *sv_snapBudget;
+
 extern cvar_t *sv_uploads_http;
 extern cvar_t *sv_uploads_baseurl;
 extern cvar_t *sv_uploads_demos;
@@ -359,6 +391,7 @@ void SV_DropClient( client_t *drop, int type, _Printf_format_string_ const char
 #endif
 
 void SV_ExecuteClientThinks( int clientNum );
+int SV_PendingClientThinks( int clientNum, usercmd_t *cmds, int maxcmds );
 void SV_ClientResetCommandBuffers( client_t *client );
 void SV_ClientCloseDownload( client_t *client );
 
@@ -370,6 +403,7 @@ void SV_Status_f( void );
 //
 // sv_ents.c
 //
+size_t SV_SnapBudget( const client_t *client );
 void SV_WriteFrameSnapToClient( client_t *client, msg_t *msg );
 void SV_BuildClientFrameSnap( client_t *client );
 
@@ -413,3 +447,4 @@ bool SV_Web_Running( void );
 const char *SV_Web_UpstreamBaseUrl( void );
 bool SV_Web_AddGameClient( const char *session, int clientNum, const netadr_t *netAdr );
 void SV_Web_RemoveGameClient( const char *session );
+void SV_Web_LoadTest( const char *path, int num_connections, int requests );
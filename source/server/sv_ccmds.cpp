@@ -19,6 +19,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 
 #include "server.h"
+#include "qcommon/cmodel.h"
 
 
 //===============================================================================
@@ -176,6 +177,134 @@ void SV_Status_f( void ) {
 	Com_Printf( "\n" );
 }
 
+/*
+* SV_FrameTimes_f
+*
+* Prints how late game frames and snapshots ran since the last call
+*/
+static void SV_FrameTimes_f( void ) {
+	if( !svs.initialized ) {
+		Com_Printf( "No server running.\n" );
+		return;
+	}
+
+	if( svs.jitter.game_frames > 0 ) {
+		Com_Printf( "game frames: %" PRIi64 ", avg late %.2fms, max late %" PRIi64 "ms\n", svs.jitter.game_frames,
+			svs.jitter.game_late_total / double( svs.jitter.game_frames ), svs.jitter.game_late_max );
+	}
+
+	if( svs.jitter.snaps > 0 ) {
+		Com_Printf( "snapshots: %" PRIi64 ", avg late %.2fms, max late %" PRIi64 "ms\n", svs.jitter.snaps,
+			svs.jitter.snap_late_total / double( svs.jitter.snaps ), svs.jitter.snap_late_max );
+	}
+
+	memset( &svs.jitter, 0, sizeof( svs.jitter ) );
+}
+
+/*
+* SV_SnapStats_f
+*
+* Prints how big each client's snapshots were and how many entities
+* sv_snapBudget held back since the last call
+*/
+static void SV_SnapStats_f( void ) {
+	int i;
+	client_t *cl;
+
+	if( !svs.clients ) {
+		Com_Printf( "No server running.\n" );
+		return;
+	}
+
+	Com_Printf( "num budget  avg bytes max bytes avg deferred name\n" );
+	Com_Printf( "--- ------ ---------- --------- ------------ -------------------------------\n" );
+	for( i = 0, cl = svs.clients; i < sv_maxclients->integer; i++, cl++ ) {
+		if( cl->state != CS_SPAWNED || cl->snapStats.snaps == 0 ) {
+			continue;
+		}
+
+		Com_Printf( "%3i %6i %10.1f %9" PRIi64 " %12.2f %s\n", i, (int)SV_SnapBudget( cl ),
+			cl->snapStats.bytes_total / double( cl->snapStats.snaps ), cl->snapStats.bytes_max,
+			cl->snapStats.deferred_total / double( cl->snapStats.snaps ), cl->name );
+
+		memset( &cl->snapStats, 0, sizeof( cl->snapStats ) );
+	}
+	Com_Printf( "\n" );
+}
+
+/*
+* SV_TraceStressTest_f
+*
+* Usage: tracestress [traces] [iterations]
+* Checks traces from the thread pool give the same results as serial ones
+*/
+static void SV_TraceStressTest_f( void ) {
+	if( svs.cms == NULL ) {
+		Com_Printf( "No map loaded\n" );
+		return;
+	}
+
+	int num_traces = Cmd_Argc() > 1 ? Max2( 1, atoi( Cmd_Argv( 1 ) ) ) : 100000;
+	int iterations = Cmd_Argc() > 2 ? Max2( 1, atoi( Cmd_Argv( 2 ) ) ) : 10;
+
+	CM_TraceStressTest( CM_Server, svs.cms, num_traces, iterations );
+}
+
+/*
+* SV_BrushKernelBenchmark_f
+*
+* Usage: brushbench [tests] [iterations]
+* Times the SIMD brush clipping kernels against the scalar ones on the current
+* map and checks they agree exactly
+*/
+static void SV_BrushKernelBenchmark_f( void ) {
+	if( svs.cms == NULL ) {
+		Com_Printf( "No map loaded\n" );
+		return;
+	}
+
+	int num_tests = Cmd_Argc() > 1 ? Max2( 1, atoi( Cmd_Argv( 1 ) ) ) : 1000000;
+	int iterations = Cmd_Argc() > 2 ? Max2( 1, atoi( Cmd_Argv( 2 ) ) ) : 5;
+
+	CM_BrushKernelBenchmark( svs.cms, num_tests, iterations );
+}
+
+/*
+* SV_BVHBenchmark_f
+*
+* Usage: bvhbench [traces]
+* Times world traces through the BSP against the BVH on the current map
+*/
+static void SV_BVHBenchmark_f( void ) {
+	if( svs.cms == NULL ) {
+		Com_Printf( "No map loaded\n" );
+		return;
+	}
+
+	int num_traces = Cmd_Argc() > 1 ? Max2( 1, atoi( Cmd_Argv( 1 ) ) ) : 100000;
+
+	CM_BVHBenchmark( CM_Server, svs.cms, num_traces );
+}
+
+/*
+* SV_WebLoadTest_f
+*
+* Usage: webloadtest <file> [connections] [requests]
+* Downloads file from our web server over lots of connections at once, file
+* is relative to the base directory like the URLs clients download from
+*/
+static void SV_WebLoadTest_f( void ) {
+	if( Cmd_Argc() < 2 ) {
+		Com_Printf( "Usage: webloadtest <file> [connections] [requests]\n" );
+		return;
+	}
+
+	int num_connections = Cmd_Argc() > 2 ? Max2( 1, atoi( Cmd_Argv( 2 ) ) ) : 200;
+	int requests = Cmd_Argc() > 3 ? Max2( 1, atoi( Cmd_Argv( 3 ) ) ) : 10;
+
+	SV_Web_LoadTest( Cmd_Argv( 1 ), num_connections, requests );
+}
+
 /*
 * SV_Heartbeat_f
 */
@@ -233,6 +362,12 @@ static void SV_KillServer_f( void ) {
 void SV_InitOperatorCommands( void ) {
 	Cmd_AddCommand( "heartbeat", SV_Heartbeat_f );
 	Cmd_AddCommand( "status", SV_Status_f );
+	Cmd_AddCommand( "frametimes", SV_FrameTimes_f );
+	Cmd_AddCommand( "snapstats", SV_SnapStats_f );
+	Cmd_AddCommand( "tracestress", SV_TraceStressTest_f );
+	Cmd_AddCommand( "brushbench", SV_BrushKernelBenchmark_f );
+	Cmd_AddCommand( "bvhbench", SV_BVHBenchmark_f );
+	Cmd_AddCommand( "webloadtest", SV_WebLoadTest_f );
 	Cmd_AddCommand( "serverinfo", SV_Serverinfo_f );
 	Cmd_AddCommand( "dumpuser", SV_DumpUser_f );
 
@@ -257,6 +392,12 @@ void SV_InitOperatorCommands( void ) {
 void SV_ShutdownOperatorCommands( void ) {
 	Cmd_RemoveCommand( "heartbeat" );
 	Cmd_RemoveCommand( "status" );
+	Cmd_RemoveCommand( "frametimes" );
+	Cmd_RemoveCommand( "snapstats" );
+	Cmd_RemoveCommand( "tracestress" );
+	Cmd_RemoveCommand( "brushbench" );
+	Cmd_RemoveCommand( "bvhbench" );
+	Cmd_RemoveCommand( "webloadtest" );
 	Cmd_RemoveCommand( "serverinfo" );
 	Cmd_RemoveCommand( "dumpuser" );
 
@@ -738,8 +738,9 @@ USER CMD EXECUTION
 
 /*
 * SV_FindNextUserCommand - Returns the next valid usercmd_t in execution list
+* after ucmdTime
 */
-usercmd_t *SV_FindNextUserCommand( client_t *client ) {
+static usercmd_t *SV_FindNextUserCommand( client_t *client, int64_t ucmdTime ) {
 	usercmd_t *ucmd;
 	int64_t higherTime = 0;
 	unsigned int i;
@@ -749,7 +750,7 @@ usercmd_t *SV_FindNextUserCommand( client_t *client ) {
 	if( client ) {
 		for( i = client->UcmdExecuted + 1; i <= client->UcmdReceived; i++ ) {
 			// skip backups if already executed
-			if( client->UcmdTime >= client->ucmds[i & CMD_MASK].serverTimeStamp ) {
+			if( ucmdTime >= client->ucmds[i & CMD_MASK].serverTimeStamp ) {
 				continue;
 			}
 
@@ -763,39 +764,49 @@ usercmd_t *SV_FindNextUserCommand( client_t *client ) {
 	return ucmd;
 }
 
-/*
-* SV_ExecuteClientThinks - Execute all pending usercmd_t
-*/
-void SV_ExecuteClientThinks( int clientNum ) {
-	unsigned int msec;
-	int64_t minUcmdTime;
-	int timeDelta;
-	client_t *client;
-	usercmd_t *ucmd;
-
+static client_t *SV_ThinkingClient( int clientNum ) {
 	if( clientNum >= sv_maxclients->integer || clientNum < 0 ) {
-		return;
+		return NULL;
 	}
 
-	client = svs.clients + clientNum;
+	client_t *client = svs.clients + clientNum;
 	if( client->state < CS_SPAWNED ) {
-		return;
+		return NULL;
 	}
 
 	if( client->edict->r.svflags & SVF_FAKECLIENT ) {
-		return;
+		return NULL;
 	}
 
-	// don't let client command time delay too far away in the past
-	minUcmdTime = ( svs.gametime > 999 ) ? ( svs.gametime - 999 ) : 0;
-	if( client->UcmdTime < minUcmdTime ) {
-		client->UcmdTime = minUcmdTime;
+	return client;
+}
+
+// don't let client command time delay too far away in the past
+static int64_t SV_FirstUcmdTime( const client_t *client ) {
+	int64_t minUcmdTime = ( svs.gametime > 999 ) ? ( svs.gametime - 999 ) : 0;
+	return Max2( client->UcmdTime, minUcmdTime );
+}
+
+static unsigned int SV_UcmdMsec( const usercmd_t *ucmd, int64_t ucmdTime ) {
+	return Clamp( int64_t( 1 ), ucmd->serverTimeStamp - ucmdTime, int64_t( 200 ) );
+}
+
+/*
+* SV_ExecuteClientThinks - Execute all pending usercmd_t
+*/
+void SV_ExecuteClientThinks( int clientNum ) {
+	usercmd_t *ucmd;
+
+	client_t *client = SV_ThinkingClient( clientNum );
+	if( client == NULL ) {
+		return;
 	}
 
-	while( ( ucmd = SV_FindNextUserCommand( client ) ) != NULL ) {
-		msec = Clamp( int64_t( 1 ), ucmd->serverTimeStamp - client->UcmdTime, int64_t( 200 ) );
-		ucmd->msec = msec;
-		timeDelta = 0;
+	client->UcmdTime = SV_FirstUcmdTime( client );
+
+	while( ( ucmd = SV_FindNextUserCommand( client, client->UcmdTime ) ) != NULL ) {
+		ucmd->msec = SV_UcmdMsec( ucmd, client->UcmdTime );
+		int timeDelta = 0;
 		if( client->lastframe > 0 ) {
 			timeDelta = -(int)( svs.gametime - ucmd->serverTimeStamp );
 		}
@@ -809,6 +820,37 @@ void SV_ExecuteClientThinks( int clientNum ) {
 	client->UcmdExecuted = client->UcmdReceived;
 }
 
+/*
+* SV_PendingClientThinks
+*
+* Copies out the usercmds SV_ExecuteClientThinks would run right now, in
+* order and with msec filled in, without consuming them, so the game can
+* work on them ahead of time. Returns how many there are, which can be more
+* than maxcmds
+*/
+int SV_PendingClientThinks( int clientNum, usercmd_t *cmds, int maxcmds ) {
+	client_t *client = SV_ThinkingClient( clientNum );
+	if( client == NULL ) {
+		return 0;
+	}
+
+	int64_t ucmdTime = SV_FirstUcmdTime( client );
+	int num = 0;
+
+	const usercmd_t *ucmd;
+	while( ( ucmd = SV_FindNextUserCommand( client, ucmdTime ) ) != NULL ) {
+		if( num < maxcmds ) {
+			cmds[ num ] = *ucmd;
+			cmds[ num ].msec = SV_UcmdMsec( ucmd, ucmdTime );
+		}
+		num++;
+
+		ucmdTime = ucmd->serverTimeStamp;
+	}
+
+	return num;
+}
+
 /*
 * SV_ParseMoveCommand
 */
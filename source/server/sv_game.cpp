@@ -203,6 +203,7 @@ void SV_InitGameProgs( void ) {
 	import.DropClient = PF_DropClient;
 	import.GetClientState = PF_GetClientState;
 	import.ExecuteClientThinks = SV_ExecuteClientThinks;
+	import.PendingClientThinks = SV_PendingClientThinks;
 
 	import.LocateEntities = SV_LocateEntities;
 
@@ -148,6 +148,8 @@ void SV_InitGame( void ) {
 	svs.clients = ( client_t * ) Mem_Alloc( sv_mempool, sizeof( client_t ) * sv_maxclients->integer );
 	svs.client_entities.num_entities = sv_maxclients->integer * UPDATE_BACKUP * MAX_SNAP_ENTITIES;
 	svs.client_entities.entities = ( SyncEntityState * ) Mem_Alloc( sv_mempool, sizeof( SyncEntityState ) * svs.client_entities.num_entities );
+	svs.snap_messages = ( uint8_t * ) Mem_Alloc( sv_mempool, MAX_MSGLEN * sv_maxclients->integer );
+	svs.delta_cache = SNAP_NewDeltaCache();
 
 	// init network stuff
 
@@ -268,6 +270,14 @@ void SV_ShutdownGame( const char *finalmsg, bool reconnect ) {
 		memset( &svs.client_entities, 0, sizeof( svs.client_entities ) );
 	}
 
+	if( svs.snap_messages ) {
+		Mem_Free( svs.snap_messages );
+		svs.snap_messages = NULL;
+	}
+
+	SNAP_DeleteDeltaCache( svs.delta_cache );
+	svs.delta_cache = NULL;
+
 	if( svs.cms ) {
 		CM_Free( CM_Server, svs.cms );
 		svs.cms = NULL;
@@ -73,6 +73,10 @@ cvar_t *sv_masterservers;
 // wsw : debug netcode
 cvar_t *sv_debug_serverCmd;
 
+cvar_t *sv_parallelSnapshots;
+cvar_t *sv_snapDeltaCache;
+cvar_t *sv_snapBudget;
+
 cvar_t *sv_demodir;
 
 //============================================================================
@@ -138,7 +142,7 @@ static bool SV_ProcessPacket( netchan_t *netchan, msg_t *msg ) {
 	MSG_ReadInt32( msg ); // sequence_ack
 	MSG_ReadInt16( msg ); // game_port
 	if( msg->compressed ) {
-		zerror = Netchan_DecompressMessage( msg );
+		zerror = Netchan_DecompressMessage( msg, netchan->compression );
 		if( zerror < 0 ) {
 			// compression error. Drop the packet
 			Com_DPrintf( "SV_ProcessPacket: Compression error %i. Dropping packet\n", zerror );
@@ -149,20 +153,76 @@ static bool SV_ProcessPacket( netchan_t *netchan, msg_t *msg ) {
 	return true;
 }
 
+/*
+* SV_ProcessSocketPacket
+*
+* Figures out who a packet from one of the shared sockets is from
+*/
+static void SV_ProcessSocketPacket( const socket_t *socket, const netadr_t *address, msg_t *msg ) {
+	int i;
+	client_t *cl;
+	int game_port;
+
+	// check for connectionless packet (0xffffffff) first
+	if( *(int *)msg->data == -1 ) {
+		SV_ConnectionlessPacket( socket, address, msg );
+		return;
+	}
+
+	// read the game port out of the message so we can fix up
+	// stupid address translating routers
+	MSG_BeginReading( msg );
+	MSG_ReadInt32( msg ); // sequence number
+	MSG_ReadInt32( msg ); // sequence number
+	game_port = MSG_ReadInt16( msg ) & 0xffff;
+	// data follows
+
+	// check for packets from connected clients
+	for( i = 0, cl = svs.clients; i < sv_maxclients->integer; i++, cl++ ) {
+		unsigned short addr_port;
+
+		if( cl->state == CS_FREE || cl->state == CS_ZOMBIE ) {
+			continue;
+		}
+		if( cl->edict && ( cl->edict->r.svflags & SVF_FAKECLIENT ) ) {
+			continue;
+		}
+		if( !NET_CompareBaseAddress( address, &cl->netchan.remoteAddress ) ) {
+			continue;
+		}
+		if( cl->netchan.game_port != game_port ) {
+			continue;
+		}
+
+		addr_port = NET_GetAddressPort( address );
+		if( NET_GetAddressPort( &cl->netchan.remoteAddress ) != addr_port ) {
+			Com_Printf( "SV_ReadPackets: fixing up a translated port\n" );
+			NET_SetAddressPort( &cl->netchan.remoteAddress, addr_port );
+		}
+
+		if( SV_ProcessPacket( &cl->netchan, msg ) ) { // this is a valid, sequenced packet, so process it
+			cl->lastPacketReceivedTime = svs.realtime;
+			SV_ParseClientMessage( cl, msg );
+		}
+		break;
+	}
+}
+
 /*
 * SV_ReadPackets
+*
+* Drains the shared sockets a batch of packets at a time
 */
 static void SV_ReadPackets( void ) {
 	ZoneScoped;
 
 	int i, ret;
 	client_t *cl;
-	int game_port;
 	socket_t *socket;
-	netadr_t address;
 
-	static msg_t msg;
-	static uint8_t msgData[MAX_MSGLEN];
+	static msg_t msgs[NET_MAX_BATCH];
+	static uint8_t msgData[NET_MAX_BATCH][MAX_MSGLEN];
+	static netadr_t addresses[NET_MAX_BATCH];
 
 	socket_t* sockets [] =
 	{
@@ -171,7 +231,9 @@ static void SV_ReadPackets( void ) {
 		&svs.socket_udp6,
 	};
 
-	MSG_Init( &msg, msgData, sizeof( msgData ) );
+	for( i = 0; i < NET_MAX_BATCH; i++ ) {
+		MSG_Init( &msgs[i], msgData[i], sizeof( msgData[i] ) );
+	}
 
 	for( size_t socketind = 0; socketind < ARRAY_COUNT( sockets ); socketind++ ) {
 		socket = sockets[socketind];
@@ -180,53 +242,21 @@ static void SV_ReadPackets( void ) {
 			continue;
 		}
 
-		while( ( ret = NET_GetPacket( socket, &address, &msg ) ) != 0 ) {
+		while( ( ret = NET_GetPackets( socket, addresses, msgs, NET_MAX_BATCH ) ) != 0 ) {
 			if( ret == -1 ) {
-				Com_Printf( "NET_GetPacket: Error: %s\n", NET_ErrorString() );
-				continue;
-			}
-
-			// check for connectionless packet (0xffffffff) first
-			if( *(int *)msg.data == -1 ) {
-				SV_ConnectionlessPacket( socket, &address, &msg );
+				Com_Printf( "NET_GetPackets: Error: %s\n", NET_ErrorString() );
 				continue;
 			}
 
-			// read the game port out of the message so we can fix up
-			// stupid address translating routers
-			MSG_BeginReading( &msg );
-			MSG_ReadInt32( &msg ); // sequence number
-			MSG_ReadInt32( &msg ); // sequence number
-			game_port = MSG_ReadInt16( &msg ) & 0xffff;
-			// data follows
-
-			// check for packets from connected clients
-			for( i = 0, cl = svs.clients; i < sv_maxclients->integer; i++, cl++ ) {
-				unsigned short addr_port;
-
-				if( cl->state == CS_FREE || cl->state == CS_ZOMBIE ) {
+			for( i = 0; i < ret; i++ ) {
+				if( msgs[i].cursize == 0 ) {
 					continue;
 				}
-				if( cl->edict && ( cl->edict->r.svflags & SVF_FAKECLIENT ) ) {
-					continue;
-				}
-				if( !NET_CompareBaseAddress( &address, &cl->netchan.remoteAddress ) ) {
-					continue;
-				}
-				if( cl->netchan.game_port != game_port ) {
-					continue;
-				}
-
-				addr_port = NET_GetAddressPort( &address );
-				if( NET_GetAddressPort( &cl->netchan.remoteAddress ) != addr_port ) {
-					Com_Printf( "SV_ReadPackets: fixing up a translated port\n" );
-					NET_SetAddressPort( &cl->netchan.remoteAddress, addr_port );
-				}
+				SV_ProcessSocketPacket( socket, &addresses[i], &msgs[i] );
+			}
 
-				if( SV_ProcessPacket( &cl->netchan, &msg ) ) { // this is a valid, sequenced packet, so process it
-					cl->lastPacketReceivedTime = svs.realtime;
-					SV_ParseClientMessage( cl, &msg );
-				}
+			// a short batch means the socket is empty, save the syscall
+			if( ret < NET_MAX_BATCH ) {
 				break;
 			}
 		}
@@ -245,7 +275,7 @@ static void SV_ReadPackets( void ) {
 		}
 
 		// not while, we only handle one packet per client at a time here
-		if( ( ret = NET_GetPacket( cl->netchan.socket, &address, &msg ) ) != 0 ) {
+		if( ( ret = NET_GetPacket( cl->netchan.socket, &addresses[0], &msgs[0] ) ) != 0 ) {
 			if( ret == -1 ) {
 				Com_Printf( "Error receiving packet from %s: %s\n", NET_AddressToString( &cl->netchan.remoteAddress ),
 							NET_ErrorString() );
@@ -253,10 +283,10 @@ static void SV_ReadPackets( void ) {
 					SV_DropClient( cl, DROP_TYPE_GENERAL, "Error receiving packet: %s", NET_ErrorString() );
 				}
 			} else {
-				if( SV_ProcessPacket( &cl->netchan, &msg ) ) {
+				if( SV_ProcessPacket( &cl->netchan, &msgs[0] ) ) {
 					// this is a valid, sequenced packet, so process it
 					cl->lastPacketReceivedTime = svs.realtime;
-					SV_ParseClientMessage( cl, &msg );
+					SV_ParseClientMessage( cl, &msgs[0] );
 				}
 			}
 		}
@@ -349,13 +379,67 @@ static void SV_CheckLatchedUserinfoChanges( void ) {
 //#define WORLDFRAMETIME 25 // 40fps
 //#define WORLDFRAMETIME 20 // 50fps
 #define WORLDFRAMETIME 16 // 62.5fps
+
+static int64_t accTime = 0;
+
+/*
+* SV_WaitForNextFrame
+*
+* Sleeps until the next game frame or snapshot is due, or until a packet
+* arrives on one of the game sockets. elapsed is the time since the last SV_Frame
+*
+* Frames are at least 1ms apart, which also paces fragments to one per
+* client per millisecond
+*/
+void SV_WaitForNextFrame( int64_t elapsed ) {
+	ZoneScoped;
+
+	int64_t timeout = WORLDFRAMETIME;
+
+	if( svs.initialized ) {
+		timeout = Min2( WORLDFRAMETIME - accTime, sv.nextSnapTime - svs.gametime );
+
+		for( int i = 0; i < sv_maxclients->integer; i++ ) {
+			const client_t * cl = &svs.clients[i];
+			if( cl->state != CS_FREE && cl->state != CS_ZOMBIE && cl->netchan.unsentFragments ) {
+				timeout = 0;
+				break;
+			}
+		}
+	}
+
+	timeout = Max2( timeout, int64_t( 1 ) ) - elapsed;
+	if( timeout <= 0 ) {
+		return;
+	}
+
+	socket_t *sockets[] = { &svs.socket_udp, &svs.socket_udp6 };
+	socket_t *opened_sockets[ARRAY_COUNT( sockets ) + 1];
+	size_t open_ind = 0;
+
+	// Pass only the opened sockets to the sleep function
+	for( socket_t *sock : sockets ) {
+		if( sock->open ) {
+			opened_sockets[open_ind] = sock;
+			open_ind++;
+		}
+	}
+	opened_sockets[open_ind] = NULL;
+
+	if( open_ind == 0 ) {
+		Sys_Sleep( timeout );
+		return;
+	}
+
+	NET_Sleep( timeout, opened_sockets );
+}
+
 /*
 * SV_RunGameFrame
 */
 static bool SV_RunGameFrame( int msec ) {
 	ZoneScoped;
 
-	static int64_t accTime = 0;
 	bool refreshSnapshot;
 	bool refreshGameModule;
 	bool sentFragments;
@@ -378,30 +462,6 @@ static bool SV_RunGameFrame( int msec ) {
 		refreshGameModule = true;
 	}
 
-	// if there aren't pending packets to be sent, we can sleep
-	if( is_dedicated_server && !sentFragments && !refreshSnapshot ) {
-		int sleeptime = Min2( WORLDFRAMETIME - ( accTime + 1 ), sv.nextSnapTime - ( svs.gametime + 1 ) );
-
-		if( sleeptime > 0 ) {
-			socket_t *sockets[] = { &svs.socket_udp, &svs.socket_udp6 };
-			socket_t *opened_sockets[ARRAY_COUNT( sockets ) + 1];
-			size_t sock_ind, open_ind;
-
-			// Pass only the opened sockets to the sleep function
-			open_ind = 0;
-			for( sock_ind = 0; sock_ind < ARRAY_COUNT( sockets ); sock_ind++ ) {
-				socket_t *sock = sockets[sock_ind];
-				if( sock->open ) {
-					opened_sockets[open_ind] = sock;
-					open_ind++;
-				}
-			}
-			opened_sockets[open_ind] = NULL;
-
-			NET_Sleep( sleeptime, opened_sockets );
-		}
-	}
-
 	if( refreshGameModule ) {
 		int64_t moduleTime;
 
@@ -409,6 +469,12 @@ static bool SV_RunGameFrame( int msec ) {
 		SV_CalcPings();
 
 		if( accTime >= WORLDFRAMETIME ) {
+			int64_t late = accTime - WORLDFRAMETIME;
+			svs.jitter.game_frames++;
+			svs.jitter.game_late_total += late;
+			svs.jitter.game_late_max = Max2( svs.jitter.game_late_max, late );
+			TracyPlot( "Server game frame lateness", late );
+
 			moduleTime = WORLDFRAMETIME;
 			accTime -= WORLDFRAMETIME;
 			if( accTime >= WORLDFRAMETIME ) { // don't let it accumulate more than 1 frame
@@ -432,6 +498,12 @@ static bool SV_RunGameFrame( int msec ) {
 
 		// set time for next snapshot
 		extraSnapTime = (int)( svs.gametime - sv.nextSnapTime );
+
+		svs.jitter.snaps++;
+		svs.jitter.snap_late_total += extraSnapTime;
+		svs.jitter.snap_late_max = Max2( svs.jitter.snap_late_max, int64_t( extraSnapTime ) );
+		TracyPlot( "Server snapshot lateness", int64_t( extraSnapTime ) );
+
 		if( extraSnapTime > svc.snapFrameTime * 0.5 ) { // don't let too much time be accumulated
 			extraSnapTime = svc.snapFrameTime * 0.5;
 		}
@@ -546,6 +618,8 @@ void SV_UserinfoChanged( client_t *client ) {
 	}
 	Q_strncpyz( client->name, val, sizeof( client->name ) );
 
+	val = Info_ValueForKey( client->userinfo, "snapbudget" );
+	client->snapBudget = val ? Clamp( 0, atoi( val ), MAX_MSGLEN ) : 0;
 }
 
 
@@ -642,6 +716,10 @@ void SV_Init( void ) {
 
 	sv_debug_serverCmd =        Cvar_Get( "sv_debug_serverCmd", "0", CVAR_ARCHIVE );
 
+	sv_parallelSnapshots =      Cvar_Get( "sv_parallelSnapshots", "1", CVAR_ARCHIVE );
+	sv_snapDeltaCache =         Cvar_Get( "sv_snapDeltaCache", "1", CVAR_ARCHIVE );
+	sv_snapBudget =             Cvar_Get( "sv_snapBudget", "0", CVAR_ARCHIVE );
+
 	// this is a message holder for shared use
 	MSG_Init( &tmpMessage, tmpMessageData, sizeof( tmpMessageData ) );
 
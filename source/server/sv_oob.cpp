@@ -496,6 +496,8 @@ static void SVC_DirectConnect( const socket_t *socket, const netadr_t *address )
 	char userinfo[MAX_INFO_STRING];
 	client_t *cl, *newcl;
 	int i, version, game_port, challenge;
+	int compression;
+	unsigned dict_id;
 	int previousclients;
 	int64_t time;
 
@@ -510,6 +512,9 @@ static void SVC_DirectConnect( const socket_t *socket, const netadr_t *address )
 
 	game_port = atoi( Cmd_Argv( 2 ) );
 	challenge = atoi( Cmd_Argv( 3 ) );
+	// older clients don't send these and get zlib
+	compression = atoi( Cmd_Argv( 5 ) );
+	dict_id = strtoul( Cmd_Argv( 6 ), NULL, 10 );
 
 	if( !Info_Validate( Cmd_Argv( 4 ) ) ) {
 		Netchan_OutOfBandPrint( socket, address, "reject\n%i\n%i\nInvalid userinfo string\n", DROP_TYPE_GENERAL, 0 );
@@ -648,8 +653,10 @@ static void SVC_DirectConnect( const socket_t *socket, const netadr_t *address )
 		return;
 	}
 
+	newcl->netchan.compression = Netchan_NegotiateCompression( compression, dict_id );
+
 	// send the connect packet to the client
-	Netchan_OutOfBandPrint( socket, address, "client_connect\n%s", newcl->session );
+	Netchan_OutOfBandPrint( socket, address, "client_connect\n%s\n%i", newcl->session, newcl->netchan.compression );
 }
 
 /*
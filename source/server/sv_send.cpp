@@ -20,6 +20,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 // sv_main.c -- server main program
 
 #include "server.h"
+#include "qcommon/threadpool.h"
 
 // shared message buffer to be used for occasional messages
 msg_t tmpMessage;
@@ -255,6 +256,9 @@ bool SV_SendClientsFragments( void ) {
 	int i;
 	bool sent = false;
 
+	// queue up everything we send and flush it a batch per syscall
+	NetSendBatch batch;
+
 	// send a message to each connected client
 	for( i = 0, client = svs.clients; i < sv_maxclients->integer; i++, client++ ) {
 		if( client->state == CS_FREE || client->state == CS_ZOMBIE ) {
@@ -291,7 +295,7 @@ bool SV_Netchan_Transmit( netchan_t *netchan, msg_t *msg ) {
 		return false;
 	}
 
-	int zerror = Netchan_CompressMessage( msg );
+	int zerror = Netchan_CompressMessage( msg, netchan->compression );
 	if( zerror < 0 ) { // it's compression error, just send uncompressed
 		Com_DPrintf( "SV_Netchan_Transmit (ignoring compression): Compression error %i\n", zerror );
 	}
@@ -354,11 +358,37 @@ void SV_ResetClientFrameCounters( void ) {
 	}
 }
 
+/*
+* SV_SnapBudget
+*
+* How big a snapshot can get before entities start getting held back, the
+* smaller of sv_snapBudget and what the client asked for. 0 means no limit
+*/
+size_t SV_SnapBudget( const client_t *client ) {
+	int budget = sv_snapBudget->integer;
+
+	// demos have all the room they want
+	if( client == &svs.demo.client ) {
+		return 0;
+	}
+
+	if( client->snapBudget > 0 && ( budget <= 0 || client->snapBudget < budget ) ) {
+		budget = client->snapBudget;
+	}
+	if( budget <= 0 ) {
+		return 0;
+	}
+
+	return Max2( budget, SNAP_MIN_BUDGET );
+}
+
 /*
 * SV_WriteFrameSnapToClient
 */
 void SV_WriteFrameSnapToClient( client_t *client, msg_t *msg ) {
-	SNAP_WriteFrameSnapToClient( &sv.gi, client, msg, sv.framenum, svs.gametime, sv.baselines, &svs.client_entities );
+	SnapDeltaCache *delta_cache = sv_snapDeltaCache->integer ? svs.delta_cache : NULL;
+	SNAP_WriteFrameSnapToClient( &sv.gi, client, msg, sv.framenum, svs.gametime, sv.baselines, &svs.client_entities, delta_cache,
+		SV_SnapBudget( client ) );
 }
 
 /*
@@ -390,6 +420,87 @@ static bool SV_SendClientDatagram( client_t *client ) {
 	return SV_SendMessageToClient( client, &tmpMessage );
 }
 
+struct ClientSnapJob {
+	client_t *client;
+	bool in_game;
+	snapshotEntityNumbers_t *entsList;
+	msg_t msg;
+
+	// the reliable commands that went in front of the snapshot
+	int64_t reliableAcknowledge;
+	int64_t reliableSequence;
+	size_t snap_start;
+};
+
+/*
+* SV_BuildClientDatagrams
+*
+* Same as the build and write half of SV_SendClientDatagram, but culling and
+* delta encoding run on the thread pool. Everything that touches shared state
+* happens on the main thread in client order. Snapshots are built before any
+* of them are sent, so if the send loop drops a client, the later snapshots
+* still show it. SV_SendPreparedDatagram adds the reliable commands that drop
+* queued up
+*/
+static void SV_BuildClientDatagrams( Span< ClientSnapJob > jobs ) {
+	ZoneScoped;
+
+	SNAP_ValidateSnapEntities( &sv.gi );
+
+	for( ClientSnapJob & job : jobs ) {
+		int clientNum = job.client - svs.clients;
+		SV_InitClientMessage( job.client, &job.msg, svs.snap_messages + clientNum * MAX_MSGLEN, MAX_MSGLEN );
+		job.reliableAcknowledge = job.client->reliableAcknowledge;
+		job.reliableSequence = job.client->reliableSequence;
+		SV_AddReliableCommandsToMessage( job.client, &job.msg );
+		job.snap_start = job.msg.cursize;
+		job.in_game = SNAP_BeginClientFrameSnap( &sv.gi, sv.framenum, svs.gametime, job.client, svs.cms, sv_mempool );
+	}
+
+	ParallelFor( jobs, []( TempAllocator * temp, void * data ) {
+		ClientSnapJob * job = ( ClientSnapJob * ) data;
+		if( job->in_game ) {
+			SNAP_CullClientFrameSnap( svs.cms, &sv.gi, sv.framenum, job->client, job->entsList );
+		}
+	} );
+
+	// client_entities is a shared ring buffer, so fill it in the same order as the serial path
+	for( ClientSnapJob & job : jobs ) {
+		if( job.in_game ) {
+			SNAP_FinishClientFrameSnap( &sv.gi, sv.framenum, job.client, &server_gs.gameState, &svs.client_entities, job.entsList );
+		}
+	}
+
+	ParallelFor( jobs, []( TempAllocator * temp, void * data ) {
+		ZoneScopedN( "Write client snapshot" );
+		ClientSnapJob * job = ( ClientSnapJob * ) data;
+		SV_WriteFrameSnapToClient( job->client, &job->msg );
+	} );
+}
+
+/*
+* SV_SendPreparedDatagram
+*
+* Sends a message from SV_BuildClientDatagrams. If something earlier in the
+* send loop queued more reliable commands, e.g. dropping a client, rewrite
+* them in front of the snapshot like SV_SendClientDatagram would have
+*/
+static bool SV_SendPreparedDatagram( ClientSnapJob *job ) {
+	client_t *client = job->client;
+
+	if( client->reliableSequence == job->reliableSequence ) {
+		return SV_SendMessageToClient( client, &job->msg );
+	}
+
+	client->reliableAcknowledge = job->reliableAcknowledge;
+
+	SV_InitClientMessage( client, &tmpMessage, NULL, 0 );
+	SV_AddReliableCommandsToMessage( client, &tmpMessage );
+	MSG_WriteData( &tmpMessage, job->msg.data + job->snap_start, job->msg.cursize - job->snap_start );
+
+	return SV_SendMessageToClient( client, &tmpMessage );
+}
+
 /*
 * SV_SendClientMessages
 */
@@ -399,6 +510,41 @@ void SV_SendClientMessages( void ) {
 	int i;
 	client_t *client;
 
+	TempAllocator temp = svs.frame_arena.temp();
+
+	// build all the snapshots up front so they can be done in parallel
+	ClientSnapJob **prepared = ALLOC_MANY( &temp, ClientSnapJob *, sv_maxclients->integer );
+	memset( prepared, 0, sizeof( ClientSnapJob * ) * sv_maxclients->integer );
+
+	if( sv_parallelSnapshots->integer ) {
+		ClientSnapJob *jobs = ALLOC_MANY( &temp, ClientSnapJob, sv_maxclients->integer );
+		size_t num_jobs = 0;
+
+		for( i = 0, client = svs.clients; i < sv_maxclients->integer; i++, client++ ) {
+			if( client->state != CS_SPAWNED ) {
+				continue;
+			}
+			if( client->edict && ( client->edict->r.svflags & SVF_FAKECLIENT ) ) {
+				continue;
+			}
+
+			jobs[num_jobs].client = client;
+			jobs[num_jobs].entsList = ALLOC( &temp, snapshotEntityNumbers_t );
+			num_jobs++;
+		}
+
+		if( num_jobs > 1 ) {
+			SV_BuildClientDatagrams( Span< ClientSnapJob >( jobs, num_jobs ) );
+
+			for( size_t j = 0; j < num_jobs; j++ ) {
+				prepared[jobs[j].client - svs.clients] = &jobs[j];
+			}
+		}
+	}
+
+	// queue up everything we send and flush it a batch per syscall
+	NetSendBatch batch;
+
 	// send a message to each connected client
 	for( i = 0, client = svs.clients; i < sv_maxclients->integer; i++, client++ ) {
 		if( client->state == CS_FREE || client->state == CS_ZOMBIE ) {
@@ -411,7 +557,8 @@ void SV_SendClientMessages( void ) {
 		}
 
 		if( client->state == CS_SPAWNED ) {
-			if( !SV_SendClientDatagram( client ) ) {
+			bool sent = prepared[i] != NULL ? SV_SendPreparedDatagram( prepared[i] ) : SV_SendClientDatagram( client );
+			if( !sent ) {
 				Com_Printf( "Error sending message to %s: %s\n", client->name, NET_ErrorString() );
 				if( client->reliable ) {
 					SV_DropClient( client, DROP_TYPE_GENERAL, "Error sending message: %s\n", NET_ErrorString() );
@@ -432,4 +579,19 @@ void SV_SendClientMessages( void ) {
 			}
 		}
 	}
+
+	int snap_bytes_max = 0;
+	int snap_deferred = 0;
+	for( i = 0, client = svs.clients; i < sv_maxclients->integer; i++, client++ ) {
+		if( client->state == CS_SPAWNED ) {
+			snap_bytes_max = Max2( snap_bytes_max, client->lastSnapBytes );
+			snap_deferred += client->lastSnapDeferred;
+		}
+	}
+	TracyPlot( "Snapshot bytes max", int64_t( snap_bytes_max ) );
+	TracyPlot( "Snapshot deferred entities", int64_t( snap_deferred ) );
+
+	if( svs.delta_cache != NULL ) {
+		SNAP_PlotDeltaCacheStats( svs.delta_cache );
+	}
 }
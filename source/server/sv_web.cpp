@@ -24,7 +24,8 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #ifdef HTTP_SUPPORT
 
-#define MAX_INCOMING_HTTP_CONNECTIONS           48
+#define MAX_INCOMING_HTTP_CONNECTIONS           256
+#define MAX_INCOMING_HTTP_CONNECTIONS_SELECT    48 // without a poller, select gets slow and Windows can't take many more
 #define MAX_INCOMING_HTTP_CONNECTIONS_PER_ADDR  3
 
 #define MAX_INCOMING_CONTENT_LENGTH             0x2800
@@ -33,6 +34,10 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #define INCOMING_HTTP_CONNECTION_SEND_TIMEOUT   15 // seconds
 
 #define HTTP_SERVER_SLEEP_TIME                  50 // milliseconds
+#define HTTP_SERVER_TIMEOUT_CHECK_TIME          1000 // milliseconds, only when polling
+
+#define MAX_HTTP_CACHED_FILES                   32
+#define HTTP_CACHED_FILE_REVALIDATE_TIME        1000 // milliseconds
 
 enum sv_http_connstate_t {
 	HTTP_CONN_STATE_NONE = 0,
@@ -41,17 +46,28 @@ enum sv_http_connstate_t {
 	HTTP_CONN_STATE_SEND = 3
 };
 
-enum sv_http_content_state_t {
-	CONTENT_STATE_DEFAULT = 0,
-	CONTENT_STATE_AWAITING = 1,
-	CONTENT_STATE_RECEIVED = 2,
-};
-
+// inclusive, like in the headers
 typedef struct {
 	long begin;
 	long end;
 } sv_http_content_range_t;
 
+// files stay open between requests so downloads of the same demo don't
+// have to open and stat it every time. only touched by the web thread
+typedef struct {
+	char *filename;
+	int file;
+	int fileno;
+	size_t size;
+	int64_t mtime;
+	char etag[40];
+
+	int refcount;
+	bool stale;                     // changed on disk, closed once nothing is sending it
+	int64_t last_validated;
+	int64_t last_used;
+} sv_http_cached_file_t;
+
 typedef struct {
 	size_t header_length;
 	char header_buf[0x4000];
@@ -79,11 +95,16 @@ typedef struct {
 	char *clientSession;
 	netadr_t realAddr;
 
+	// begin == -1 for suffix ranges, where end is the length,
+	// end == -1 for ranges that go to the end of the file
 	bool partial;
 	sv_http_content_range_t partial_content_range;
 
+	char *if_none_match;
+
 	bool got_start_line;
 	bool close_after_resp;
+	bool pipelined;                 // part of this request came in with the last one
 } sv_http_request_t;
 
 typedef struct {
@@ -91,14 +112,8 @@ typedef struct {
 	http_response_code_t code;
 	sv_http_stream_t stream;
 
-	sv_http_content_state_t content_state;
-	char *content;
-	size_t content_length;
-
-	int file;
-	int fileno;
+	sv_http_cached_file_t *file;
 	size_t file_send_pos;
-	char *filename;
 } sv_http_response_t;
 
 typedef struct sv_http_connection_s {
@@ -109,6 +124,12 @@ typedef struct sv_http_connection_s {
 	socket_t socket;
 	netadr_t address;
 
+	// when polling, whether the last event said we could read/write and
+	// nothing has blocked since
+	bool readable;
+	bool writable;
+	bool read_closed; // the client shut down its side, so no more requests are coming
+
 	int64_t last_active;
 
 	sv_http_request_t request;
@@ -130,6 +151,13 @@ static volatile bool sv_http_running = false;
 
 static sv_http_connection_t sv_http_connections[MAX_INCOMING_HTTP_CONNECTIONS];
 static sv_http_connection_t sv_http_connection_headnode, *sv_free_http_connections;
+static unsigned sv_http_num_connections, sv_http_max_connections;
+
+// NULL if we're on select
+static net_poller_t *sv_http_poller;
+static int64_t sv_http_last_timeout_check;
+
+static sv_http_cached_file_t sv_http_cached_files[MAX_HTTP_CACHED_FILES];
 
 static socket_t sv_socket_http;
 static socket_t sv_socket_http6;
@@ -188,6 +216,10 @@ static void SV_Web_ResetRequest( sv_http_request_t *request ) {
 		Mem_Free( request->clientSession );
 		request->clientSession = NULL;
 	}
+	if( request->if_none_match ) {
+		Mem_Free( request->if_none_match );
+		request->if_none_match = NULL;
+	}
 
 	request->query_string = "";
 	SV_Web_ResetStream( &request->stream );
@@ -198,10 +230,36 @@ static void SV_Web_ResetRequest( sv_http_request_t *request ) {
 	request->partial = false;
 	request->close_after_resp = false;
 	request->got_start_line = false;
+	request->pipelined = false;
 	request->error = HTTP_RESP_NONE;
 	request->clientNum = -1;
 }
 
+/*
+* SV_Web_NextRequest
+*
+* Gets ready for the next request on a keep-alive connection. Clients can
+* send it without waiting for our response, in which case we might have
+* read some or all of it already
+*/
+static void SV_Web_NextRequest( sv_http_request_t *request ) {
+	sv_http_stream_t *stream = &request->stream;
+	size_t leftover = 0;
+
+	// we only serve GET and HEAD so don't bother with bodies
+	if( stream->content_length == 0 ) {
+		leftover = stream->header_buf_p;
+	}
+
+	SV_Web_ResetRequest( request );
+
+	if( leftover > 0 ) {
+		stream->header_buf[leftover] = '\0';
+		stream->header_buf_p = leftover;
+		request->pipelined = true;
+	}
+}
+
 /*
 * SV_Web_GetNewRequestId
 */
@@ -209,28 +267,155 @@ static uint64_t SV_Web_GetNewRequestId( void ) {
 	return sv_http_request_autoicr++;
 }
 
+// ============================================================================
+
+/*
+* SV_Web_CloseCachedFile
+*/
+static void SV_Web_CloseCachedFile( sv_http_cached_file_t *cached ) {
+	if( cached->file ) {
+		FS_FCloseFile( cached->file );
+	}
+	if( cached->filename ) {
+		Mem_Free( cached->filename );
+	}
+	memset( cached, 0, sizeof( *cached ) );
+}
+
+/*
+* SV_Web_OpenCachedFile
+*/
+static bool SV_Web_OpenCachedFile( sv_http_cached_file_t *cached, const char *filename ) {
+	int length;
+
+	length = FS_FOpenBaseFile( filename, &cached->file, FS_READ );
+	if( !cached->file ) {
+		return false;
+	}
+
+	cached->fileno = FS_FileNo( cached->file );
+	if( length < 0 || cached->fileno == -1 ) {
+		FS_FCloseFile( cached->file );
+		cached->file = 0;
+		return false;
+	}
+
+	cached->filename = ZoneCopyString( filename );
+	cached->size = length;
+	cached->mtime = FS_BaseFileMTime( filename );
+	cached->refcount = 0;
+	cached->stale = false;
+	cached->last_validated = Sys_Milliseconds();
+	snprintf( cached->etag, sizeof( cached->etag ), "\"%" PRIx64 "-%" PRIx64 "\"", cached->mtime, (uint64_t)cached->size );
+
+	return true;
+}
+
+/*
+* SV_Web_CachedFileChanged
+*
+* Files get replaced when a demo is recorded again or a server admin
+* drops in a new one, so look at the disk every now and then
+*/
+static bool SV_Web_CachedFileChanged( sv_http_cached_file_t *cached, int64_t now ) {
+	if( now < cached->last_validated + HTTP_CACHED_FILE_REVALIDATE_TIME ) {
+		return false;
+	}
+
+	cached->last_validated = now;
+	return FS_BaseFileMTime( cached->filename ) != cached->mtime
+		|| FS_FOpenBaseFile( cached->filename, NULL, FS_READ ) != (int)cached->size;
+}
+
+/*
+* SV_Web_FindCachedFile
+*
+* Gives a reference to an open file, which must be released with
+* SV_Web_ReleaseCachedFile when the response is done with it
+*/
+static http_response_code_t SV_Web_FindCachedFile( const char *filename, sv_http_cached_file_t **file ) {
+	int64_t now = Sys_Milliseconds();
+	sv_http_cached_file_t *cached = NULL, *slot = NULL;
+
+	*file = NULL;
+
+	for( int i = 0; i < MAX_HTTP_CACHED_FILES; i++ ) {
+		sv_http_cached_file_t *c = &sv_http_cached_files[i];
+
+		if( c->filename && !c->stale && !strcmp( c->filename, filename ) ) {
+			cached = c;
+		}
+
+		// empty slots first, then the least recently used idle file
+		if( !c->filename ) {
+			if( !slot || slot->filename ) {
+				slot = c;
+			}
+		} else if( c->refcount == 0 && ( !slot || ( slot->filename && c->last_used < slot->last_used ) ) ) {
+			slot = c;
+		}
+	}
+
+	if( cached && SV_Web_CachedFileChanged( cached, now ) ) {
+		if( cached->refcount == 0 ) {
+			slot = cached;
+		} else {
+			// let the responses using it finish with the old file
+			cached->stale = true;
+		}
+		cached = NULL;
+	}
+
+	if( !cached ) {
+		if( !slot ) {
+			return HTTP_RESP_SERVICE_UNAVAILABLE;
+		}
+
+		SV_Web_CloseCachedFile( slot );
+		if( !SV_Web_OpenCachedFile( slot, filename ) ) {
+			return HTTP_RESP_NOT_FOUND;
+		}
+		cached = slot;
+	}
+
+	cached->refcount++;
+	cached->last_used = now;
+	*file = cached;
+
+	return HTTP_RESP_OK;
+}
+
+/*
+* SV_Web_ReleaseCachedFile
+*/
+static void SV_Web_ReleaseCachedFile( sv_http_cached_file_t *cached ) {
+	assert( cached->refcount > 0 );
+
+	cached->refcount--;
+	if( cached->refcount == 0 && cached->stale ) {
+		SV_Web_CloseCachedFile( cached );
+	}
+}
+
+/*
+* SV_Web_ShutdownCachedFiles
+*/
+static void SV_Web_ShutdownCachedFiles( void ) {
+	for( int i = 0; i < MAX_HTTP_CACHED_FILES; i++ ) {
+		SV_Web_CloseCachedFile( &sv_http_cached_files[i] );
+	}
+}
+
 /*
 * SV_Web_ResetResponse
 */
 static void SV_Web_ResetResponse( sv_http_response_t *response ) {
-	if( response->filename ) {
-		Mem_Free( response->filename );
-		response->filename = NULL;
-	}
 	if( response->file ) {
-		FS_FCloseFile( response->file );
-		response->file = 0;
+		SV_Web_ReleaseCachedFile( response->file );
+		response->file = NULL;
 	}
-	response->fileno = -1;
 	response->file_send_pos = 0;
 
-	response->content_state = CONTENT_STATE_DEFAULT;
-	if( response->content ) {
-		Mem_Free( response->content );
-		response->content = NULL;
-	}
-	response->content_length = 0;
-
 	SV_Web_ResetStream( &response->stream );
 
 	response->code = HTTP_RESP_NONE;
@@ -242,6 +427,10 @@ static void SV_Web_ResetResponse( sv_http_response_t *response ) {
 static sv_http_connection_t *SV_Web_AllocConnection( void ) {
 	sv_http_connection_t *con;
 
+	if( sv_http_num_connections >= sv_http_max_connections ) {
+		return NULL;
+	}
+
 	if( sv_free_http_connections ) {
 		// take a free connection if possible
 		con = sv_free_http_connections;
@@ -258,6 +447,10 @@ static sv_http_connection_t *SV_Web_AllocConnection( void ) {
 	con->state = HTTP_CONN_STATE_NONE;
 	con->close_after_resp = false;
 	con->is_upstream = false;
+	con->readable = false;
+	con->writable = false;
+	con->read_closed = false;
+	sv_http_num_connections++;
 	return con;
 }
 
@@ -277,6 +470,19 @@ static void SV_Web_FreeConnection( sv_http_connection_t *con ) {
 	// insert into linked free list
 	con->next = sv_free_http_connections;
 	sv_free_http_connections = con;
+
+	sv_http_num_connections--;
+}
+
+/*
+* SV_Web_CloseConnection
+*/
+static void SV_Web_CloseConnection( sv_http_connection_t *con ) {
+	if( sv_http_poller != NULL ) {
+		NET_PollerRemove( sv_http_poller, &con->socket );
+	}
+	NET_CloseSocket( &con->socket );
+	SV_Web_FreeConnection( con );
 }
 
 /*
@@ -291,9 +497,11 @@ static void SV_Web_InitConnections( void ) {
 	sv_free_http_connections = sv_http_connections;
 	sv_http_connection_headnode.prev = &sv_http_connection_headnode;
 	sv_http_connection_headnode.next = &sv_http_connection_headnode;
-	for( i = 0; i < MAX_INCOMING_HTTP_CONNECTIONS - 2; i++ ) {
+	for( i = 0; i < MAX_INCOMING_HTTP_CONNECTIONS - 1; i++ ) {
 		sv_http_connections[i].next = &sv_http_connections[i + 1];
 	}
+
+	sv_http_num_connections = 0;
 }
 
 /*
@@ -307,8 +515,7 @@ static void SV_Web_ShutdownConnections( void ) {
 	for( con = hnode->prev; con != hnode; con = next ) {
 		next = con->prev;
 		if( con->open ) {
-			NET_CloseSocket( &con->socket );
-			SV_Web_FreeConnection( con );
+			SV_Web_CloseConnection( con );
 		}
 	}
 }
@@ -455,7 +662,9 @@ static int SV_Web_Get( sv_http_connection_t *con, void *recvbuf, size_t recvbuf_
 	int read;
 
 	read = NET_Get( &con->socket, NULL, recvbuf, recvbuf_size - 1 );
-	if( read < 0 ) {
+	if( read == 0 ) {
+		con->readable = false;
+	} else if( read < 0 ) {
 		con->open = false;
 		Com_DPrintf( "HTTP connection recv error from %s\n", NET_AddressToString( &con->address ) );
 	}
@@ -469,7 +678,9 @@ static int SV_Web_Send( sv_http_connection_t *con, void *sendbuf, size_t sendbuf
 	int sent;
 
 	sent = NET_Send( &con->socket, sendbuf, sendbuf_size, &con->address );
-	if( sent < 0 ) {
+	if( sent == 0 ) {
+		con->writable = false;
+	} else if( sent < 0 ) {
 		Com_DPrintf( "HTTP transmission error to %s\n", NET_AddressToString( &con->address ) );
 		con->open = false;
 	}
@@ -488,7 +699,9 @@ static int64_t SV_Web_SendFile( sv_http_connection_t *con, int fileno, size_t *p
 	}
 
 	sent = NET_SendFile( &con->socket, fileno, *pos, count, &con->address );
-	if( sent < 0 ) {
+	if( sent == 0 ) {
+		con->writable = false;
+	} else if( sent < 0 ) {
 		Com_DPrintf( "HTTP file transmission error to %s\n", NET_AddressToString( &con->address ) );
 		con->open = false;
 	} else {
@@ -497,36 +710,6 @@ static int64_t SV_Web_SendFile( sv_http_connection_t *con, int fileno, size_t *p
 	return sent;
 }
 
-// ============================================================================
-// Inter-threading communication
-// Passes queries and responses from the web thread to the main thread and back.
-
-enum {
-	CMD_QUERY_IN
-};
-
-enum {
-	CMD_QUERY_OUT
-};
-
-typedef struct {
-	int id;
-	sv_http_response_t *response;
-	uint64_t request_id;
-	http_query_method_t method;
-	char *resource;
-	const char *query_string;
-} queryInCmd_t;
-
-typedef struct {
-	int id;
-	sv_http_response_t *response;
-	uint64_t request_id;
-	http_response_code_t code;
-	char *content;
-	size_t content_length;
-} queryOutCmd_t;
-
 // ============================================================================
 
 /*
@@ -595,6 +778,54 @@ static void SV_Web_ParseStartLine( sv_http_request_t *request, char *line ) {
 	}
 }
 
+/*
+* SV_Web_ParseRange
+*
+* Only does single ranges. The RFC lets us ignore anything we don't
+* understand and send the whole file instead
+*/
+static void SV_Web_ParseRange( sv_http_request_t *request, const char *value ) {
+	sv_http_content_range_t *range = &request->partial_content_range;
+	const char *p;
+	char *end;
+	long first, last;
+
+	if( Q_strnicmp( value, "bytes=", 6 ) || strchr( value, ',' ) ) {
+		return;
+	}
+	p = value + 6;
+
+	if( *p == '-' ) {
+		// bytes=-100 is the last 100 bytes
+		last = strtol( p + 1, &end, 10 );
+		if( end == p + 1 || *end != '\0' || last < 0 ) {
+			return;
+		}
+		first = -1;
+	} else {
+		first = strtol( p, &end, 10 );
+		if( end == p || *end != '-' || first < 0 ) {
+			return;
+		}
+
+		p = end + 1;
+		if( *p == '\0' ) {
+			// bytes=200- goes to the end
+			last = -1;
+		} else {
+			// bytes=200-300
+			last = strtol( p, &end, 10 );
+			if( end == p || *end != '\0' || last < first ) {
+				return;
+			}
+		}
+	}
+
+	range->begin = first;
+	range->end = last;
+	request->partial = true;
+}
+
 /*
 * SV_Web_AnalyzeHeader
 */
@@ -619,54 +850,10 @@ static void SV_Web_AnalyzeHeader( sv_http_request_t *request, const char *key, c
 		}
 	} else if( !Q_stricmp( key, "Range" )
 			   && ( request->method == HTTP_METHOD_GET || request->method == HTTP_METHOD_HEAD ) ) {
-		const char *delim = strchr( value, '-' );
-
-		if( Q_strnicmp( value, "bytes=", 6 ) || !delim ) {
-			request->error = HTTP_RESP_BAD_REQUEST;
-		} else {
-			bool neg_end = false;
-			const char *p = value;
-
-			// first byte pos
-			while( *p && p < delim ) {
-				if( *p >= '0' && *p <= '9' ) {
-					stream->content_range.begin = stream->content_range.begin * 10 + *p - '0';
-				}
-				p++;
-			}
-			p++;
-
-			// last byte pos
-			if( *p == '-' ) {
-				if( value != delim ) {
-					request->error = HTTP_RESP_REQUESTED_RANGE_NOT_SATISFIABLE;
-					return;
-				}
-				neg_end = true;
-				p++;
-			}
-			while( *p ) {
-				if( *p >= '0' && *p <= '9' ) {
-					stream->content_range.end = stream->content_range.end * 10 + *p++ - '0';
-				}
-			}
-
-			// partial content request
-			if( neg_end && stream->content_range.end ) {
-				// bytes=-100
-				request->partial = true;
-				stream->content_range.end = -stream->content_range.end;
-			} else if( stream->content_range.end >= stream->content_range.begin ) {
-				// bytes=200-300
-				request->partial = true;
-			} else if( stream->content_range.begin >= 0 && *( delim + 1 ) == '\0' ) {
-				// bytes=200-
-				request->partial = true;
-			}
-
-			if( request->partial ) {
-				request->partial_content_range = stream->content_range;
-			}
+		SV_Web_ParseRange( request, value );
+	} else if( !Q_stricmp( key, "If-None-Match" ) ) {
+		if( !request->if_none_match ) {
+			request->if_none_match = ZoneCopyString( value );
 		}
 	} else if( !Q_stricmp( key, "X-Client" ) ) {
 		request->clientNum = atoi( value );
@@ -746,6 +933,7 @@ static void SV_Web_ReceiveRequest( socket_t *socket, sv_http_connection_t *con )
 	size_t recvbuf_size;
 	sv_http_request_t *request = &con->request;
 	size_t total_received = 0;
+	bool pipelined = request->pipelined;
 
 	if( con->state != HTTP_CONN_STATE_RECV ) {
 		return;
@@ -756,27 +944,35 @@ static void SV_Web_ReceiveRequest( socket_t *socket, sv_http_connection_t *con )
 		size_t rem;
 		size_t advance;
 
-		recvbuf = request->stream.header_buf + request->stream.header_buf_p;
-		recvbuf_size = sizeof( request->stream.header_buf ) - request->stream.header_buf_p;
-		if( recvbuf_size <= 1 ) {
-			request->error = HTTP_RESP_BAD_REQUEST;
-			break;
-		}
+		if( request->pipelined ) {
+			// go through what we already have before reading any more
+			request->pipelined = false;
+			ret = 0;
+		} else {
+			recvbuf = request->stream.header_buf + request->stream.header_buf_p;
+			recvbuf_size = sizeof( request->stream.header_buf ) - request->stream.header_buf_p;
+			if( recvbuf_size <= 1 ) {
+				request->error = HTTP_RESP_BAD_REQUEST;
+				break;
+			}
 
-		ret = SV_Web_Get( con, recvbuf, recvbuf_size - 1 );
-		if( ret <= 0 ) {
-			if( total_received == 0 ) {
-				// no data on the socket after select() call,
-				// the connection has probably been closed on the other end
-				con->open = false;
-				return;
+			ret = SV_Web_Get( con, recvbuf, recvbuf_size - 1 );
+			if( ret <= 0 ) {
+				if( total_received == 0 && !pipelined && sv_http_poller == NULL ) {
+					// no data on the socket after select() call,
+					// the connection has probably been closed on the other end.
+					// the poller tells us about that directly
+					con->open = false;
+					return;
+				}
+				break;
 			}
-			break;
-		}
 
-		total_received += ret;
+			total_received += ret;
+
+			recvbuf[ret] = '\0';
+		}
 
-		recvbuf[ret] = '\0';
 		advance = SV_Web_ParseHeaders( request, request->stream.header_buf );
 		if( !advance ) {
 			request->stream.header_buf_p += ret;
@@ -877,6 +1073,7 @@ static const char *SV_Web_ResponseCodeMessage( http_response_code_t code ) {
 	switch( code ) {
 		case HTTP_RESP_OK: return "OK";
 		case HTTP_RESP_PARTIAL_CONTENT: return "Partial Content";
+		case HTTP_RESP_NOT_MODIFIED: return "Not Modified";
 		case HTTP_RESP_BAD_REQUEST: return "Bad Request";
 		case HTTP_RESP_FORBIDDEN: return "Forbidden";
 		case HTTP_RESP_NOT_FOUND: return "Not Found";
@@ -890,13 +1087,9 @@ static const char *SV_Web_ResponseCodeMessage( http_response_code_t code ) {
 /*
 * SV_Web_RouteRequest
 */
-static void SV_Web_RouteRequest( const sv_http_request_t *request, sv_http_response_t *response,
-								 char **content, size_t *content_length ) {
+static void SV_Web_RouteRequest( const sv_http_request_t *request, sv_http_response_t *response ) {
 	const char *resource = request->resource;
 
-	*content = NULL;
-	*content_length = 0;
-
 	response->request_id = request->id;
 	if( !resource ) {
 		response->code = HTTP_RESP_BAD_REQUEST;
@@ -904,7 +1097,6 @@ static void SV_Web_RouteRequest( const sv_http_request_t *request, sv_http_respo
 		const char *filename;
 
 		filename = resource + 6;
-		response->filename = ZoneCopyString( filename );
 
 		if( request->method == HTTP_METHOD_GET || request->method == HTTP_METHOD_HEAD ) {
 			// check for malicious URL's
@@ -919,17 +1111,7 @@ static void SV_Web_RouteRequest( const sv_http_request_t *request, sv_http_respo
 				return;
 			}
 
-			*content_length = FS_FOpenBaseFile( filename, &response->file, FS_READ );
-			response->fileno = -1;
-			if( response->file ) {
-				response->fileno = FS_FileNo( response->file );
-			}
-			if( response->fileno == -1 ) {
-				response->code = HTTP_RESP_NOT_FOUND;
-				*content_length = 0;
-			} else {
-				response->code = HTTP_RESP_OK;
-			}
+			response->code = SV_Web_FindCachedFile( filename, &response->file );
 		} else {
 			response->code = HTTP_RESP_BAD_REQUEST;
 		}
@@ -938,64 +1120,107 @@ static void SV_Web_RouteRequest( const sv_http_request_t *request, sv_http_respo
 	}
 }
 
+/*
+* SV_Web_ETagMatches
+*
+* If-None-Match is a list of tags or *
+*/
+static bool SV_Web_ETagMatches( const char *if_none_match, const char *etag ) {
+	const char *p = if_none_match;
+	size_t etag_length = strlen( etag );
+
+	while( p && *p ) {
+		while( *p == ' ' || *p == ',' ) {
+			p++;
+		}
+
+		if( *p == '*' ) {
+			return true;
+		}
+
+		// weak comparison is fine here
+		if( !strncmp( p, "W/", 2 ) ) {
+			p += 2;
+		}
+		if( !strncmp( p, etag, etag_length ) && ( p[etag_length] == '\0' || p[etag_length] == ',' || p[etag_length] == ' ' ) ) {
+			return true;
+		}
+
+		p = strchr( p, ',' );
+	}
+
+	return false;
+}
+
+/*
+* SV_Web_ResolveRange
+*
+* Turns the requested range into absolute, inclusive offsets in a file
+* of the given size. Returns false if there's nothing in it
+*/
+static bool SV_Web_ResolveRange( const sv_http_content_range_t *range, size_t size, sv_http_content_range_t *resolved ) {
+	if( size == 0 ) {
+		return false;
+	}
+
+	if( range->begin < 0 ) {
+		if( range->end == 0 ) {
+			return false;
+		}
+		resolved->begin = (size_t)range->end < size ? size - range->end : 0;
+		resolved->end = size - 1;
+	} else {
+		if( (size_t)range->begin >= size ) {
+			return false;
+		}
+		resolved->begin = range->begin;
+		resolved->end = range->end < 0 || (size_t)range->end >= size ? size - 1 : range->end;
+	}
+
+	return true;
+}
+
 /*
 * SV_Web_RespondToQuery
 */
 static void SV_Web_RespondToQuery( sv_http_connection_t *con ) {
 	char vastr[1024];
 	char err_body[1024];
-	char *content = NULL;
+	const char *content = NULL;
 	size_t header_length = 0;
 	size_t content_length = 0;
 	sv_http_request_t *request = &con->request;
 	sv_http_response_t *response = &con->response;
 	sv_http_stream_t *resp_stream = &response->stream;
+	sv_http_cached_file_t *file;
 
 	if( request->error ) {
 		response->code = request->error;
-	} else if( response->content_state == CONTENT_STATE_AWAITING ) {
-		return;
-	} else if( response->content_state == CONTENT_STATE_RECEIVED ) {
-		content = response->content;
-		content_length = response->content_length;
 	} else {
-		SV_Web_RouteRequest( request, response, &content, &content_length );
-
-		if( response->content_state == CONTENT_STATE_AWAITING ) {
-			// later
-			con->last_active = Sys_Milliseconds();
-			return;
-		}
-
-		if( response->file ) {
-			Com_Printf( "HTTP serving file '%s' to '%s'\n", response->filename, NET_AddressToString( &con->address ) );
-		}
-
-		// serve range requests
-		if( request->partial && response->file ) {
-			// seek to first byte pos and clamp the last byte pos to content length
-			if( request->partial_content_range.begin > 0 ) {
-				FS_Seek( response->file, request->partial_content_range.begin, FS_SEEK_SET );
-				// range.end may be set to 0 for 'bytes=100-' style requests
-				response->stream.content_range.end = request->partial_content_range.end
-													 ? request->partial_content_range.end : content_length;
-
-			} else if( request->partial_content_range.end < 0 ) {
-				// seek to N last bytes in the file
-				FS_Seek( response->file, request->partial_content_range.end, FS_SEEK_END );
-				response->stream.content_range.end = -request->partial_content_range.end;
+		SV_Web_RouteRequest( request, response );
+	}
+
+	file = response->file;
+	if( file ) {
+		content_length = file->size;
+
+		if( SV_Web_ETagMatches( request->if_none_match, file->etag ) ) {
+			// they already have it
+			response->code = HTTP_RESP_NOT_MODIFIED;
+			content_length = 0;
+		} else if( request->partial ) {
+			if( SV_Web_ResolveRange( &request->partial_content_range, file->size, &resp_stream->content_range ) ) {
+				response->code = HTTP_RESP_PARTIAL_CONTENT;
+				response->file_send_pos = resp_stream->content_range.begin;
+				content_length = resp_stream->content_range.end - resp_stream->content_range.begin + 1;
+			} else {
+				response->code = HTTP_RESP_REQUESTED_RANGE_NOT_SATISFIABLE;
+				content_length = 0;
 			}
-
-			// Content-Range header values
-			response->file_send_pos = FS_Tell( response->file );
-			response->stream.content_range.begin = response->file_send_pos;
-			response->stream.content_range.end = qmin( content_length, response->stream.content_range.end );
-			response->code = HTTP_RESP_PARTIAL_CONTENT;
 		}
 
-		if( request->method == HTTP_METHOD_HEAD && response->file ) {
-			FS_FCloseFile( response->file );
-			response->file = 0;
+		if( request->method == HTTP_METHOD_GET && ( response->code == HTTP_RESP_OK || response->code == HTTP_RESP_PARTIAL_CONTENT ) ) {
+			Com_Printf( "HTTP serving file '%s' to '%s'\n", file->filename, NET_AddressToString( &con->address ) );
 		}
 	}
 
@@ -1003,32 +1228,34 @@ static void SV_Web_RespondToQuery( sv_http_connection_t *con ) {
 
 	snprintf( resp_stream->header_buf, sizeof( resp_stream->header_buf ),
 				 "%s %i %s\r\nServer: " APPLICATION "\r\n",
-				 request->http_ver, response->code, SV_Web_ResponseCodeMessage( response->code ) );
+				 request->http_ver ? request->http_ver : "HTTP/1.1", response->code, SV_Web_ResponseCodeMessage( response->code ) );
 
 	Q_strncatz( resp_stream->header_buf, "Accept-Ranges: bytes\r\n",
 				sizeof( resp_stream->header_buf ) );
 
-	if( response->code == HTTP_RESP_REQUESTED_RANGE_NOT_SATISFIABLE ) {
-		int file_length = FS_FOpenBaseFile( request->resource, NULL, FS_READ );
+	if( file ) {
+		snprintf( vastr, sizeof( vastr ), "ETag: %s\r\n", file->etag );
+		Q_strncatz( resp_stream->header_buf, vastr, sizeof( resp_stream->header_buf ) );
+	}
 
+	if( response->code == HTTP_RESP_REQUESTED_RANGE_NOT_SATISFIABLE ) {
 		// in accordance with RFC 2616, send the Content-Range entity header,
 		// specifying the length of the resource
-		if( file_length < 0 ) {
+		if( !file ) {
 			Q_strncatz( resp_stream->header_buf, "Content-Range: bytes */*\r\n",
 						sizeof( resp_stream->header_buf ) );
 		} else {
-			snprintf( vastr, sizeof( vastr ), "Content-Range: bytes */%" PRIuPTR "\r\n", (uintptr_t)content_length );
+			snprintf( vastr, sizeof( vastr ), "Content-Range: bytes */%" PRIuPTR "\r\n", (uintptr_t)file->size );
 			Q_strncatz( resp_stream->header_buf, vastr, sizeof( resp_stream->header_buf ) );
 		}
 	} else if( response->code == HTTP_RESP_PARTIAL_CONTENT ) {
 		snprintf( vastr, sizeof( vastr ), "Content-Range: bytes %" PRIuPTR "-%" PRIuPTR "/%" PRIuPTR "\r\n",
-					(uintptr_t)response->stream.content_range.begin, (uintptr_t)response->stream.content_range.end, (uintptr_t)content_length );
+					(uintptr_t)resp_stream->content_range.begin, (uintptr_t)resp_stream->content_range.end, (uintptr_t)file->size );
 		Q_strncatz( resp_stream->header_buf, vastr, sizeof( resp_stream->header_buf ) );
-		content_length = response->stream.content_range.end - response->stream.content_range.begin;
 	}
 
-	if( response->code >= HTTP_RESP_BAD_REQUEST || !content_length ) {
-		// error response or empty response: just return response code + description
+	if( response->code >= HTTP_RESP_BAD_REQUEST ) {
+		// error response: just return response code + description
 		Q_strncatz( resp_stream->header_buf, "Content-Type: text/plain\r\n",
 					sizeof( resp_stream->header_buf ) );
 
@@ -1038,18 +1265,36 @@ static void SV_Web_RespondToQuery( sv_http_connection_t *con ) {
 		content_length = strlen( err_body );
 	}
 
-	// resource length
-	Q_strncatz( resp_stream->header_buf, va( "Content-Length: %" PRIuPTR "\r\n", (uintptr_t)content_length ),
-				sizeof( resp_stream->header_buf ) );
+	// resource length, 304s don't have a body at all
+	if( response->code != HTTP_RESP_NOT_MODIFIED ) {
+		Q_strncatz( resp_stream->header_buf, va( "Content-Length: %" PRIuPTR "\r\n", (uintptr_t)content_length ),
+					sizeof( resp_stream->header_buf ) );
+	}
 
-	if( response->file ) {
+	if( file && ( response->code == HTTP_RESP_OK || response->code == HTTP_RESP_PARTIAL_CONTENT ) ) {
 		snprintf( vastr, sizeof( vastr ), "Content-Disposition: attachment; filename=\"%s\"\r\n",
-					 COM_FileBase( response->filename ) );
+					 COM_FileBase( file->filename ) );
 		Q_strncatz( resp_stream->header_buf, vastr, sizeof( resp_stream->header_buf ) );
 	}
 
+	if( con->close_after_resp ) {
+		Q_strncatz( resp_stream->header_buf, "Connection: close\r\n", sizeof( resp_stream->header_buf ) );
+	}
+
 	Q_strncatz( resp_stream->header_buf, "\r\n", sizeof( resp_stream->header_buf ) );
 
+	// HEAD gets the same headers but never a body
+	if( request->method == HTTP_METHOD_HEAD ) {
+		content = NULL;
+		content_length = 0;
+	}
+
+	// only 200s and 206s send anything from the file
+	if( response->code != HTTP_RESP_OK && response->code != HTTP_RESP_PARTIAL_CONTENT && file ) {
+		SV_Web_ReleaseCachedFile( file );
+		response->file = NULL;
+	}
+
 	header_length = strlen( resp_stream->header_buf );
 	if( content && content_length ) {
 		if( content_length + header_length < sizeof( resp_stream->header_buf ) ) {
@@ -1094,8 +1339,10 @@ static size_t SV_Web_SendResponse( sv_http_connection_t *con ) {
 	if( stream->header_done && stream->content_length ) {
 		while( stream->content_p < stream->content_length && sv_http_running ) {
 			if( response->file ) {
+				// sendfile takes the offset, so the cached descriptor's
+				// position doesn't matter and it can be shared
 				sendbuf_size = stream->content_length - stream->content_p;
-				sent = SV_Web_SendFile( con, response->fileno, &response->file_send_pos, sendbuf_size );
+				sent = SV_Web_SendFile( con, response->file->fileno, &response->file_send_pos, sendbuf_size );
 			} else {
 				if( !stream->content ) {
 					break;
@@ -1152,7 +1399,7 @@ static void SV_Web_WriteResponse( socket_t *socket, sv_http_connection_t *con )
 				if( con->close_after_resp ) {
 					con->open = false;
 				} else {
-					SV_Web_ResetRequest( &con->request );
+					SV_Web_NextRequest( &con->request );
 				}
 			}
 			break;
@@ -1201,8 +1448,9 @@ static void SV_Web_Listen( socket_t *socket ) {
 		bool is_upstream;
 
 		if( ret == -1 ) {
+			// don't spin on things like running out of file descriptors
 			Com_Printf( "NET_Accept: Error: %s\n", NET_ErrorString() );
-			continue;
+			break;
 		}
 
 		is_upstream = sv_web_upstream_addr.type != NA_NOTRANSMIT
@@ -1218,17 +1466,26 @@ static void SV_Web_Listen( socket_t *socket ) {
 		}
 
 		if( !block ) {
-			Com_DPrintf( "HTTP connection accepted from %s\n", NET_AddressToString( &newaddress ) );
+			// refuse rather than leaving it in the backlog, the poller won't
+			// tell us about it again
 			con = SV_Web_AllocConnection();
 			if( !con ) {
-				break;
+				Com_DPrintf( "HTTP connection refused for %s: too many connections\n", NET_AddressToString( &newaddress ) );
+				NET_CloseSocket( &newsocket );
+				continue;
 			}
+			Com_DPrintf( "HTTP connection accepted from %s\n", NET_AddressToString( &newaddress ) );
 			con->socket = newsocket;
 			con->address = newaddress;
 			con->last_active = Sys_Milliseconds();
 			con->open = true;
 			con->state = HTTP_CONN_STATE_RECV;
 			con->is_upstream = is_upstream;
+
+			if( sv_http_poller != NULL && !NET_PollerAdd( sv_http_poller, &con->socket, con ) ) {
+				Com_Printf( "NET_PollerAdd: Error: %s\n", NET_ErrorString() );
+				SV_Web_CloseConnection( con );
+			}
 			continue;
 		}
 
@@ -1238,12 +1495,37 @@ static void SV_Web_Listen( socket_t *socket ) {
 }
 
 /*
-* SV_Web_Init
+* SV_Web_InitPoller
+*
+* Falls back to select if the platform doesn't have a poller
 */
-void SV_Web_Init( void ) {
-	sv_http_initialized = false;
-	sv_http_running = false;
-	sv_http_request_autoicr = 1;
+static void SV_Web_InitPoller( void ) {
+	sv_http_poller = NET_CreatePoller();
+	sv_http_last_timeout_check = Sys_Milliseconds();
+
+	socket_t *listeners[] = { &sv_socket_http, &sv_socket_http6 };
+	for( socket_t *listener : listeners ) {
+		if( sv_http_poller == NULL || !listener->open ) {
+			continue;
+		}
+
+		if( !NET_PollerAdd( sv_http_poller, listener, listener ) ) {
+			Com_Printf( "NET_PollerAdd: Error: %s\n", NET_ErrorString() );
+			NET_DestroyPoller( sv_http_poller );
+			sv_http_poller = NULL;
+		}
+	}
+
+	sv_http_max_connections = sv_http_poller != NULL ? MAX_INCOMING_HTTP_CONNECTIONS : MAX_INCOMING_HTTP_CONNECTIONS_SELECT;
+}
+
+/*
+* SV_Web_Init
+*/
+void SV_Web_Init( void ) {
+	sv_http_initialized = false;
+	sv_http_running = false;
+	sv_http_request_autoicr = 1;
 
 	SV_Web_InitConnections();
 
@@ -1260,6 +1542,8 @@ void SV_Web_Init( void ) {
 		return;
 	}
 
+	SV_Web_InitPoller();
+
 	sv_http_running = true;
 
 	Trie_Create( TRIE_CASE_SENSITIVE, &sv_http_clients );
@@ -1268,19 +1552,11 @@ void SV_Web_Init( void ) {
 }
 
 /*
-* SV_Web_Frame
+* SV_Web_UpdateUpstream
 */
-static void SV_Web_Frame( void ) {
-	sv_http_connection_t *con, *next, *hnode = &sv_http_connection_headnode;
-	socket_t *sockets[MAX_INCOMING_HTTP_CONNECTIONS + 1];
-	void *connections[MAX_INCOMING_HTTP_CONNECTIONS];
-	int num_sockets = 0;
+static void SV_Web_UpdateUpstream( void ) {
 	bool upstream_is_set;
 
-	if( !sv_http_initialized ) {
-		return;
-	}
-
 	upstream_is_set = sv_http_upstream_ip->string[0] != '\0' && sv_http_upstream_baseurl->string[0] != '\0';
 	if( upstream_is_set ) {
 		if( sv_http_upstream_ip->modified ) {
@@ -1292,6 +1568,55 @@ static void SV_Web_Frame( void ) {
 			NET_InitAddress( &sv_web_upstream_addr, NA_NOTRANSMIT );
 		}
 	}
+}
+
+/*
+* SV_Web_CloseDeadConnections
+*/
+static void SV_Web_CloseDeadConnections( void ) {
+	sv_http_connection_t *con, *next, *hnode = &sv_http_connection_headnode;
+
+	for( con = hnode->prev; con != hnode; con = next ) {
+		next = con->prev;
+		if( !sv_http_running ) {
+			return;
+		}
+
+		if( con->open ) {
+			unsigned int timeout = 0;
+
+			switch( con->state ) {
+				case HTTP_CONN_STATE_RECV:
+					timeout = INCOMING_HTTP_CONNECTION_RECV_TIMEOUT;
+					break;
+				case HTTP_CONN_STATE_RESP:
+				case HTTP_CONN_STATE_SEND:
+					timeout = INCOMING_HTTP_CONNECTION_SEND_TIMEOUT;
+					break;
+				default:
+					break;
+			}
+
+			if( Sys_Milliseconds() > con->last_active + timeout * 1000 ) {
+				con->open = false;
+				Com_DPrintf( "HTTP connection timeout from %s\n", NET_AddressToString( &con->address ) );
+			}
+		}
+
+		if( !con->open ) {
+			SV_Web_CloseConnection( con );
+		}
+	}
+}
+
+/*
+* SV_Web_SelectFrame
+*/
+static void SV_Web_SelectFrame( void ) {
+	sv_http_connection_t *con, *next, *hnode = &sv_http_connection_headnode;
+	socket_t *sockets[MAX_INCOMING_HTTP_CONNECTIONS + 1];
+	void *connections[MAX_INCOMING_HTTP_CONNECTIONS];
+	int num_sockets = 0;
 
 	// accept new connections
 	if( sv_socket_http.address.type == NA_IP ) {
@@ -1305,6 +1630,12 @@ static void SV_Web_Frame( void ) {
 	num_sockets = 0;
 	for( con = hnode->prev; con != hnode; con = next ) {
 		next = con->prev;
+
+		// select won't tell us about requests we've already read
+		if( con->state == HTTP_CONN_STATE_RECV && con->request.pipelined ) {
+			SV_Web_ReceiveRequest( &con->socket, con );
+		}
+
 		switch( con->state ) {
 			case HTTP_CONN_STATE_RECV:
 			case HTTP_CONN_STATE_RESP:
@@ -1337,38 +1668,110 @@ static void SV_Web_Frame( void ) {
 	}
 
 	// close dead connections
-	for( con = hnode->prev; con != hnode; con = next ) {
-		next = con->prev;
-		if( !sv_http_running ) {
-			return;
-		}
+	SV_Web_CloseDeadConnections();
+}
 
-		if( con->open ) {
-			unsigned int timeout = 0;
+/*
+* SV_Web_ServiceConnection
+*
+* Runs the connection's state machine until it would block. The poller only
+* tells us about a socket again after that, so stopping any earlier would
+* leave the connection stuck.
+*/
+static void SV_Web_ServiceConnection( sv_http_connection_t *con ) {
+	while( con->open && sv_http_running ) {
+		sv_http_connstate_t state = con->state;
 
-			switch( con->state ) {
-				case HTTP_CONN_STATE_RECV:
-					timeout = INCOMING_HTTP_CONNECTION_RECV_TIMEOUT;
-					break;
-				case HTTP_CONN_STATE_RESP:
-				case HTTP_CONN_STATE_SEND:
-					timeout = INCOMING_HTTP_CONNECTION_SEND_TIMEOUT;
-					break;
-				default:
-					break;
+		if( state == HTTP_CONN_STATE_RECV ) {
+			if( !con->readable && !con->request.pipelined ) {
+				break;
 			}
-
-			if( Sys_Milliseconds() > con->last_active + timeout * 1000 ) {
-				con->open = false;
-				Com_DPrintf( "HTTP connection timeout from %s\n", NET_AddressToString( &con->address ) );
+			SV_Web_ReceiveRequest( &con->socket, con );
+		} else {
+			if( state == HTTP_CONN_STATE_SEND && !con->writable ) {
+				break;
 			}
+			SV_Web_WriteResponse( &con->socket, con );
+		}
+
+		// if it didn't move on it either blocked or got closed
+		if( con->state == state ) {
+			break;
+		}
+	}
+}
+
+/*
+* SV_Web_PollFrame
+*
+* Only touches the connections that have something to do, and only goes
+* through all of them once a second for timeouts
+*/
+static void SV_Web_PollFrame( void ) {
+	net_poll_event_t events[64];
+	int num_events;
+
+	num_events = NET_Poll( sv_http_poller, HTTP_SERVER_SLEEP_TIME, events, ARRAY_COUNT( events ) );
+	if( num_events < 0 ) {
+		Com_DPrintf( "NET_Poll: Error: %s\n", NET_ErrorString() );
+		return;
+	}
+
+	for( int i = 0; i < num_events && sv_http_running; i++ ) {
+		if( events[i].data == &sv_socket_http || events[i].data == &sv_socket_http6 ) {
+			SV_Web_Listen( ( socket_t * )events[i].data );
+			continue;
+		}
+
+		sv_http_connection_t *con = ( sv_http_connection_t * )events[i].data;
+		if( events[i].flags & NET_POLL_READ ) {
+			con->readable = true;
+		}
+		if( events[i].flags & NET_POLL_WRITE ) {
+			con->writable = true;
+		}
+		if( events[i].flags & NET_POLL_READ_CLOSED ) {
+			con->read_closed = true;
+		}
+
+		// serve whatever it sent before hanging up
+		SV_Web_ServiceConnection( con );
+
+		if( events[i].flags & NET_POLL_HANGUP ) {
+			con->open = false;
+		}
+
+		// once we're done with what's buffered there's nothing left to wait for
+		if( con->read_closed && con->state == HTTP_CONN_STATE_RECV && !con->request.pipelined ) {
+			con->open = false;
 		}
 
 		if( !con->open ) {
-			NET_CloseSocket( &con->socket );
-			SV_Web_FreeConnection( con );
+			SV_Web_CloseConnection( con );
 		}
 	}
+
+	if( Sys_Milliseconds() >= sv_http_last_timeout_check + HTTP_SERVER_TIMEOUT_CHECK_TIME ) {
+		sv_http_last_timeout_check = Sys_Milliseconds();
+		SV_Web_CloseDeadConnections();
+	}
+}
+
+/*
+* SV_Web_Frame
+*/
+static void SV_Web_Frame( void ) {
+	if( !sv_http_initialized ) {
+		return;
+	}
+
+	SV_Web_UpdateUpstream();
+
+	if( sv_http_poller != NULL ) {
+		SV_Web_PollFrame();
+	} else {
+		SV_Web_SelectFrame();
+	}
 }
 
 /*
@@ -1387,6 +1790,7 @@ static void SV_Web_ThreadProc( void *param ) {
 	}
 
 	SV_Web_ShutdownConnections();
+	SV_Web_ShutdownCachedFiles();
 }
 
 /*
@@ -1400,6 +1804,9 @@ void SV_Web_Shutdown( void ) {
 	sv_http_running = false;
 	JoinThread( sv_http_thread );
 
+	NET_DestroyPoller( sv_http_poller );
+	sv_http_poller = NULL;
+
 	NET_CloseSocket( &sv_socket_http );
 	NET_CloseSocket( &sv_socket_http6 );
 
@@ -1413,6 +1820,353 @@ const char *SV_Web_UpstreamBaseUrl( void ) {
 	return sv_http_upstream_baseurl->string;
 }
 
+// ============================================================================
+// Load testing
+// A client that opens lots of connections to our own web server and downloads
+// the same file over and over on each of them.
+
+#define HTTP_LOADTEST_TIMEOUT                   60 // seconds
+
+typedef struct {
+	socket_t socket;
+	bool done;
+
+	int requests_left;
+	bool request_pending;           // couldn't send it yet
+	int64_t request_start;
+
+	char header[1024];
+	size_t header_length;
+	bool header_done;
+	size_t content_left;
+} sv_http_loadtest_conn_t;
+
+typedef struct {
+	net_poller_t *poller;
+	char request[1024];
+	size_t request_length;
+
+	int open_connections;
+	int completed;
+	int failed;
+	uint64_t bytes;
+	int64_t total_latency;
+	int64_t max_latency;
+} sv_http_loadtest_t;
+
+static sv_http_loadtest_t sv_http_loadtest;
+
+/*
+* SV_Web_LoadTestFinish
+*/
+static void SV_Web_LoadTestFinish( sv_http_loadtest_conn_t *c, bool failed ) {
+	if( failed ) {
+		sv_http_loadtest.failed++;
+	}
+
+	if( sv_http_loadtest.poller != NULL ) {
+		NET_PollerRemove( sv_http_loadtest.poller, &c->socket );
+	}
+	NET_CloseSocket( &c->socket );
+
+	c->done = true;
+	sv_http_loadtest.open_connections--;
+}
+
+/*
+* SV_Web_LoadTestSendRequest
+*/
+static void SV_Web_LoadTestSendRequest( sv_http_loadtest_conn_t *c ) {
+	int sent = NET_Send( &c->socket, sv_http_loadtest.request, sv_http_loadtest.request_length, &c->socket.remoteAddress );
+	if( sent == 0 ) {
+		// try again when it's writable
+		c->request_pending = true;
+		return;
+	}
+
+	// it's tiny so a partial send means something went wrong
+	if( sent != (int)sv_http_loadtest.request_length ) {
+		Com_DPrintf( "Load test send error: %s\n", NET_ErrorString() );
+		SV_Web_LoadTestFinish( c, true );
+		return;
+	}
+
+	c->request_pending = false;
+	c->request_start = Sys_Microseconds();
+	c->header_length = 0;
+	c->header_done = false;
+	c->content_left = 0;
+}
+
+/*
+* SV_Web_LoadTestParseHeader
+*
+* Returns how much of data was header, or -1 on a bad response
+*/
+static int SV_Web_LoadTestParseHeader( sv_http_loadtest_conn_t *c, const char *data, size_t length ) {
+	size_t old_length = c->header_length;
+	size_t n = Min2( length, sizeof( c->header ) - 1 - c->header_length );
+	memcpy( c->header + c->header_length, data, n );
+	c->header_length += n;
+	c->header[c->header_length] = '\0';
+
+	const char *end = strstr( c->header, "\r\n\r\n" );
+	if( end == NULL ) {
+		return c->header_length < sizeof( c->header ) - 1 ? (int)n : -1;
+	}
+
+	int code = strncmp( c->header, "HTTP/1.1 ", 9 ) == 0 ? atoi( c->header + 9 ) : 0;
+	if( code != HTTP_RESP_OK && code != HTTP_RESP_PARTIAL_CONTENT ) {
+		Com_DPrintf( "Load test got: %s\n", c->header );
+		return -1;
+	}
+
+	const char *content_length = strstr( c->header, "Content-Length: " );
+	if( content_length == NULL || content_length > end ) {
+		return -1;
+	}
+
+	c->header_done = true;
+	c->content_left = strtoul( content_length + strlen( "Content-Length: " ), NULL, 10 );
+
+	return int( end + 4 - c->header ) - old_length;
+}
+
+/*
+* SV_Web_LoadTestConsume
+*/
+static void SV_Web_LoadTestConsume( sv_http_loadtest_conn_t *c, const char *data, size_t length ) {
+	while( !c->done ) {
+		if( !c->header_done ) {
+			int n = SV_Web_LoadTestParseHeader( c, data, length );
+			if( n < 0 ) {
+				SV_Web_LoadTestFinish( c, true );
+				return;
+			}
+			data += n;
+			length -= n;
+			if( !c->header_done ) {
+				return;
+			}
+		}
+
+		size_t n = Min2( length, c->content_left );
+		c->content_left -= n;
+		data += n;
+		length -= n;
+		sv_http_loadtest.bytes += n;
+
+		if( c->content_left > 0 ) {
+			return;
+		}
+
+		int64_t latency = Sys_Microseconds() - c->request_start;
+		sv_http_loadtest.completed++;
+		sv_http_loadtest.total_latency += latency;
+		sv_http_loadtest.max_latency = Max2( sv_http_loadtest.max_latency, latency );
+
+		c->requests_left--;
+		if( c->requests_left == 0 ) {
+			SV_Web_LoadTestFinish( c, false );
+			return;
+		}
+
+		SV_Web_LoadTestSendRequest( c );
+		if( length == 0 ) {
+			return;
+		}
+	}
+}
+
+/*
+* SV_Web_LoadTestRead
+*/
+static void SV_Web_LoadTestRead( socket_t *socket, void *data ) {
+	static char buf[0x10000];
+	sv_http_loadtest_conn_t *c = ( sv_http_loadtest_conn_t * )data;
+	bool first = true;
+
+	// drain it, the poller won't tell us again otherwise
+	while( !c->done ) {
+		int ret = NET_Get( &c->socket, NULL, buf, sizeof( buf ) );
+		if( ret < 0 ) {
+			Com_DPrintf( "Load test recv error: %s\n", NET_ErrorString() );
+			SV_Web_LoadTestFinish( c, true );
+			return;
+		}
+
+		if( ret == 0 ) {
+			// select said it was readable, so nothing there means it got closed
+			if( first && sv_http_loadtest.poller == NULL ) {
+				SV_Web_LoadTestFinish( c, true );
+			}
+			return;
+		}
+
+		first = false;
+		SV_Web_LoadTestConsume( c, buf, ret );
+	}
+}
+
+/*
+* SV_Web_LoadTestWrite
+*
+* select calls this every time around while the socket is writable, which
+* burns some CPU where there's no poller
+*/
+static void SV_Web_LoadTestWrite( socket_t *socket, void *data ) {
+	sv_http_loadtest_conn_t *c = ( sv_http_loadtest_conn_t * )data;
+
+	if( c->done ) {
+		return;
+	}
+
+	if( !c->socket.connected ) {
+		if( NET_CheckConnect( &c->socket ) != CONNECTION_SUCCEEDED ) {
+			Com_DPrintf( "Load test connect error: %s\n", NET_ErrorString() );
+			SV_Web_LoadTestFinish( c, true );
+			return;
+		}
+		c->request_pending = true;
+	}
+
+	if( c->request_pending ) {
+		SV_Web_LoadTestSendRequest( c );
+	}
+}
+
+/*
+* SV_Web_LoadTest
+*
+* Downloads files/path requests times on each of num_connections connections
+* to our own web server and prints throughput and latency. The game doesn't
+* run while it's going.
+*/
+void SV_Web_LoadTest( const char *path, int num_connections, int requests ) {
+	char session[HTTP_CLIENT_SESSION_SIZE];
+	netadr_t address, bind_address;
+	sv_http_loadtest_conn_t *connections;
+
+	if( !sv_http_running ) {
+		Com_Printf( "The web server isn't running\n" );
+		return;
+	}
+
+	NET_StringToAddress( "127.0.0.1", &address );
+	NET_SetAddressPort( &address, sv_http_port->integer );
+	NET_StringToAddress( "127.0.0.1", &bind_address );
+
+	// pretend to be a connected client so the server takes our requests
+	snprintf( session, sizeof( session ), "loadtest%07x", random_uniform( &svs.rng, 0, 0x10000000 ) );
+	if( !SV_Web_AddGameClient( session, 0, &address ) ) {
+		Com_Printf( "Couldn't add the load test client\n" );
+		return;
+	}
+
+	memset( &sv_http_loadtest, 0, sizeof( sv_http_loadtest ) );
+	sv_http_loadtest.poller = NET_CreatePoller();
+	snprintf( sv_http_loadtest.request, sizeof( sv_http_loadtest.request ),
+		"GET /files/%s HTTP/1.1\r\nHost: localhost\r\nX-Client: 0\r\nX-Session: %s\r\n\r\n", path, session );
+	sv_http_loadtest.request_length = strlen( sv_http_loadtest.request );
+
+	connections = ALLOC_MANY( sys_allocator, sv_http_loadtest_conn_t, num_connections );
+	memset( connections, 0, num_connections * sizeof( connections[0] ) );
+
+	int64_t start = Sys_Milliseconds();
+
+	for( int i = 0; i < num_connections; i++ ) {
+		sv_http_loadtest_conn_t *c = &connections[i];
+		c->requests_left = requests;
+
+		if( !NET_OpenSocket( &c->socket, SOCKET_TCP, &bind_address, false ) ) {
+			Com_Printf( "Couldn't open TCP socket: %s\n", NET_ErrorString() );
+			c->done = true;
+			sv_http_loadtest.failed++;
+			continue;
+		}
+
+		sv_http_loadtest.open_connections++;
+
+		connection_status_t status = NET_Connect( &c->socket, &address );
+		if( status == CONNECTION_FAILED ) {
+			Com_DPrintf( "Load test connect error: %s\n", NET_ErrorString() );
+			SV_Web_LoadTestFinish( c, true );
+			continue;
+		}
+
+		if( sv_http_loadtest.poller != NULL && !NET_PollerAdd( sv_http_loadtest.poller, &c->socket, c ) ) {
+			SV_Web_LoadTestFinish( c, true );
+			continue;
+		}
+
+		if( status == CONNECTION_SUCCEEDED ) {
+			SV_Web_LoadTestSendRequest( c );
+		}
+	}
+
+	socket_t **sockets = ALLOC_MANY( sys_allocator, socket_t *, num_connections + 1 );
+	void **privs = ALLOC_MANY( sys_allocator, void *, num_connections );
+
+	while( sv_http_loadtest.open_connections > 0 ) {
+		if( Sys_Milliseconds() > start + HTTP_LOADTEST_TIMEOUT * 1000 ) {
+			Com_Printf( S_COLOR_YELLOW "Load test timed out\n" );
+			break;
+		}
+
+		if( sv_http_loadtest.poller != NULL ) {
+			net_poll_event_t events[64];
+			int num_events = NET_Poll( sv_http_loadtest.poller, 100, events, ARRAY_COUNT( events ) );
+
+			for( int i = 0; i < num_events; i++ ) {
+				sv_http_loadtest_conn_t *c = ( sv_http_loadtest_conn_t * )events[i].data;
+				if( events[i].flags & NET_POLL_WRITE ) {
+					SV_Web_LoadTestWrite( &c->socket, c );
+				}
+				if( events[i].flags & ( NET_POLL_READ | NET_POLL_HANGUP ) ) {
+					SV_Web_LoadTestRead( &c->socket, c );
+				}
+				if( ( events[i].flags & ( NET_POLL_HANGUP | NET_POLL_READ_CLOSED ) ) && !c->done ) {
+					SV_Web_LoadTestFinish( c, true );
+				}
+			}
+		} else {
+			int num_sockets = 0;
+			for( int i = 0; i < num_connections; i++ ) {
+				if( !connections[i].done ) {
+					sockets[num_sockets] = &connections[i].socket;
+					privs[num_sockets] = &connections[i];
+					num_sockets++;
+				}
+			}
+			sockets[num_sockets] = NULL;
+
+			NET_Monitor( 100, sockets, SV_Web_LoadTestRead, SV_Web_LoadTestWrite, NULL, privs );
+		}
+	}
+
+	int64_t elapsed = Max2( Sys_Milliseconds() - start, int64_t( 1 ) );
+
+	for( int i = 0; i < num_connections; i++ ) {
+		if( !connections[i].done ) {
+			SV_Web_LoadTestFinish( &connections[i], true );
+		}
+	}
+
+	FREE( sys_allocator, sockets );
+	FREE( sys_allocator, privs );
+	FREE( sys_allocator, connections );
+	NET_DestroyPoller( sv_http_loadtest.poller );
+	SV_Web_RemoveGameClient( session );
+
+	Com_Printf( "%i connections, %i/%i requests done in %.2fs, %i connections failed, server is using %s\n",
+		num_connections, sv_http_loadtest.completed, num_connections * requests, elapsed / 1000.0,
+		sv_http_loadtest.failed, sv_http_poller != NULL ? "a poller" : "select" );
+	Com_Printf( "%.1f requests/s, %.2f MB/s, latency %.2fms avg, %.2fms max\n",
+		sv_http_loadtest.completed * 1000.0 / elapsed, sv_http_loadtest.bytes / 1000.0 / elapsed,
+		sv_http_loadtest.completed > 0 ? sv_http_loadtest.total_latency / 1000.0 / sv_http_loadtest.completed : 0.0,
+		sv_http_loadtest.max_latency / 1000.0 );
+}
+
 #else
 
 /*
@@ -1441,4 +2195,11 @@ const char *SV_Web_UpstreamBaseUrl( void ) {
 	return "";
 }
 
+/*
+* SV_Web_LoadTest
+*/
+void SV_Web_LoadTest( const char *path, int num_connections, int requests ) {
+	Com_Printf( "Built without HTTP support\n" );
+}
+
 #endif // HTTP_SUPPORT
@@ -30,6 +30,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include <linux/limits.h>
 #endif
 
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
@@ -292,6 +293,18 @@ int Sys_FS_FileNo( FILE *fp ) {
 	return fileno( fp );
 }
 
+/*
+* Sys_FS_FileMTime
+*/
+int64_t Sys_FS_FileMTime( const char *filename ) {
+	struct stat buffer;
+
+	if( stat( filename, &buffer ) != 0 ) {
+		return -1;
+	}
+	return buffer.st_mtime;
+}
+
 struct ListDirHandleImpl {
 	DIR * dir;
 };
@@ -345,3 +358,33 @@ s64 FileLastModifiedTime( const char * path ) {
 
 	return checked_cast< s64 >( buf.st_mtim.tv_sec ) * 1000 + checked_cast< s64 >( buf.st_mtim.tv_nsec ) / 1000000;
 }
+
+bool MapFile( const char * path, Span< const u8 > * data, bool * zero_padded ) {
+	int fd = open( path, O_RDONLY );
+	if( fd == -1 )
+		return false;
+
+	defer { close( fd ); };
+
+	struct stat buf;
+	if( fstat( fd, &buf ) == -1 || buf.st_size <= 0 )
+		return false;
+
+	size_t size = checked_cast< size_t >( buf.st_size );
+	void * ptr = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+	if( ptr == MAP_FAILED )
+		return false;
+
+	size_t page_size = checked_cast< size_t >( sysconf( _SC_PAGESIZE ) );
+
+	*data = Span< const u8 >( ( const u8 * ) ptr, size );
+	*zero_padded = size % page_size != 0;
+
+	return true;
+}
+
+void UnmapFile( Span< const u8 > data ) {
+	if( data.ptr == NULL )
+		return;
+	munmap( const_cast< u8 * >( data.ptr ), data.n );
+}
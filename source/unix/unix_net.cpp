@@ -31,7 +31,11 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #endif
 #include <errno.h>
 #include <arpa/inet.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
+#include "qcommon/base.h"
 #include "qcommon/qcommon.h"
 #include "qcommon/sys_net.h"
 
@@ -90,6 +94,213 @@ int64_t Sys_NET_SendFile( socket_handle_t handle, int fileno, size_t offset, siz
 
 //===================================================================
 
+#ifdef __linux__
+// kernels older than 2.6.33/3.0 don't have recvmmsg/sendmmsg
+static bool mmsg_unsupported;
+#endif
+
+/*
+* Sys_NET_RecvBatch
+*
+* Returns the number of datagrams received, or SOCKET_ERROR if the first one
+* failed. recvmmsg gets them all in one syscall, otherwise we fall back to
+* recvfrom until the socket runs dry
+*/
+int Sys_NET_RecvBatch( socket_handle_t handle, net_datagram_t *datagrams, int count ) {
+	count = Min2( count, NET_MAX_BATCH );
+
+#ifdef __linux__
+	if( !mmsg_unsupported ) {
+		struct mmsghdr msgs[NET_MAX_BATCH];
+		struct iovec iovs[NET_MAX_BATCH];
+
+		memset( msgs, 0, sizeof( msgs[0] ) * count );
+		for( int i = 0; i < count; i++ ) {
+			iovs[i].iov_base = datagrams[i].data;
+			iovs[i].iov_len = datagrams[i].length;
+			msgs[i].msg_hdr.msg_name = datagrams[i].addr;
+			msgs[i].msg_hdr.msg_namelen = datagrams[i].addrlen;
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		int ret = recvmmsg( handle, msgs, count, 0, NULL );
+		if( ret != SOCKET_ERROR ) {
+			for( int i = 0; i < ret; i++ ) {
+				datagrams[i].length = msgs[i].msg_len;
+				datagrams[i].addrlen = msgs[i].msg_hdr.msg_namelen;
+			}
+			return ret;
+		}
+
+		if( errno != ENOSYS ) {
+			return SOCKET_ERROR;
+		}
+
+		mmsg_unsupported = true;
+	}
+#endif
+
+	for( int i = 0; i < count; i++ ) {
+		socklen_t addrlen = datagrams[i].addrlen;
+		ssize_t ret = recvfrom( handle, datagrams[i].data, datagrams[i].length, 0, (struct sockaddr *)datagrams[i].addr, &addrlen );
+		if( ret == SOCKET_ERROR ) {
+			return i > 0 ? i : SOCKET_ERROR;
+		}
+
+		datagrams[i].length = ret;
+		datagrams[i].addrlen = addrlen;
+	}
+
+	return count;
+}
+
+/*
+* Sys_NET_SendBatch
+*
+* Returns the number of datagrams sent, or SOCKET_ERROR if the first one
+* failed
+*/
+int Sys_NET_SendBatch( socket_handle_t handle, const net_datagram_t *datagrams, int count ) {
+	count = Min2( count, NET_MAX_BATCH );
+
+#ifdef __linux__
+	if( !mmsg_unsupported ) {
+		struct mmsghdr msgs[NET_MAX_BATCH];
+		struct iovec iovs[NET_MAX_BATCH];
+
+		memset( msgs, 0, sizeof( msgs[0] ) * count );
+		for( int i = 0; i < count; i++ ) {
+			iovs[i].iov_base = datagrams[i].data;
+			iovs[i].iov_len = datagrams[i].length;
+			msgs[i].msg_hdr.msg_name = datagrams[i].addr;
+			msgs[i].msg_hdr.msg_namelen = datagrams[i].addrlen;
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		int ret = sendmmsg( handle, msgs, count, 0 );
+		if( ret != SOCKET_ERROR || errno != ENOSYS ) {
+			return ret;
+		}
+
+		mmsg_unsupported = true;
+	}
+#endif
+
+	for( int i = 0; i < count; i++ ) {
+		ssize_t ret = sendto( handle, datagrams[i].data, datagrams[i].length, 0, (const struct sockaddr *)datagrams[i].addr, datagrams[i].addrlen );
+		if( ret == SOCKET_ERROR ) {
+			return i > 0 ? i : SOCKET_ERROR;
+		}
+	}
+
+	return count;
+}
+
+//===================================================================
+
+#ifdef __linux__
+
+struct net_poller_s {
+	int epfd;
+};
+
+/*
+* Sys_NET_CreatePoller
+*/
+net_poller_t *Sys_NET_CreatePoller( void ) {
+	int epfd = epoll_create1( EPOLL_CLOEXEC );
+	if( epfd == -1 ) {
+		return NULL;
+	}
+
+	net_poller_t *poller = ALLOC( sys_allocator, net_poller_t );
+	poller->epfd = epfd;
+	return poller;
+}
+
+/*
+* Sys_NET_DestroyPoller
+*/
+void Sys_NET_DestroyPoller( net_poller_t *poller ) {
+	close( poller->epfd );
+	FREE( sys_allocator, poller );
+}
+
+/*
+* Sys_NET_PollerAdd
+*/
+bool Sys_NET_PollerAdd( net_poller_t *poller, socket_handle_t handle, void *data ) {
+	struct epoll_event ev = { };
+	ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+	ev.data.ptr = data;
+	return epoll_ctl( poller->epfd, EPOLL_CTL_ADD, handle, &ev ) == 0;
+}
+
+/*
+* Sys_NET_PollerRemove
+*/
+void Sys_NET_PollerRemove( net_poller_t *poller, socket_handle_t handle ) {
+	epoll_ctl( poller->epfd, EPOLL_CTL_DEL, handle, NULL );
+}
+
+/*
+* Sys_NET_PollerWait
+*/
+int Sys_NET_PollerWait( net_poller_t *poller, int msec, net_poll_event_t *events, int count ) {
+	struct epoll_event evs[64];
+
+	int ret = epoll_wait( poller->epfd, evs, Min2( count, int( ARRAY_COUNT( evs ) ) ), msec );
+	if( ret == SOCKET_ERROR ) {
+		// a signal isn't an error, it just woke us up early
+		return errno == EINTR ? 0 : SOCKET_ERROR;
+	}
+
+	for( int i = 0; i < ret; i++ ) {
+		events[i].data = evs[i].data.ptr;
+		events[i].flags = 0;
+		if( evs[i].events & EPOLLIN ) {
+			events[i].flags |= NET_POLL_READ;
+		}
+		if( evs[i].events & EPOLLOUT ) {
+			events[i].flags |= NET_POLL_WRITE;
+		}
+		if( evs[i].events & EPOLLRDHUP ) {
+			events[i].flags |= NET_POLL_READ | NET_POLL_READ_CLOSED;
+		}
+		if( evs[i].events & ( EPOLLHUP | EPOLLERR ) ) {
+			events[i].flags |= NET_POLL_HANGUP;
+		}
+	}
+
+	return ret;
+}
+
+#else
+
+net_poller_t *Sys_NET_CreatePoller( void ) {
+	return NULL;
+}
+
+void Sys_NET_DestroyPoller( net_poller_t *poller ) {
+}
+
+bool Sys_NET_PollerAdd( net_poller_t *poller, socket_handle_t handle, void *data ) {
+	return false;
+}
+
+void Sys_NET_PollerRemove( net_poller_t *poller, socket_handle_t handle ) {
+}
+
+int Sys_NET_PollerWait( net_poller_t *poller, int msec, net_poll_event_t *events, int count ) {
+	return SOCKET_ERROR;
+}
+
+#endif
+
+//===================================================================
+
 /*
 * Sys_NET_Init
 */
@@ -83,30 +83,24 @@ void Sys_Error( const char *format, ... ) {
 }
 
 int main( int argc, char **argv ) {
-	unsigned int oldtime, newtime, time;
-
 	InitSig();
 
 	Qcommon_Init( argc, argv );
 
 	fcntl( 0, F_SETFL, fcntl( 0, F_GETFL, 0 ) | O_NONBLOCK );
 
-	oldtime = Sys_Milliseconds();
+	int64_t oldtime = Sys_Milliseconds();
 	while( true ) {
-		// find time spent rendering last frame
-		do {
-			newtime = Sys_Milliseconds();
-			time = newtime - oldtime;
-			if( time > 0 ) {
-				break;
-			}
-#ifdef PUTCPU2SLEEP
-			Sys_Sleep( 0 );
-#endif
-		} while( 1 );
+		// sleep until the next frame is due or a packet comes in
+		SV_WaitForNextFrame( Sys_Milliseconds() - oldtime );
+
+		int64_t newtime = Sys_Milliseconds();
+		int64_t time = newtime - oldtime;
+		if( time < 1 ) {
+			continue;
+		}
 		oldtime = newtime;
 
 		Qcommon_Frame( time );
 	}
 }
-
@@ -25,6 +25,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include "winquake.h"
 #include <direct.h>
+#include <sys/stat.h>
 #include <shlobj.h>
 
 #ifndef CSIDL_APPDATA
@@ -264,6 +265,18 @@ int Sys_FS_FileNo( FILE *fp ) {
 	return _fileno( fp );
 }
 
+/*
+* Sys_FS_FileMTime
+*/
+int64_t Sys_FS_FileMTime( const char *filename ) {
+	struct _stat64 buffer;
+
+	if( _stat64( filename, &buffer ) != 0 ) {
+		return -1;
+	}
+	return buffer.st_mtime;
+}
+
 struct ListDirHandleImpl {
 	HANDLE handle;
 	WIN32_FIND_DATAA * ffd;
@@ -344,3 +357,41 @@ s64 FileLastModifiedTime( const char * path ) {
 	memcpy( &modified64, &modified, sizeof( modified ) );
 	return modified64.QuadPart;
 }
+
+bool MapFile( const char * path, Span< const u8 > * data, bool * zero_padded ) {
+	// windows won't let anyone truncate it while it's mapped anyway
+	HANDLE file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if( file == INVALID_HANDLE_VALUE )
+		return false;
+
+	defer { CloseHandle( file ); };
+
+	LARGE_INTEGER size;
+	if( GetFileSizeEx( file, &size ) == 0 || size.QuadPart <= 0 )
+		return false;
+
+	HANDLE mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+	if( mapping == NULL )
+		return false;
+
+	// the view keeps the mapping alive
+	defer { CloseHandle( mapping ); };
+
+	void * ptr = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+	if( ptr == NULL )
+		return false;
+
+	SYSTEM_INFO info;
+	GetSystemInfo( &info );
+
+	*data = Span< const u8 >( ( const u8 * ) ptr, checked_cast< size_t >( size.QuadPart ) );
+	*zero_padded = data->n % info.dwPageSize != 0;
+
+	return true;
+}
+
+void UnmapFile( Span< const u8 > data ) {
+	if( data.ptr == NULL )
+		return;
+	UnmapViewOfFile( data.ptr );
+}
@@ -94,6 +94,69 @@ int64_t Sys_NET_SendFile( socket_handle_t handle, int fileno, size_t offset, siz
 
 //===================================================================
 
+/*
+* Sys_NET_RecvBatch
+*
+* Winsock doesn't have anything like recvmmsg, so this is one recvfrom per
+* datagram. Returns the number received, or SOCKET_ERROR if the first one
+* failed
+*/
+int Sys_NET_RecvBatch( socket_handle_t handle, net_datagram_t *datagrams, int count ) {
+	for( int i = 0; i < count; i++ ) {
+		int addrlen = datagrams[i].addrlen;
+		int ret = recvfrom( handle, (char *)datagrams[i].data, (int)datagrams[i].length, 0, (struct sockaddr *)datagrams[i].addr, &addrlen );
+		if( ret == SOCKET_ERROR ) {
+			return i > 0 ? i : SOCKET_ERROR;
+		}
+
+		datagrams[i].length = ret;
+		datagrams[i].addrlen = addrlen;
+	}
+
+	return count;
+}
+
+/*
+* Sys_NET_SendBatch
+*/
+int Sys_NET_SendBatch( socket_handle_t handle, const net_datagram_t *datagrams, int count ) {
+	for( int i = 0; i < count; i++ ) {
+		int ret = sendto( handle, (const char *)datagrams[i].data, (int)datagrams[i].length, 0, (const struct sockaddr *)datagrams[i].addr, datagrams[i].addrlen );
+		if( ret == SOCKET_ERROR ) {
+			return i > 0 ? i : SOCKET_ERROR;
+		}
+	}
+
+	return count;
+}
+
+//===================================================================
+
+/*
+* Sys_NET_CreatePoller
+*
+* We only have select on Windows
+*/
+net_poller_t *Sys_NET_CreatePoller( void ) {
+	return NULL;
+}
+
+void Sys_NET_DestroyPoller( net_poller_t *poller ) {
+}
+
+bool Sys_NET_PollerAdd( net_poller_t *poller, socket_handle_t handle, void *data ) {
+	return false;
+}
+
+void Sys_NET_PollerRemove( net_poller_t *poller, socket_handle_t handle ) {
+}
+
+int Sys_NET_PollerWait( net_poller_t *poller, int msec, net_poll_event_t *events, int count ) {
+	return SOCKET_ERROR;
+}
+
+//===================================================================
+
 /*
 * Sys_NET_InitFunctions
 */
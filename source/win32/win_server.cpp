@@ -36,23 +36,19 @@ void Sys_Init() {
 }
 
 int main( int argc, char ** argv ) {
-	int64_t oldtime, newtime, time;
-
 	Qcommon_Init( argc, argv );
 
-	oldtime = Sys_Milliseconds();
+	int64_t oldtime = Sys_Milliseconds();
 
 	while( 1 ) {
-		Sys_Sleep( 1 );
-
-		do {
-			newtime = Sys_Milliseconds();
-			time = newtime - oldtime;
-			if( time > 0 ) {
-				break;
-			}
-			Sys_Sleep( 0 );
-		} while( 1 );
+		// sleep until the next frame is due or a packet comes in
+		SV_WaitForNextFrame( Sys_Milliseconds() - oldtime );
+
+		int64_t newtime = Sys_Milliseconds();
+		int64_t time = newtime - oldtime;
+		if( time < 1 ) {
+			continue;
+		}
 		oldtime = newtime;
 
 		Qcommon_Frame( time );